@@ -48,7 +48,7 @@ GetOptions(\%args, qw(
     build=s host=s big-endian jit! enable-jit
     prefix=s bindir=s libdir=s mastdir=s
     relocatable make-install asan ubsan
-    valgrind telemeh show-autovect
+    valgrind telemeh siphash13 show-autovect
     show-autovect-failed:s),
 
     'no-optimize|nooptimize' => sub { $args{optimize} = 0 },
@@ -101,7 +101,7 @@ if ( $args{relocatable} && ($^O eq 'aix' || $^O eq 'openbsd') ) {
 }
 
 for (qw(coverage instrument static big-endian has-libtommath has-sha has-libuv
-        has-libatomic_ops asan ubsan valgrind show-vec)) {
+        has-libatomic_ops asan ubsan valgrind siphash13 show-vec)) {
     $args{$_} = 0 unless defined $args{$_};
 }
 
@@ -422,6 +422,7 @@ push @cflags, '-DWSL_BASH_ON_WIN' if wsl_bash_on_win();
 push @cflags, '-DDEBUG_HELPERS' if $args{debug};
 push @cflags, '-DMVM_VALGRIND_SUPPORT' if $args{valgrind};
 push @cflags, '-DHAVE_TELEMEH' if $args{telemeh};
+push @cflags, '-DMVM_SIPHASH_1_3' if $args{siphash13};
 push @cflags, '-DWORDS_BIGENDIAN' if $config{be}; # 3rdparty/sha1 needs it and it isnt set on mips;
 push @cflags, $ENV{CFLAGS} if $ENV{CFLAGS};
 push @cflags, $ENV{CPPFLAGS} if $ENV{CPPFLAGS};
@@ -941,7 +942,7 @@ __END__
                    [--has-libtommath] [--has-sha] [--has-libuv]
                    [--has-libatomic_ops]
                    [--asan] [--ubsan] [--no-jit]
-                   [--telemeh]
+                   [--telemeh] [--siphash13]
 
     ./Configure.pl --build <build-triple> --host <host-triple>
                    [--ar <ar>] [--cc <cc>] [--ld <ld>] [--make <make>]
@@ -1129,4 +1130,9 @@ Disable JIT compiler, which is enabled by default to JIT-compile hot frames.
 
 Build support for the fine-grained internal event logger.
 
+=item --siphash13
+
+Hash strings with SipHash-1-3 rather than SipHash-2-4. It is faster, notably
+for long hash keys, while still being keyed with a per-process secret.
+
 =back
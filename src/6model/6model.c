@@ -330,7 +330,7 @@ static void mark_sr_data(MVMThreadContext *tc, MVMFrame *frame, MVMGCWorklist *w
 }
 
 void MVM_6model_istype(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MVMRegister *res) {
-    MVMObject **cache;
+    MVMTypeCheckCache *cache;
     MVMSTable  *st;
     MVMint64    mode;
 
@@ -346,13 +346,9 @@ void MVM_6model_istype(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MV
     if (cache) {
         /* We have the cache, so just look for the type object we
          * want to be in there. */
-        MVMint64 elems = STABLE(obj)->type_check_cache_length;
-        MVMint64 i;
-        for (i = 0; i < elems; i++) {
-            if (cache[i] == type) {
-                res->i64 = 1;
-                return;
-            }
+        if (MVM_6model_type_check_cache_has(cache, type)) {
+            res->i64 = 1;
+            return;
         }
 
         /* If the type check cache is definitive, we're done. */
@@ -408,13 +404,9 @@ void MVM_6model_istype(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MV
 /* Checks if an object has a given type, using the cache only. */
 MVMint64 MVM_6model_istype_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMObject *type) {
     if (!MVM_is_null(tc, obj)) {
-        MVMuint16 i, elems = STABLE(obj)->type_check_cache_length;
-        MVMObject  **cache = STABLE(obj)->type_check_cache;
+        MVMTypeCheckCache *cache = STABLE(obj)->type_check_cache;
         if (cache)
-            for (i = 0; i < elems; i++) {
-                if (cache[i] == type)
-                    return 1;
-            }
+            return MVM_6model_type_check_cache_has(cache, type);
     }
 
     return 0;
@@ -427,14 +419,11 @@ MVMint64 MVM_6model_istype_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMO
  * not tell and a false value is returned and result is undefined. */
 MVMint64 MVM_6model_try_cache_type_check(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MVMint32 *result) {
     if (!MVM_is_null(tc, obj)) {
-        MVMuint16 i, elems = STABLE(obj)->type_check_cache_length;
-        MVMObject  **cache = STABLE(obj)->type_check_cache;
+        MVMTypeCheckCache *cache = STABLE(obj)->type_check_cache;
         if (cache) {
-            for (i = 0; i < elems; i++) {
-                if (cache[i] == type) {
-                    *result = 1;
-                    return 1;
-                }
+            if (MVM_6model_type_check_cache_has(cache, type)) {
+                *result = 1;
+                return 1;
             }
             if ((STABLE(obj)->mode_flags & MVM_TYPE_CHECK_CACHE_THEN_METHOD) == 0 &&
                 (STABLE(type)->mode_flags & MVM_TYPE_CHECK_NEEDS_ACCEPTS) == 0) {
@@ -446,6 +435,55 @@ MVMint64 MVM_6model_try_cache_type_check(MVMThreadContext *tc, MVMObject *obj, M
     return 0;
 }
 
+/* Allocates a type check cache with room for the given number of types,
+ * which are all NULL until the caller sets them, and for an index if the
+ * cache is long enough to be worth having one. */
+MVMTypeCheckCache * MVM_6model_type_check_cache_alloc(MVMThreadContext *tc, MVMuint16 length) {
+    MVMTypeCheckCache *cache;
+    MVMuint32 mask = 0;
+    size_t    size = sizeof(MVMTypeCheckCache) + length * sizeof(MVMObject *);
+    if (length >= MVM_TYPE_CHECK_CACHE_INDEX_MIN) {
+        /* Keep the index at most half full, so probe sequences stay short. */
+        mask = MVM_TYPE_CHECK_CACHE_INDEX_MIN * 2 - 1;
+        while (mask < (MVMuint32)length * 2)
+            mask = mask * 2 + 1;
+        size += (mask + 1) * sizeof(MVMuint16);
+    }
+    cache = MVM_calloc(1, size);
+    cache->types      = (MVMObject **)(cache + 1);
+    cache->index      = mask ? (MVMuint16 *)(cache->types + length) : NULL;
+    cache->index_mask = mask;
+    cache->length     = length;
+    return cache;
+}
+
+/* Builds the index of a type check cache whose types are set, if it has
+ * one, then installs it as the STable's type check cache. Type checks may
+ * be using the old cache on other threads, so it is freed at the next
+ * safepoint. */
+void MVM_6model_set_type_check_cache(MVMThreadContext *tc, MVMSTable *st, MVMTypeCheckCache *cache) {
+    MVMTypeCheckCache *old;
+    if (cache && cache->index) {
+        MVMuint32 mask = cache->index_mask;
+        MVMuint16 i;
+        for (i = 0; i < cache->length; i++) {
+            MVMuint32 slot;
+            if (!cache->types[i])
+                continue;
+            slot = MVM_6model_type_check_cache_slot(cache->types[i], mask);
+            while (cache->index[slot])
+                slot = (slot + 1) & mask;
+            cache->index[slot] = (MVMuint16)(i + 1);
+        }
+    }
+    uv_mutex_lock(&(tc->instance->mutex_free_at_safepoint));
+    old = st->type_check_cache;
+    MVM_store(&(st->type_check_cache), cache);
+    if (old)
+        MVM_free_at_safepoint(tc, old);
+    uv_mutex_unlock(&(tc->instance->mutex_free_at_safepoint));
+}
+
 /* Default invoke function on STables; for non-invokable objects */
 void MVM_6model_invoke_default(MVMThreadContext *tc, MVMObject *invokee, MVMCallsite *callsite, MVMRegister *args) {
     MVM_exception_throw_adhoc(tc, "Cannot invoke this object (REPR: %s; %s)", REPR(invokee)->name, MVM_6model_get_debug_name(tc, invokee));
@@ -22,6 +22,10 @@
 #define MVM_TYPE_CHECK_NEEDS_ACCEPTS       2
 #define MVM_TYPE_CHECK_CACHE_FLAG_MASK     3
 
+/* Type check caches with at least this many entries get an index, so that
+ * looking a type up in them doesn't mean scanning them. */
+#define MVM_TYPE_CHECK_CACHE_INDEX_MIN     8
+
 /* This STable mode flag is set if we consider the method cache authoritative. */
 #define MVM_METHOD_CACHE_AUTHORITATIVE     4
 
@@ -150,6 +154,9 @@ typedef enum {
     /* Has this item been chained into a gen2 freelist? This is only used in
      * GC debug more. */
     MVM_CF_DEBUG_IN_GEN2_FREE_LIST = 4096,
+
+    /* Is this a string in the instance's table of interned strings? */
+    MVM_CF_INTERNED_STRING = 8192,
 } MVMCollectableFlags;
 
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
@@ -249,6 +256,24 @@ struct MVMBoolificationSpec {
  * dispatch cache). */
 #define MVM_TYPE_CACHE_ID_INCR 256
 
+/* A type check cache, allocated as a single block holding the types and,
+ * for long caches, an open addressing index into them, keyed on the type
+ * cache IDs of the types. Each index slot holds the position of a type plus
+ * one, or 0 if it's empty. */
+struct MVMTypeCheckCache {
+    /* The types in the cache. */
+    MVMObject **types;
+
+    /* The index, or NULL if the cache is too short to have one. */
+    MVMuint16 *index;
+
+    /* The number of index slots minus one. */
+    MVMuint32 index_mask;
+
+    /* The number of types in the cache. */
+    MVMuint16 length;
+};
+
 /* S-table, representing a meta-object/representation pairing. Note that the
  * items are grouped in hope that it will pack decently and do decently in
  * terms of cache lines. */
@@ -266,17 +291,15 @@ struct MVMSTable {
      * header. */
     MVMuint32 size;
 
-    /* The length of the type check cache. */
-    MVMuint16 type_check_cache_length;
-
     /* The type checking mode and method cache mode (see flags for this
      * above). */
     MVMuint16 mode_flags;
 
-    /* Array of type objects. If this is set, then it is expected to contain
+    /* The type check cache. If this is set, then it is expected to contain
      * the type objects of all types that this type is equivalent to (e.g.
-     * all the things it isa and all the things it does). */
-    MVMObject **type_check_cache;
+     * all the things it isa and all the things it does). It is only ever
+     * replaced as a whole, so readers see a consistent cache and index. */
+    MVMTypeCheckCache *type_check_cache;
 
     /* By-name method dispatch cache. */
     MVMObject *method_cache;
@@ -703,6 +726,8 @@ void MVM_6model_can_method(MVMThreadContext *tc, MVMObject *obj, MVMString *name
 void MVM_6model_istype(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MVMRegister *res);
 MVM_PUBLIC MVMint64 MVM_6model_istype_cache_only(MVMThreadContext *tc, MVMObject *obj, MVMObject *type);
 MVMint64 MVM_6model_try_cache_type_check(MVMThreadContext *tc, MVMObject *obj, MVMObject *type, MVMint32 *result);
+MVMTypeCheckCache * MVM_6model_type_check_cache_alloc(MVMThreadContext *tc, MVMuint16 length);
+void MVM_6model_set_type_check_cache(MVMThreadContext *tc, MVMSTable *st, MVMTypeCheckCache *cache);
 void MVM_6model_invoke_default(MVMThreadContext *tc, MVMObject *invokee, MVMCallsite *callsite, MVMRegister *args);
 void MVM_6model_stable_gc_free(MVMThreadContext *tc, MVMSTable *st);
 MVMuint64 MVM_6model_next_type_cache_id(MVMThreadContext *tc);
@@ -715,3 +740,28 @@ MVM_STATIC_INLINE char *MVM_6model_get_stable_debug_name(MVMThreadContext *tc, M
     return stable->debug_name ? stable->debug_name : "";
 }
 void MVM_6model_set_debug_name(MVMThreadContext *tc, MVMObject *type, MVMString *name);
+
+/* Looks for a type in a type check cache. */
+MVM_STATIC_INLINE MVMuint32 MVM_6model_type_check_cache_slot(MVMObject *type, MVMuint32 mask) {
+    return (MVMuint32)(STABLE(type)->type_cache_id / MVM_TYPE_CACHE_ID_INCR) & mask;
+}
+MVM_STATIC_INLINE MVMint64 MVM_6model_type_check_cache_has(MVMTypeCheckCache *cache, MVMObject *type) {
+    MVMObject **types = cache->types;
+    MVMuint16  *index = cache->index;
+    if (index) {
+        MVMuint32 mask = cache->index_mask;
+        MVMuint32 i    = MVM_6model_type_check_cache_slot(type, mask);
+        while (index[i]) {
+            if (types[index[i] - 1] == type)
+                return 1;
+            i = (i + 1) & mask;
+        }
+    }
+    else {
+        MVMuint16 i, elems = cache->length;
+        for (i = 0; i < elems; i++)
+            if (types[i] == type)
+                return 1;
+    }
+    return 0;
+}
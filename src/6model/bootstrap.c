@@ -144,9 +144,8 @@ static void compose(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *ar
     method_table = ((MVMKnowHOWREPR *)self)->body.methods;
     MVM_ASSIGN_REF(tc, &(STABLE(type_obj)->header), STABLE(type_obj)->method_cache, method_table);
     STABLE(type_obj)->mode_flags              = MVM_METHOD_CACHE_AUTHORITATIVE;
-    STABLE(type_obj)->type_check_cache_length = 1;
-    STABLE(type_obj)->type_check_cache        = MVM_malloc(sizeof(MVMObject *));
-    MVM_ASSIGN_REF(tc, &(STABLE(type_obj)->header), STABLE(type_obj)->type_check_cache[0], type_obj);
+    STABLE(type_obj)->type_check_cache        = MVM_6model_type_check_cache_alloc(tc, 1);
+    MVM_ASSIGN_REF(tc, &(STABLE(type_obj)->header), STABLE(type_obj)->type_check_cache->types[0], type_obj);
     attributes = ((MVMKnowHOWREPR *)self)->body.attributes;
 
     /* Next steps will allocate, so make sure we keep hold of the type
@@ -555,6 +554,7 @@ static void string_consts(MVMThreadContext *tc) {
     string_creator(P6opaque, "P6opaque");
     string_creator(box_target, "box_target");
     string_creator(array, "array");
+    string_creator(hash, "hash");
     string_creator(positional_delegate, "positional_delegate");
     string_creator(associative_delegate, "associative_delegate");
     string_creator(auto_viv_container, "auto_viv_container");
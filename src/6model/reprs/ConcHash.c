@@ -0,0 +1,421 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps ConcHash_this_repr;
+
+/* How many slots a table has at least. */
+#define MVM_CONC_HASH_MIN_SLOTS 8
+
+MVM_STATIC_INLINE MVMString * get_string_key(MVMThreadContext *tc, MVMObject *key) {
+    if (MVM_UNLIKELY(!key || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key)))
+        MVM_exception_throw_adhoc(tc, "ConcHash representation requires MVMString keys");
+    return (MVMString *)key;
+}
+
+MVM_STATIC_INLINE MVMHashv hash_of(MVMThreadContext *tc, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return key->body.cached_hash_code;
+}
+
+MVM_STATIC_INLINE size_t table_size(MVMuint32 alloc_slots) {
+    return sizeof(MVMConcHashTable) + (alloc_slots - 1) * sizeof(MVMConcHashSlot);
+}
+
+static MVMConcHashTable * new_table(MVMThreadContext *tc, MVMuint32 alloc_slots) {
+    MVMConcHashTable *table = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        table_size(alloc_slots));
+    table->alloc_slots = alloc_slots;
+    return table;
+}
+
+static MVMConcHashBody * new_body(MVMThreadContext *tc) {
+    MVMConcHashBody *body = MVM_calloc(1, sizeof(MVMConcHashBody));
+    int init_stat;
+    if ((init_stat = uv_mutex_init(&body->write_lock)) < 0) {
+        MVM_free(body);
+        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+            uv_strerror(init_stat));
+    }
+    return body;
+}
+
+/* Finds the slot for a key in a table, or NULL if it has none. The slot may
+ * be for a key that was deleted, in which case its value is NULL. Safe to
+ * call without holding the write lock. */
+static MVMConcHashSlot * find_slot(MVMThreadContext *tc, MVMConcHashTable *table,
+        MVMString *key, MVMHashv hash) {
+    MVMuint32 mask = table->alloc_slots - 1;
+    MVMuint32 i    = (MVMuint32)hash & mask;
+    while (1) {
+        MVMConcHashSlot *slot     = &(table->slots[i]);
+        MVMString       *slot_key = (MVMString *)MVM_load(&(slot->key));
+        if (!slot_key)
+            return NULL;
+        if (slot->hash == hash && (slot_key == key || MVM_string_equal(tc, slot_key, key)))
+            return slot;
+        i = (i + 1) & mask;
+    }
+}
+
+/* Finds the free slot a new key goes in. Only called with the write lock
+ * held, or on a table no other thread can see yet. */
+static MVMConcHashSlot * free_slot(MVMConcHashTable *table, MVMHashv hash) {
+    MVMuint32 mask = table->alloc_slots - 1;
+    MVMuint32 i    = (MVMuint32)hash & mask;
+    while (table->slots[i].key)
+        i = (i + 1) & mask;
+    return &(table->slots[i]);
+}
+
+/* Copies the live entries of a table (if any) into a new one with room to
+ * spare. */
+static MVMConcHashTable * copy_table(MVMThreadContext *tc, MVMConcHashTable *from, MVMuint64 elems) {
+    MVMuint32         alloc_slots = MVM_CONC_HASH_MIN_SLOTS;
+    MVMConcHashTable *table;
+    MVMuint32         i;
+    while (alloc_slots / 2 <= elems)
+        alloc_slots *= 2;
+    table = new_table(tc, alloc_slots);
+    if (from) {
+        for (i = 0; i < from->alloc_slots; i++) {
+            MVMConcHashSlot *slot  = &(from->slots[i]);
+            MVMString       *key   = (MVMString *)MVM_load(&(slot->key));
+            MVMObject       *value = key ? (MVMObject *)MVM_load(&(slot->value)) : NULL;
+            if (value) {
+                MVMConcHashSlot *to = free_slot(table, slot->hash);
+                to->key   = key;
+                to->value = value;
+                to->hash  = slot->hash;
+                table->used_slots++;
+            }
+        }
+    }
+    return table;
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &ConcHash_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcHash);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    *(MVMConcHashBody **)data = new_body(tc);
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMConcHashBody  *src_body  = *(MVMConcHashBody **)src;
+    MVMConcHashBody  *dest_body = new_body(tc);
+    MVMConcHashTable *table     = (MVMConcHashTable *)MVM_load(&(src_body->table));
+    MVMuint32 i;
+    *(MVMConcHashBody **)dest = dest_body;
+    if (table) {
+        dest_body->table = copy_table(tc, table, MVM_load(&(src_body->elems)));
+        for (i = 0; i < dest_body->table->alloc_slots; i++) {
+            MVMConcHashSlot *slot = &(dest_body->table->slots[i]);
+            if (slot->key) {
+                MVM_gc_write_barrier(tc, &(dest_root->header), &(slot->key->common.header));
+                MVM_gc_write_barrier(tc, &(dest_root->header), &(slot->value->header));
+                dest_body->elems++;
+            }
+        }
+    }
+}
+
+/* Called by the VM to mark any GCable items. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    /* At this point we know the world is stopped, and thus we can safely do a
+     * traversal of the table without needing locks. */
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMConcHashTable *table = body ? body->table : NULL;
+    MVMuint32 i;
+    if (!table)
+        return;
+    for (i = 0; i < table->alloc_slots; i++) {
+        MVMConcHashSlot *slot = &(table->slots[i]);
+        if (slot->key) {
+            MVM_gc_worklist_add(tc, worklist, &(slot->key));
+            MVM_gc_worklist_add(tc, worklist, &(slot->value));
+        }
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcHashBody *body = ((MVMConcHash *)obj)->body;
+    if (!body)
+        return;
+    if (body->table)
+        MVM_fixed_size_free(tc, tc->instance->fsa, table_size(body->table->alloc_slots),
+            body->table);
+    uv_mutex_destroy(&body->write_lock);
+    MVM_free(body);
+}
+
+static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMString        *key   = get_string_key(tc, key_obj);
+    MVMConcHashTable *table = (MVMConcHashTable *)MVM_load(&(body->table));
+    MVMConcHashSlot  *slot  = table ? find_slot(tc, table, key, hash_of(tc, key)) : NULL;
+    MVMObject        *value = slot ? (MVMObject *)MVM_load(&(slot->value)) : NULL;
+    if (MVM_UNLIKELY(kind != MVM_reg_obj))
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+    result->o = value ? value : tc->instance->VMNull;
+}
+
+static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMString        *key   = get_string_key(tc, key_obj);
+    MVMConcHashTable *table = (MVMConcHashTable *)MVM_load(&(body->table));
+    MVMConcHashSlot  *slot  = table ? find_slot(tc, table, key, hash_of(tc, key)) : NULL;
+    return slot && MVM_load(&(slot->value)) ? 1 : 0;
+}
+
+static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMString        *key   = get_string_key(tc, key_obj);
+    MVMObject        *val   = value.o ? value.o : tc->instance->VMNull;
+    MVMHashv          hash  = hash_of(tc, key);
+    MVMConcHashTable *table;
+    MVMConcHashSlot  *slot;
+    if (MVM_UNLIKELY(kind != MVM_reg_obj))
+        MVM_exception_throw_adhoc(tc,
+            "ConcHash representation does not support native type storage");
+
+    MVMROOT3(tc, root, key, val, {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&body->write_lock);
+        MVM_gc_mark_thread_unblocked(tc);
+    });
+
+    /* Nothing from here to the unlock allocates GC-managed memory, so the
+     * objects can't move under us. */
+    table = body->table;
+    slot  = table ? find_slot(tc, table, key, hash) : NULL;
+    if (slot) {
+        if (!slot->value)
+            MVM_incr(&(body->elems));
+        MVM_gc_write_barrier(tc, &(root->header), &(val->header));
+        MVM_store(&(slot->value), val);
+    }
+    else {
+        if (!table || table->used_slots >= table->alloc_slots / 4 * 3) {
+            /* Out of room; readers go on using the old table until they see
+             * the new one, so free it only once they all can't be. */
+            MVMConcHashTable *old = table;
+            table = copy_table(tc, old, MVM_load(&(body->elems)));
+            MVM_store(&(body->table), table);
+            if (old)
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    table_size(old->alloc_slots), old);
+        }
+
+        /* Fill in the slot before publishing its key, so readers that find
+         * the key also see the rest. */
+        slot        = free_slot(table, hash);
+        slot->value = val;
+        slot->hash  = hash;
+        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
+        MVM_gc_write_barrier(tc, &(root->header), &(val->header));
+        MVM_store(&(slot->key), key);
+        table->used_slots++;
+        MVM_incr(&(body->elems));
+    }
+
+    uv_mutex_unlock(&body->write_lock);
+}
+
+static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
+    MVMConcHashBody  *body = *(MVMConcHashBody **)data;
+    MVMString        *key  = get_string_key(tc, key_obj);
+    MVMHashv          hash = hash_of(tc, key);
+    MVMConcHashSlot  *slot;
+
+    MVMROOT2(tc, root, key, {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&body->write_lock);
+        MVM_gc_mark_thread_unblocked(tc);
+    });
+
+    /* The key stays in its slot, so the probe sequences of other keys are
+     * left intact; it is dropped when the table is next copied. */
+    slot = body->table ? find_slot(tc, body->table, key, hash) : NULL;
+    if (slot && slot->value) {
+        MVM_store(&(slot->value), NULL);
+        MVM_decr(&(body->elems));
+    }
+
+    uv_mutex_unlock(&body->write_lock);
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcHashBody *body = *(MVMConcHashBody **)data;
+    return MVM_load(&(body->elems));
+}
+
+static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+    spec.can_box         = 0;
+    spec.bits            = 0;
+    spec.align           = 0;
+    spec.is_unsigned     = 0;
+    return spec;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Deserialize the representation. */
+static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMSerializationReader *reader) {
+    MVMint64 elems = MVM_serialization_read_int(tc, reader);
+    MVMint64 i;
+    if (!*(MVMConcHashBody **)data)
+        *(MVMConcHashBody **)data = new_body(tc);
+    for (i = 0; i < elems; i++) {
+        MVMRegister value;
+        MVMString  *key;
+        key = MVM_serialization_read_str(tc, reader);
+        MVMROOT(tc, key, {
+            value.o = MVM_serialization_read_ref(tc, reader);
+        });
+        bind_key(tc, st, root, data, (MVMObject *)key, value, MVM_reg_obj);
+    }
+}
+
+/* Serialize the representation; the keys are sorted so that the output
+ * doesn't depend on the hash secret. */
+static MVMThreadContext *cmp_tc;
+static int cmp_strings(const void *s1, const void *s2) {
+    return MVM_string_compare(cmp_tc, *(MVMString **)s1, *(MVMString **)s2);
+}
+static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMConcHashTable *table = (MVMConcHashTable *)MVM_load(&(body->table));
+    MVMuint32         alloc = table ? table->alloc_slots : 0;
+    MVMString       **keys  = MVM_malloc(sizeof(MVMString *) * (alloc ? alloc : 1));
+    MVMuint32         num   = 0;
+    MVMuint32         i;
+    for (i = 0; i < alloc; i++)
+        if (MVM_load(&(table->slots[i].key)) && MVM_load(&(table->slots[i].value)))
+            keys[num++] = table->slots[i].key;
+    cmp_tc = tc;
+    qsort(keys, num, sizeof(MVMString *), cmp_strings);
+    MVM_serialization_write_int(tc, writer, num);
+    for (i = 0; i < num; i++) {
+        MVMConcHashSlot *slot = find_slot(tc, table, keys[i], hash_of(tc, keys[i]));
+        MVMObject *value = (MVMObject *)MVM_load(&(slot->value));
+        MVM_serialization_write_str(tc, writer, keys[i]);
+        MVM_serialization_write_ref(tc, writer, value ? value : tc->instance->VMNull);
+    }
+    MVM_free(keys);
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcHash);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcHashBody  *body  = *(MVMConcHashBody **)data;
+    MVMConcHashTable *table = (MVMConcHashTable *)MVM_load(&(body->table));
+    return sizeof(MVMConcHashBody) + (table ? table_size(table->alloc_slots) : 0);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc) {
+    return &ConcHash_this_repr;
+}
+
+static const MVMREPROps ConcHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    {
+        at_key,
+        bind_key,
+        exists_key,
+        delete_key,
+        get_value_storage_spec
+    },    /* ass_funcs */
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    serialize,
+    deserialize,
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "ConcHash", /* name */
+    MVM_REPR_ID_ConcHash,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Takes a snapshot of a concurrent hash as a VMHash, which is what we
+ * iterate, so that other threads can go on writing meanwhile. */
+MVMObject * MVM_conc_hash_snapshot(MVMThreadContext *tc, MVMObject *hash) {
+    MVMObject        *result;
+    MVMConcHashTable *table;
+    MVMuint32         i;
+    MVMROOT(tc, hash, {
+        result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    });
+
+    /* Binding into a VMHash allocates nothing GC-managed, so there's no
+     * safepoint until we're done with the table. */
+    table = (MVMConcHashTable *)MVM_load(&(((MVMConcHash *)hash)->body->table));
+    if (table) {
+        for (i = 0; i < table->alloc_slots; i++) {
+            MVMConcHashSlot *slot = &(table->slots[i]);
+            MVMString       *key  = (MVMString *)MVM_load(&(slot->key));
+            if (key) {
+                MVMObject *value = (MVMObject *)MVM_load(&(slot->value));
+                if (value)
+                    MVM_repr_bind_key_o(tc, result, key, value);
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+/* A slot in a concurrent hash table. A slot's key is set once, and never
+ * changes for as long as the table is in use; deleting a key just clears its
+ * value. */
+struct MVMConcHashSlot {
+    MVMString *key;
+    MVMObject *value;
+    MVMHashv   hash;
+};
+
+/* A table of slots, probed linearly from the slot the hash picks. When it
+ * fills up, the live entries are copied to a new table, and the old one is
+ * freed at the next safepoint, once no reader can be looking at it. */
+struct MVMConcHashTable {
+    /* How many slots there are (a power of 2), and how many have a key. */
+    MVMuint32 alloc_slots;
+    MVMuint32 used_slots;
+
+    MVMConcHashSlot slots[1];
+};
+
+/* Representation of a hash with string keys that may be used by many
+ * threads at once. Reads take no locks; writes to a hash are serialized by
+ * its own lock, and publish each change with a single store, so readers
+ * always see a consistent table. As with ConcBlockingQueue, the body is
+ * allocated with malloc and the object points to it, so the lock doesn't
+ * move. */
+struct MVMConcHashBody {
+    /* The current table; NULL until the first key is bound. */
+    MVMConcHashTable *table;
+
+    /* How many keys the hash holds. */
+    AO_t elems;
+
+    /* Lock held while writing. */
+    uv_mutex_t write_lock;
+};
+
+struct MVMConcHash {
+    MVMObject common;
+    /* As noted, a pointer, not an inline struct */
+    MVMConcHashBody *body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcHash_initialize(MVMThreadContext *tc);
+
+/* Takes a snapshot of a concurrent hash as a VMHash. */
+MVMObject * MVM_conc_hash_snapshot(MVMThreadContext *tc, MVMObject *hash);
@@ -93,6 +93,7 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
             body->num_strings * sizeof(MVMString *),
             body->strings);
     MVM_free(body->scs);
+    MVM_free(body->cache_hash);
     MVM_free(body->scs_to_resolve);
     MVM_free(body->sc_handle_idxs);
     MVM_free(body->string_heap_fast_table);
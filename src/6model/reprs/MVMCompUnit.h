@@ -144,6 +144,21 @@ struct MVMCompUnitBody {
 
     /* Was a frame in this compilation unit invoked yet? */
     MVMuint8 invoked;
+
+    /* Hex SHA-1 that identifies this compilation unit in the validation
+     * cache and hot frame hints directories; computed when first needed. */
+    char *cache_hash;
+
+    /* Whether we looked for the validation cache of this compilation unit
+     * yet, and the cache, if it has one. Both protected by the instance's
+     * validation cache mutex. */
+    MVMuint8 validation_cache_checked;
+    MVMValidationCache *validation_cache;
+
+    /* Likewise for the hints of which frames are known to be hot, protected
+     * by the frame deserialization mutex. */
+    MVMuint8 spesh_hot_hints_checked;
+    MVMSpeshHotHints *spesh_hot_hints;
 };
 struct MVMCompUnit {
     MVMObject common;
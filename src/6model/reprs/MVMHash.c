@@ -23,61 +23,159 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
     return st->WHAT;
 }
 
+/* How many entries there is room for in a hash once it holds anything. */
+#define MVM_HASH_INITIAL_ENTRIES 8
+
+MVM_STATIC_INLINE MVMHashv hash_of(MVMThreadContext *tc, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return key->body.cached_hash_code;
+}
+
+/* Finds the index slot that refers to the entry for the key, or if there is
+ * none, the empty slot where an entry for it would go. The index must have
+ * been allocated. */
+static MVMuint32 find_slot(MVMThreadContext *tc, MVMHashBody *body, MVMString *key, MVMHashv hash) {
+    MVMuint32 mask = 2 * body->alloc_entries - 1;
+    MVMuint32 tag  = (MVMuint32)(hash >> 32);
+    MVMuint32 i    = (MVMuint32)hash & mask;
+    while (1) {
+        MVMHashIndexSlot *slot = &(body->index[i]);
+        if (!slot->entry)
+            return i;
+        if (slot->tag == tag) {
+            MVMHashKV *entry = &(body->entries[slot->entry - 1]);
+            if (entry->hash == hash && (entry->key == key || MVM_string_equal(tc, entry->key, key)))
+                return i;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+/* Finds the entry for a key, or NULL if there is none. */
+static MVMHashKV * find_entry(MVMThreadContext *tc, MVMHashBody *body, MVMString *key) {
+    MVMuint32 slot;
+    if (!body->num_items)
+        return NULL;
+    slot = find_slot(tc, body, key, hash_of(tc, key));
+    return body->index[slot].entry ? &(body->entries[body->index[slot].entry - 1]) : NULL;
+}
+
+/* Squeezes the holes out of the entries, makes room for alloc_entries of
+ * them, and builds a new index. */
+static void rebuild(MVMThreadContext *tc, MVMHashBody *body, MVMuint32 alloc_entries) {
+    MVMuint32 mask = 2 * alloc_entries - 1;
+    MVMuint32 from, to = 0;
+    for (from = 0; from < body->num_entries; from++)
+        if (body->entries[from].key)
+            body->entries[to++] = body->entries[from];
+    body->num_entries = to;
+    if (alloc_entries != body->alloc_entries) {
+        body->entries       = MVM_realloc(body->entries, alloc_entries * sizeof(MVMHashKV));
+        body->alloc_entries = alloc_entries;
+    }
+    MVM_free(body->index);
+    body->index = MVM_calloc(2 * alloc_entries, sizeof(MVMHashIndexSlot));
+    for (to = 0; to < body->num_entries; to++) {
+        MVMHashv  hash = body->entries[to].hash;
+        MVMuint32 i    = (MVMuint32)hash & mask;
+        while (body->index[i].entry)
+            i = (i + 1) & mask;
+        body->index[i].entry = to + 1;
+        body->index[i].tag   = (MVMuint32)(hash >> 32);
+    }
+}
+
+/* Binds a value to a key, adding an entry if there's none for the key yet. */
+static void bind_entry(MVMThreadContext *tc, MVMObject *root, MVMHashBody *body, MVMString *key, MVMObject *value) {
+    MVMHashv  hash = hash_of(tc, key);
+    MVMuint32 slot;
+    MVMHashKV *entry;
+    if (!body->alloc_entries)
+        rebuild(tc, body, MVM_HASH_INITIAL_ENTRIES);
+    slot = find_slot(tc, body, key, hash);
+    if (body->index[slot].entry) {
+        MVM_ASSIGN_REF(tc, &(root->header), body->entries[body->index[slot].entry - 1].value, value);
+        return;
+    }
+    if (body->num_entries == body->alloc_entries) {
+        /* Out of room. If at least a quarter of the entries are holes, it's
+         * enough to squeeze them out; otherwise, grow. */
+        rebuild(tc, body, body->num_items <= body->alloc_entries / 4 * 3
+            ? body->alloc_entries
+            : body->alloc_entries * 2);
+        slot = find_slot(tc, body, key, hash);
+    }
+    entry        = &(body->entries[body->num_entries]);
+    entry->key   = key;
+    entry->hash  = hash;
+    entry->value = NULL;
+    MVM_ASSIGN_REF(tc, &(root->header), entry->value, value);
+    MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
+    body->index[slot].entry = ++body->num_entries;
+    body->index[slot].tag   = (MVMuint32)(hash >> 32);
+    body->num_items++;
+}
+
 /* Copies the body of one object to another. */
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMHashBody *src_body  = (MVMHashBody *)src;
     MVMHashBody *dest_body = (MVMHashBody *)dest;
-    MVMHashEntry *current  = NULL;
-
-    /* NOTE: if we really wanted to, we could avoid rehashing... */
-    HASH_ITER_FAST(tc, hash_handle, src_body->hash_head, current, {
-        MVMHashEntry *new_entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVMString *key = MVM_HASH_KEY(current);
-        MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, current->value);
-        MVM_HASH_BIND(tc, dest_body->hash_head, key, new_entry);
-        MVM_gc_write_barrier(tc, &(dest_root->header), &(key->common.header));
-    });
+    MVMuint32 i;
+    if (!src_body->alloc_entries)
+        return;
+    /* The layout doesn't depend on where the hash lives, so just copy it. */
+    dest_body->entries = MVM_malloc(src_body->alloc_entries * sizeof(MVMHashKV));
+    memcpy(dest_body->entries, src_body->entries, src_body->num_entries * sizeof(MVMHashKV));
+    dest_body->index = MVM_malloc(2 * src_body->alloc_entries * sizeof(MVMHashIndexSlot));
+    memcpy(dest_body->index, src_body->index, 2 * src_body->alloc_entries * sizeof(MVMHashIndexSlot));
+    dest_body->num_entries   = src_body->num_entries;
+    dest_body->alloc_entries = src_body->alloc_entries;
+    dest_body->num_items     = src_body->num_items;
+    for (i = 0; i < dest_body->num_entries; i++) {
+        MVMHashKV *entry = &(dest_body->entries[i]);
+        if (entry->key) {
+            MVM_gc_write_barrier(tc, &(dest_root->header), &(entry->key->common.header));
+            if (entry->value)
+                MVM_gc_write_barrier(tc, &(dest_root->header), &(entry->value->header));
+        }
+    }
 }
 
 /* Adds held objects to the GC worklist. */
 static void MVMHash_gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
-    MVMHashBody     *body = (MVMHashBody *)data;
-    MVMHashEntry *current = NULL;
-    MVM_gc_worklist_presize_for(tc, worklist, 2 * HASH_CNT(hash_handle, body->hash_head));
+    MVMHashBody *body = (MVMHashBody *)data;
+    MVMHashKV   *entry = body->entries;
+    MVMHashKV   *end   = body->entries + body->num_entries;
+    MVM_gc_worklist_presize_for(tc, worklist, 2 * body->num_items);
     if (worklist->include_gen2) {
-        HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-            MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
-            MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->value);
-        });
+        for (; entry < end; entry++) {
+            if (entry->key) {
+                MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &entry->key);
+                MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &entry->value);
+            }
+        }
     }
     else {
-        HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-            MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
-            MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &current->value);
-        });
+        for (; entry < end; entry++) {
+            if (entry->key) {
+                MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &entry->key);
+                MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &entry->value);
+            }
+        }
     }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMHash *h = (MVMHash *)obj;
-    MVMHashEntry *current = NULL, *tmp = NULL;
-    HASH_ITER_FAST(tc, hash_handle, h->body.hash_head, current, {
-        if (current != h->body.hash_head)
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), current);
-    });
-    tmp = h->body.hash_head;
-    HASH_CLEAR(tc, hash_handle, h->body.hash_head);
-    if (tmp)
-        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), tmp);
+    MVM_free(h->body.entries);
+    MVM_free(h->body.index);
 }
 
 static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
-    MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-    /* key_obj checked in MVM_HASH_GET */
-    MVM_HASH_GET(tc, body->hash_head, (MVMString *)key_obj, entry);
+    MVMHashBody *body = (MVMHashBody *)data;
+    MVMHashKV  *entry = find_entry(tc, body, get_string_key(tc, key_obj));
     if (MVM_LIKELY(kind == MVM_reg_obj))
         result->o = entry != NULL ? entry->value : tc->instance->VMNull;
     else
@@ -89,52 +187,60 @@ void MVMHash_at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
 }
 
 static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
-    MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-
-    MVMString *key = (MVMString *)key_obj; /* Checked in MVM_HASH_GET. */
+    MVMString *key = get_string_key(tc, key_obj);
     if (MVM_UNLIKELY(kind != MVM_reg_obj))
         MVM_exception_throw_adhoc(tc,
             "MVMHash representation does not support native type storage");
-
-    /* first check whether we can must update the old entry. */
-    MVM_HASH_GET(tc, body->hash_head, key, entry);
-    if (!entry) {
-        entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-        MVM_HASH_BIND(tc, body->hash_head, key, entry);
-        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
-    }
-    else {
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-    }
+    bind_entry(tc, root, (MVMHashBody *)data, key, value.o);
 }
 void MVMHash_bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
     bind_key(tc, st, root, data, key_obj, value, kind);
 }
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMHashBody *body = (MVMHashBody *)data;
-    return HASH_CNT(hash_handle, body->hash_head);
+    return body->num_items;
 }
 
 static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
-    MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-    /* key_obj checked in MVM_HASH_GET */
-    MVM_HASH_GET(tc, body->hash_head, (MVMString *)key_obj, entry);
-    return entry != NULL;
+    MVMHashBody *body = (MVMHashBody *)data;
+    return find_entry(tc, body, get_string_key(tc, key_obj)) != NULL;
 }
 
 static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMString *key = get_string_key(tc, key_obj);
-    MVMHashEntry *old_entry = NULL, *prev_entry = NULL;
-    HASH_FIND_VM_STR_AND_DELETE(tc, hash_handle, body->hash_head, key, old_entry, prev_entry);
-    if (old_entry) {
-        MVM_fixed_size_free(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry), old_entry);
+    MVMString   *key  = get_string_key(tc, key_obj);
+    MVMuint32    mask, i, j;
+    MVMHashKV   *entry;
+    if (!body->num_items)
+        return;
+    mask = 2 * body->alloc_entries - 1;
+    i    = find_slot(tc, body, key, hash_of(tc, key));
+    if (!body->index[i].entry)
+        return;
+
+    /* Leave a hole in the entries, so iterators aren't disturbed. */
+    entry        = &(body->entries[body->index[i].entry - 1]);
+    entry->key   = NULL;
+    entry->value = NULL;
+    body->num_items--;
+    if (!body->num_items)
+        body->num_entries = 0;
+
+    /* Take the slot out of the index, moving back any later slots in the
+     * same run that would no longer be found from where they hash to. */
+    j = i;
+    while (1) {
+        MVMuint32 home;
+        j = (j + 1) & mask;
+        if (!body->index[j].entry)
+            break;
+        home = (MVMuint32)body->entries[body->index[j].entry - 1].hash & mask;
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        body->index[i] = body->index[j];
+        i = j;
     }
+    body->index[i].entry = 0;
 }
 
 static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
@@ -175,10 +281,7 @@ static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, vo
     for (i = 0; i < elems; i++) {
         MVMString *key = MVM_serialization_read_str(tc, reader);
         MVMObject *value = MVM_serialization_read_ref(tc, reader);
-        MVMHashEntry *entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value);
-        MVM_HASH_BIND(tc, body->hash_head, key, entry);
+        bind_entry(tc, root, body, key, value);
     }
 }
 
@@ -189,19 +292,18 @@ static int cmp_strings(const void *s1, const void *s2) {
 }
 static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *current = NULL;
-    MVMuint64 elems = HASH_CNT(hash_handle, body->hash_head);
+    MVMuint64 elems = body->num_items;
     MVMString **keys = MVM_malloc(sizeof(MVMString *) * elems);
     MVMuint64 i = 0;
+    MVMuint32 pos;
     MVM_serialization_write_int(tc, writer, elems);
-    HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-        keys[i++] = MVM_HASH_KEY(current);
-    });
+    for (pos = 0; pos < body->num_entries; pos++)
+        if (body->entries[pos].key)
+            keys[i++] = body->entries[pos].key;
     cmp_tc = tc;
     qsort(keys, elems, sizeof(MVMString*), cmp_strings);
     for (i = 0; i < elems; i++) {
-        MVMHashEntry *entry;
-        MVM_HASH_GET(tc, body->hash_head, keys[i], entry);
+        MVMHashKV *entry = find_entry(tc, body, keys[i]);
         MVM_serialization_write_str(tc, writer, keys[i]);
         MVM_serialization_write_ref(tc, writer, entry->value);
     }
@@ -240,7 +342,7 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMHashBody *body = (MVMHashBody *)data;
 
-    return sizeof(MVMHashEntry) * HASH_CNT(hash_handle, body->hash_head);
+    return body->alloc_entries * (sizeof(MVMHashKV) + 2 * sizeof(MVMHashIndexSlot));
 }
 
 /* Initializes the representation. */
@@ -1,22 +1,54 @@
-/* Representation used by VM-level hashes. */
+/* Representation used by VM-level hashes.
+ *
+ * The entries are kept inline in an array, in the order they were added, with
+ * the key, the value and the key's hash. Lookups go through an index of twice
+ * as many slots as there is room for entries, probed linearly from the slot
+ * the hash picks. Deleting an entry leaves a hole in the entries array (a
+ * NULL key), which keeps iterators valid; holes are squeezed out the next
+ * time the entries array fills up. */
 
-struct MVMHashEntry {
-    /* value object */
+struct MVMHashKV {
+    MVMString *key;
     MVMObject *value;
+    MVMHashv   hash;
+};
 
-    /* the uthash hash handle inline struct, including the key. */
-    UT_hash_handle hash_handle;
+/* A slot in the index: 1 plus the index of the entry it refers to, or 0 if
+ * it is empty, and the top half of the entry's hash, so that we only look at
+ * entries that are likely to match. */
+struct MVMHashIndexSlot {
+    MVMuint32 entry;
+    MVMuint32 tag;
 };
 
 struct MVMHashBody {
-    /* uthash updates this pointer directly. */
-    MVMHashEntry *hash_head;
+    /* The entries, and the index; both NULL until the first key is bound. */
+    MVMHashKV        *entries;
+    MVMHashIndexSlot *index;
+
+    /* How many entries are used, including deleted ones, and how many there
+     * is room for (a power of 2; the index has twice as many slots). */
+    MVMuint32 num_entries;
+    MVMuint32 alloc_entries;
+
+    /* How many keys the hash holds. */
+    MVMuint32 num_items;
 };
 struct MVMHash {
     MVMObject common;
     MVMHashBody body;
 };
 
+/* Entry used by the uthash-based tables kept elsewhere in the VM (this is
+ * no longer how VM-level hashes are stored). */
+struct MVMHashEntry {
+    /* value object */
+    MVMObject *value;
+
+    /* the uthash hash handle inline struct, including the key. */
+    UT_hash_handle hash_handle;
+};
+
 /* Function for REPR setup. */
 const MVMREPROps * MVMHash_initialize(MVMThreadContext *tc);
 
@@ -56,5 +88,14 @@ const MVMREPROps * MVMHash_initialize(MVMThreadContext *tc);
     MVM_free(tmp); \
 } while (0)
 
+/* Finds the first entry that is still in the hash at or after the given
+ * position in the entries, returning its position, or num_entries if there
+ * are none. */
+MVM_STATIC_INLINE MVMuint32 MVM_hash_next_entry(MVMHashBody *body, MVMuint32 pos) {
+    while (pos < body->num_entries && !body->entries[pos].key)
+        pos++;
+    return pos < body->num_entries ? pos : body->num_entries;
+}
+
 void MVMHash_at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind);
 void MVMHash_bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind);
@@ -0,0 +1,604 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps MVMIntHash_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st = MVM_gc_allocate_stable(tc, &MVMIntHash_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)MVM_malloc(sizeof(MVMIntHashREPRData));
+
+        repr_data->value_kind = MVM_reg_obj;
+        repr_data->value_type = NULL;
+
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMIntHash);
+        st->REPR_data = repr_data;
+    });
+
+    return st->WHAT;
+}
+
+/* How many slots a hash has once it holds anything. */
+#define MVM_INT_HASH_INITIAL_SLOTS 8
+
+/* Hashes a key, using the finalizer of MurmurHash3. The key is mixed with
+ * the instance's hash secret first, so the slots keys land in can't be
+ * worked out from outside. */
+MVM_STATIC_INLINE MVMuint64 hash_key(MVMThreadContext *tc, MVMint64 key) {
+    MVMuint64 h = (MVMuint64)key ^ tc->instance->hashSecrets[0];
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Finds the slot holding a key, or returns -1 if it is not in the hash. */
+static MVMint64 find_slot(MVMThreadContext *tc, MVMIntHashBody *body, MVMint64 key, MVMuint64 hash) {
+    MVMuint32 mask, i;
+    if (!body->elems)
+        return -1;
+    mask = body->alloc_slots - 1;
+    i    = (MVMuint32)hash & mask;
+    while (body->states[i] != MVM_INT_HASH_EMPTY) {
+        if (body->states[i] == MVM_INT_HASH_FULL && body->slots[i].key == key)
+            return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/* Moves the keys into a new table of alloc_slots slots, dropping the
+ * deleted ones. */
+static void rebuild(MVMThreadContext *tc, MVMIntHashBody *body, MVMuint32 alloc_slots) {
+    MVMIntHashSlot *old_slots  = body->slots;
+    MVMuint8       *old_states = body->states;
+    MVMuint32       old_alloc  = body->alloc_slots;
+    MVMuint32       mask       = alloc_slots - 1;
+    MVMuint32       i;
+    body->slots       = MVM_malloc(alloc_slots * (sizeof(MVMIntHashSlot) + 1));
+    body->states      = (MVMuint8 *)(body->slots + alloc_slots);
+    body->alloc_slots = alloc_slots;
+    body->used_slots  = (MVMuint32)body->elems;
+    memset(body->states, MVM_INT_HASH_EMPTY, alloc_slots);
+    for (i = 0; i < old_alloc; i++) {
+        if (old_states[i] == MVM_INT_HASH_FULL) {
+            MVMuint32 j = (MVMuint32)hash_key(tc, old_slots[i].key) & mask;
+            while (body->states[j] != MVM_INT_HASH_EMPTY)
+                j = (j + 1) & mask;
+            body->slots[j]  = old_slots[i];
+            body->states[j] = MVM_INT_HASH_FULL;
+        }
+    }
+    MVM_free(old_slots);
+}
+
+static const char * kind_name(MVMuint16 kind) {
+    switch (kind) {
+        case MVM_reg_int64: return "int";
+        case MVM_reg_num64: return "num";
+        case MVM_reg_str:   return "string";
+        default:            return "object";
+    }
+}
+
+MVM_STATIC_INLINE void check_kind(MVMThreadContext *tc, MVMIntHashREPRData *repr_data,
+        const char *op, MVMuint16 kind) {
+    if (MVM_UNLIKELY(kind != repr_data->value_kind))
+        MVM_exception_throw_adhoc(tc, "VMIntHash: %s expected %s register",
+            op, kind_name(repr_data->value_kind));
+}
+
+void MVMIntHash_at_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data,
+        MVMint64 key, MVMRegister *result, MVMuint16 kind) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMint64            slot;
+    check_kind(tc, repr_data, "atkey", kind);
+    slot = find_slot(tc, body, key, hash_key(tc, key));
+    if (slot >= 0) {
+        *result = body->slots[slot].value;
+        if (kind == MVM_reg_obj && !result->o)
+            result->o = tc->instance->VMNull;
+    }
+    else {
+        switch (kind) {
+            case MVM_reg_obj:   result->o   = tc->instance->VMNull; break;
+            case MVM_reg_int64: result->i64 = 0;                    break;
+            case MVM_reg_num64: result->n64 = 0.0;                  break;
+            default:            result->s   = NULL;                 break;
+        }
+    }
+}
+
+void MVMIntHash_bind_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data,
+        MVMint64 key, MVMRegister value, MVMuint16 kind) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMuint64           hash      = hash_key(tc, key);
+    MVMint64            slot;
+    check_kind(tc, repr_data, "bindkey", kind);
+
+    slot = find_slot(tc, body, key, hash);
+    if (slot < 0) {
+        MVMuint32 mask, i;
+        if (body->used_slots >= body->alloc_slots / 4 * 3) {
+            /* Too full. If at least half of the slots would still be free
+             * once the deleted ones are dropped, that's enough; otherwise,
+             * grow. */
+            rebuild(tc, body, !body->alloc_slots
+                ? MVM_INT_HASH_INITIAL_SLOTS
+                : body->elems < body->alloc_slots / 2
+                    ? body->alloc_slots
+                    : body->alloc_slots * 2);
+        }
+        mask = body->alloc_slots - 1;
+        i    = (MVMuint32)hash & mask;
+        while (body->states[i] == MVM_INT_HASH_FULL)
+            i = (i + 1) & mask;
+        if (body->states[i] == MVM_INT_HASH_EMPTY)
+            body->used_slots++;
+        body->states[i]          = MVM_INT_HASH_FULL;
+        body->slots[i].key       = key;
+        body->slots[i].value.i64 = 0;
+        body->elems++;
+        slot = i;
+    }
+
+    switch (kind) {
+        case MVM_reg_obj:
+            MVM_ASSIGN_REF(tc, &(root->header), body->slots[slot].value.o, value.o);
+            break;
+        case MVM_reg_str:
+            MVM_ASSIGN_REF(tc, &(root->header), body->slots[slot].value.s, value.s);
+            break;
+        default:
+            body->slots[slot].value = value;
+            break;
+    }
+}
+
+MVMint64 MVMIntHash_exists_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
+        void *data, MVMint64 key) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return find_slot(tc, body, key, hash_key(tc, key)) >= 0;
+}
+
+static void delete_int_key(MVMThreadContext *tc, MVMIntHashBody *body, MVMint64 key) {
+    MVMint64 slot = find_slot(tc, body, key, hash_key(tc, key));
+    if (slot < 0)
+        return;
+
+    /* Mark the slot deleted rather than empty, so later keys that probed
+     * past it are still found, and iterators aren't disturbed. */
+    body->states[slot]          = MVM_INT_HASH_DELETED;
+    body->slots[slot].value.i64 = 0;
+    body->elems--;
+    if (!body->elems) {
+        memset(body->states, MVM_INT_HASH_EMPTY, body->alloc_slots);
+        body->used_slots = 0;
+    }
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *src_body  = (MVMIntHashBody *)src;
+    MVMIntHashBody     *dest_body = (MVMIntHashBody *)dest;
+    MVMuint32 i;
+    if (!src_body->alloc_slots)
+        return;
+    dest_body->slots = MVM_malloc(src_body->alloc_slots * (sizeof(MVMIntHashSlot) + 1));
+    memcpy(dest_body->slots, src_body->slots,
+        src_body->alloc_slots * (sizeof(MVMIntHashSlot) + 1));
+    dest_body->states      = (MVMuint8 *)(dest_body->slots + src_body->alloc_slots);
+    dest_body->alloc_slots = src_body->alloc_slots;
+    dest_body->used_slots  = src_body->used_slots;
+    dest_body->elems       = src_body->elems;
+    if (repr_data->value_kind == MVM_reg_obj || repr_data->value_kind == MVM_reg_str) {
+        for (i = 0; i < dest_body->alloc_slots; i++) {
+            MVMCollectable *value = (MVMCollectable *)dest_body->slots[i].value.o;
+            if (dest_body->states[i] == MVM_INT_HASH_FULL && value)
+                MVM_gc_write_barrier(tc, &(dest_root->header), value);
+        }
+    }
+}
+
+/* Adds held objects to the GC worklist. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMuint32 i;
+    if (repr_data->value_kind != MVM_reg_obj && repr_data->value_kind != MVM_reg_str)
+        return;
+    MVM_gc_worklist_presize_for(tc, worklist, body->elems);
+    for (i = 0; i < body->alloc_slots; i++)
+        if (body->states[i] == MVM_INT_HASH_FULL)
+            MVM_gc_worklist_add(tc, worklist, &(body->slots[i].value.o));
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMIntHash *h = (MVMIntHash *)obj;
+    MVM_free(h->body.slots);
+}
+
+/* Marks the value type held in the REPR data. */
+static void gc_mark_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMGCWorklist *worklist) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    if (repr_data == NULL)
+        return;
+    MVM_gc_worklist_add(tc, worklist, &repr_data->value_type);
+}
+
+/* Frees the representation data in an STable. */
+static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
+    MVM_free(st->REPR_data);
+}
+
+/* The associative functions take keys as objects; we take either a string,
+ * which is parsed as an integer, or anything that unboxes to one. */
+static MVMint64 get_int_key(MVMThreadContext *tc, MVMObject *key) {
+    if (MVM_UNLIKELY(!key || !IS_CONCRETE(key)))
+        MVM_exception_throw_adhoc(tc,
+            "VMIntHash representation requires concrete integer or string keys");
+    return REPR(key)->ID == MVM_REPR_ID_MVMString
+        ? MVM_coerce_s_i(tc, (MVMString *)key)
+        : MVM_repr_get_int(tc, key);
+}
+
+static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key, MVMRegister *result, MVMuint16 kind) {
+    MVMIntHash_at_int_key(tc, st, root, data, get_int_key(tc, key), result, kind);
+}
+
+static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key, MVMRegister value, MVMuint16 kind) {
+    MVMIntHash_bind_int_key(tc, st, root, data, get_int_key(tc, key), value, kind);
+}
+
+static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key) {
+    return MVMIntHash_exists_int_key(tc, st, root, data, get_int_key(tc, key));
+}
+
+static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key) {
+    delete_int_key(tc, (MVMIntHashBody *)data, get_int_key(tc, key));
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return body->elems;
+}
+
+static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMStorageSpec spec;
+    spec.bits        = 0;
+    spec.align       = 0;
+    spec.is_unsigned = 0;
+    switch (repr_data->value_kind) {
+        case MVM_reg_int64:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_INT;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_INT;
+            spec.bits            = 64;
+            spec.align           = ALIGNOF(MVMint64);
+            break;
+        case MVM_reg_num64:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NUM;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_NUM;
+            spec.bits            = 64;
+            spec.align           = ALIGNOF(MVMnum64);
+            break;
+        case MVM_reg_str:
+            spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_STR;
+            spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_STR;
+            break;
+        default:
+            spec.inlineable      = MVM_STORAGE_SPEC_REFERENCE;
+            spec.boxed_primitive = MVM_STORAGE_SPEC_BP_NONE;
+            spec.can_box         = 0;
+            break;
+    }
+    return spec;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Sets the value type, working out how values will be stored from it: as
+ * native ints, nums or strings if it's a native type, and as objects
+ * otherwise. */
+static void set_value_type(MVMThreadContext *tc, MVMSTable *st, MVMIntHashREPRData *repr_data, MVMObject *type) {
+    MVM_ASSIGN_REF(tc, &(st->header), repr_data->value_type, type);
+    repr_data->value_kind = MVM_reg_obj;
+    if (type) {
+        const MVMStorageSpec *spec = REPR(type)->get_storage_spec(tc, STABLE(type));
+        if (spec->inlineable == MVM_STORAGE_SPEC_INLINED) {
+            switch (spec->boxed_primitive) {
+                case MVM_STORAGE_SPEC_BP_INT: repr_data->value_kind = MVM_reg_int64; break;
+                case MVM_STORAGE_SPEC_BP_NUM: repr_data->value_kind = MVM_reg_num64; break;
+                case MVM_STORAGE_SPEC_BP_STR: repr_data->value_kind = MVM_reg_str;   break;
+            }
+        }
+    }
+}
+
+/* Compose the representation. The value type may be given as the type key
+ * of a hash key of the info. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
+    MVMStringConsts     str_consts = tc->instance->str_consts;
+    MVMIntHashREPRData *repr_data  = (MVMIntHashREPRData *)st->REPR_data;
+
+    MVMObject *info = MVM_repr_at_key_o(tc, info_hash, str_consts.hash);
+    if (!MVM_is_null(tc, info)) {
+        MVMObject *type = MVM_repr_at_key_o(tc, info, str_consts.type);
+        if (!MVM_is_null(tc, type))
+            set_value_type(tc, st, repr_data, type);
+    }
+}
+
+/* Serializes the REPR data. */
+static void serialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationWriter *writer) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVM_serialization_write_ref(tc, writer, repr_data->value_type);
+}
+
+/* Deserializes the REPR data. */
+static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)MVM_malloc(sizeof(MVMIntHashREPRData));
+    MVMObject          *type      = MVM_serialization_read_ref(tc, reader);
+    repr_data->value_type = NULL;
+    st->REPR_data = repr_data;
+    if (type)
+        MVM_serialization_force_stable(tc, reader, STABLE(type));
+    set_value_type(tc, st, repr_data, type);
+}
+
+/* Deserialize the representation. */
+static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMSerializationReader *reader) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMint64 elems = MVM_serialization_read_int(tc, reader);
+    MVMint64 i;
+    for (i = 0; i < elems; i++) {
+        MVMint64    key = MVM_serialization_read_int(tc, reader);
+        MVMRegister value;
+        switch (repr_data->value_kind) {
+            case MVM_reg_int64: value.i64 = MVM_serialization_read_int(tc, reader); break;
+            case MVM_reg_num64: value.n64 = MVM_serialization_read_num(tc, reader); break;
+            case MVM_reg_str:   value.s   = MVM_serialization_read_str(tc, reader); break;
+            default:            value.o   = MVM_serialization_read_ref(tc, reader); break;
+        }
+        MVMIntHash_bind_int_key(tc, st, root, data, key, value, repr_data->value_kind);
+    }
+}
+
+/* Serialize the representation, in key order so the output doesn't depend
+ * on the hash secret. */
+static int cmp_keys(const void *a, const void *b) {
+    MVMint64 x = *(const MVMint64 *)a;
+    MVMint64 y = *(const MVMint64 *)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMint64           *keys      = MVM_malloc(sizeof(MVMint64) * (body->elems ? body->elems : 1));
+    MVMuint64           i         = 0;
+    MVMuint32           pos;
+    for (pos = 0; pos < body->alloc_slots; pos++)
+        if (body->states[pos] == MVM_INT_HASH_FULL)
+            keys[i++] = body->slots[pos].key;
+    qsort(keys, body->elems, sizeof(MVMint64), cmp_keys);
+    MVM_serialization_write_int(tc, writer, body->elems);
+    for (i = 0; i < body->elems; i++) {
+        MVMRegister *value = &(body->slots[find_slot(tc, body, keys[i], hash_key(tc, keys[i]))].value);
+        MVM_serialization_write_int(tc, writer, keys[i]);
+        switch (repr_data->value_kind) {
+            case MVM_reg_int64: MVM_serialization_write_int(tc, writer, value->i64); break;
+            case MVM_reg_num64: MVM_serialization_write_num(tc, writer, value->n64); break;
+            case MVM_reg_str:   MVM_serialization_write_str(tc, writer, value->s);   break;
+            default:            MVM_serialization_write_ref(tc, writer, value->o);   break;
+        }
+    }
+    MVM_free(keys);
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMIntHash);
+}
+
+/* Bytecode specialization for this REPR. Lookups by integer key are left
+ * to the JIT, which calls straight into the lookup once it knows the type. */
+static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    switch (ins->info->opcode) {
+    case MVM_OP_create: {
+        if (!(st->mode_flags & MVM_FINALIZE_TYPE)) {
+            MVMSpeshOperand target   = ins->operands[0];
+            MVMSpeshOperand type     = ins->operands[1];
+            MVMSpeshFacts *tgt_facts = MVM_spesh_get_facts(tc, g, target);
+
+            ins->info                = MVM_op_get_op(MVM_OP_sp_fastcreate);
+            ins->operands            = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+            ins->operands[0]         = target;
+            ins->operands[1].lit_i16 = sizeof(MVMIntHash);
+            ins->operands[2].lit_i16 = MVM_spesh_add_spesh_slot(tc, g, (MVMCollectable *)st);
+            MVM_spesh_usages_delete_by_reg(tc, g, type, ins);
+
+            tgt_facts->flags |= MVM_SPESH_FACT_KNOWN_TYPE | MVM_SPESH_FACT_CONCRETE;
+            tgt_facts->type = st->WHAT;
+        }
+        break;
+    }
+    case MVM_OP_elems: {
+        MVMSpeshOperand target = ins->operands[0];
+        MVMSpeshOperand obj    = ins->operands[1];
+
+        MVM_spesh_graph_add_comment(tc, g, ins, "specialized from elems on VMIntHash");
+
+        ins->info                = MVM_op_get_op(MVM_OP_sp_get_i64);
+        ins->operands            = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+        ins->operands[0]         = target;
+        ins->operands[1]         = obj;
+        ins->operands[2].lit_i16 = offsetof(MVMIntHash, body.elems);
+        break;
+    }
+    }
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMIntHashBody *body = (MVMIntHashBody *)data;
+    return body->alloc_slots * (sizeof(MVMIntHashSlot) + 1);
+}
+
+static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
+    MVMIntHashREPRData *repr_data = (MVMIntHashREPRData *)st->REPR_data;
+    MVMIntHashBody     *body      = (MVMIntHashBody *)data;
+    MVMuint32 i;
+    if (repr_data->value_kind != MVM_reg_obj && repr_data->value_kind != MVM_reg_str)
+        return;
+    for (i = 0; i < body->alloc_slots; i++)
+        if (body->states[i] == MVM_INT_HASH_FULL)
+            MVM_profile_heap_add_collectable_rel_idx(tc, ss,
+                (MVMCollectable *)body->slots[i].value.o, (MVMuint64)body->slots[i].key);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMIntHash_initialize(MVMThreadContext *tc) {
+    return &MVMIntHash_this_repr;
+}
+
+static const MVMREPROps MVMIntHash_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    {
+        at_key,
+        bind_key,
+        exists_key,
+        delete_key,
+        get_value_storage_spec
+    },    /* ass_funcs */
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    serialize,
+    deserialize,
+    serialize_repr_data,
+    deserialize_repr_data,
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    gc_mark_repr_data,
+    gc_free_repr_data,
+    compose,
+    spesh,
+    "VMIntHash", /* name */
+    MVM_REPR_ID_MVMIntHash,
+    unmanaged_size,
+    describe_refs,
+};
+
+/* Checks an object given to an integer key op is concrete. */
+MVM_STATIC_INLINE void check_concrete(MVMThreadContext *tc, MVMObject *obj, const char *op) {
+    if (MVM_UNLIKELY(!IS_CONCRETE(obj)))
+        MVM_exception_throw_adhoc(tc, "%s requires a concrete object (got a %s type object instead)",
+            op, MVM_6model_get_debug_name(tc, obj));
+}
+
+void MVM_int_hash_at_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key,
+        MVMRegister *result, MVMuint16 kind) {
+    if (!IS_CONCRETE(obj) && kind == MVM_reg_obj) {
+        result->o = tc->instance->VMNull;
+        return;
+    }
+    check_concrete(tc, obj, "atikey");
+    if (MVM_LIKELY(REPR(obj)->ID == MVM_REPR_ID_MVMIntHash)) {
+        MVMIntHash_at_int_key(tc, STABLE(obj), obj, OBJECT_BODY(obj), key, result, kind);
+    }
+    else {
+        MVMString *key_str;
+        MVMROOT(tc, obj, {
+            key_str = MVM_coerce_i_s(tc, key);
+        });
+        REPR(obj)->ass_funcs.at_key(tc, STABLE(obj), obj, OBJECT_BODY(obj),
+            (MVMObject *)key_str, result, kind);
+    }
+}
+
+void MVM_int_hash_bind_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key,
+        MVMRegister value, MVMuint16 kind) {
+    check_concrete(tc, obj, "bindikey");
+    if (MVM_LIKELY(REPR(obj)->ID == MVM_REPR_ID_MVMIntHash)) {
+        MVMIntHash_bind_int_key(tc, STABLE(obj), obj, OBJECT_BODY(obj), key, value, kind);
+    }
+    else {
+        MVMString *key_str;
+        if (kind == MVM_reg_obj || kind == MVM_reg_str) {
+            MVMROOT2(tc, obj, value.o, {
+                key_str = MVM_coerce_i_s(tc, key);
+            });
+        }
+        else {
+            MVMROOT(tc, obj, {
+                key_str = MVM_coerce_i_s(tc, key);
+            });
+        }
+        REPR(obj)->ass_funcs.bind_key(tc, STABLE(obj), obj, OBJECT_BODY(obj),
+            (MVMObject *)key_str, value, kind);
+    }
+}
+
+MVMint64 MVM_int_hash_exists_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key) {
+    check_concrete(tc, obj, "existsikey");
+    if (MVM_LIKELY(REPR(obj)->ID == MVM_REPR_ID_MVMIntHash)) {
+        return MVMIntHash_exists_int_key(tc, STABLE(obj), obj, OBJECT_BODY(obj), key);
+    }
+    else {
+        MVMString *key_str;
+        MVMROOT(tc, obj, {
+            key_str = MVM_coerce_i_s(tc, key);
+        });
+        return REPR(obj)->ass_funcs.exists_key(tc, STABLE(obj), obj, OBJECT_BODY(obj),
+            (MVMObject *)key_str);
+    }
+}
+
+void MVM_int_hash_delete_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key) {
+    check_concrete(tc, obj, "deleteikey");
+    if (MVM_LIKELY(REPR(obj)->ID == MVM_REPR_ID_MVMIntHash)) {
+        delete_int_key(tc, (MVMIntHashBody *)OBJECT_BODY(obj), key);
+    }
+    else {
+        MVMString *key_str;
+        MVMROOT(tc, obj, {
+            key_str = MVM_coerce_i_s(tc, key);
+        });
+        REPR(obj)->ass_funcs.delete_key(tc, STABLE(obj), obj, OBJECT_BODY(obj),
+            (MVMObject *)key_str);
+    }
+}
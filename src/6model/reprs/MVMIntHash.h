@@ -0,0 +1,75 @@
+/* Representation of a hash keyed by native integers, so that tables indexed
+ * by IDs need not turn each ID into a string to look it up.
+ *
+ * The keys and values are kept in the slots of an open addressing table,
+ * probed linearly from the slot the key's hash picks. Each slot has a state
+ * byte, kept after the slots in the same allocation; deleting a key leaves
+ * its slot marked as deleted, so iterators stay valid, and deleted slots are
+ * reused or dropped when the table is next rebuilt. The values are objects
+ * or, if the type is composed with a native value type, native ints, nums
+ * or strings. */
+
+/* The states a slot can be in. */
+#define MVM_INT_HASH_EMPTY   0
+#define MVM_INT_HASH_FULL    1
+#define MVM_INT_HASH_DELETED 2
+
+struct MVMIntHashSlot {
+    MVMint64    key;
+    MVMRegister value;
+};
+
+struct MVMIntHashBody {
+    /* The slots, followed by their states; NULL until the first key is
+     * bound. */
+    MVMIntHashSlot *slots;
+    MVMuint8       *states;
+
+    /* How many slots there are (a power of 2), and how many are not empty,
+     * counting deleted ones. */
+    MVMuint32 alloc_slots;
+    MVMuint32 used_slots;
+
+    /* How many keys the hash holds. */
+    MVMuint64 elems;
+};
+struct MVMIntHash {
+    MVMObject common;
+    MVMIntHashBody body;
+};
+
+/* The kind of value held, as an MVM_reg_* kind, and the value type it was
+ * composed with, if any. */
+struct MVMIntHashREPRData {
+    MVMuint16  value_kind;
+    MVMObject *value_type;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMIntHash_initialize(MVMThreadContext *tc);
+
+/* Finds the first slot that holds a key at or after the given position,
+ * returning its position, or alloc_slots if there are none. */
+MVM_STATIC_INLINE MVMuint32 MVM_int_hash_next_slot(MVMIntHashBody *body, MVMuint32 pos) {
+    while (pos < body->alloc_slots && body->states[pos] != MVM_INT_HASH_FULL)
+        pos++;
+    return pos < body->alloc_slots ? pos : body->alloc_slots;
+}
+
+/* Operations on a VMIntHash of known concreteness, used when spesh knows
+ * the type. */
+void MVMIntHash_at_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data,
+    MVMint64 key, MVMRegister *result, MVMuint16 kind);
+void MVMIntHash_bind_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data,
+    MVMint64 key, MVMRegister value, MVMuint16 kind);
+MVMint64 MVMIntHash_exists_int_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
+    void *data, MVMint64 key);
+
+/* Operations taking an integer key on any associative object; those other
+ * than a VMIntHash are given the key as a string. */
+void MVM_int_hash_at_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key,
+    MVMRegister *result, MVMuint16 kind);
+void MVM_int_hash_bind_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key,
+    MVMRegister value, MVMuint16 kind);
+MVMint64 MVM_int_hash_exists_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key);
+void MVM_int_hash_delete_key(MVMThreadContext *tc, MVMObject *obj, MVMint64 key);
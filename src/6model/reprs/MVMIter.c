@@ -104,15 +104,26 @@ static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *da
                 MVM_exception_throw_adhoc(tc, "Wrong register kind in iteration");
             }
             return;
-        case MVM_ITER_MODE_HASH:
-            body->hash_state.curr = body->hash_state.next;
-            if (!body->hash_state.curr)
+        case MVM_ITER_MODE_HASH: {
+            MVMHashBody *hash = &((MVMHash *)target)->body;
+            MVMuint32    pos  = MVM_hash_next_entry(hash, body->hash_state.next);
+            if (pos >= hash->num_entries)
                 MVM_exception_throw_adhoc(tc, "Iteration past end of iterator");
-            body->hash_state.next = HASH_ITER_NEXT_ITEM(tc,
-                &(body->hash_state.next->hash_handle),
-                &(body->hash_state.bucket_state));
+            body->hash_state.curr = pos;
+            body->hash_state.next = pos + 1;
             value->o = root;
             return;
+        }
+        case MVM_ITER_MODE_INT_HASH: {
+            MVMIntHashBody *hash = &((MVMIntHash *)target)->body;
+            MVMuint32       pos  = MVM_int_hash_next_slot(hash, body->hash_state.next);
+            if (pos >= hash->alloc_slots)
+                MVM_exception_throw_adhoc(tc, "Iteration past end of iterator");
+            body->hash_state.curr = pos;
+            body->hash_state.next = pos + 1;
+            value->o = root;
+            return;
+        }
         default:
             MVM_exception_throw_adhoc(tc, "Unknown iteration mode");
     }
@@ -219,13 +230,16 @@ MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target) {
             iterator = (MVMIter *)MVM_repr_alloc_init(tc,
                 MVM_hll_current(tc)->hash_iterator_type);
             iterator->body.mode = MVM_ITER_MODE_HASH;
-            iterator->body.hash_state.bucket_state = 0;
-            iterator->body.hash_state.curr         = NULL;
-            iterator->body.hash_state.next         = HASH_ITER_FIRST_ITEM(
-                ((MVMHash *)target)->body.hash_head
-                    ? ((MVMHash *)target)->body.hash_head->hash_handle.tbl
-                    : NULL,
-                &(iterator->body.hash_state.bucket_state));
+            iterator->body.hash_state.curr = -1;
+            iterator->body.hash_state.next = 0;
+            MVM_ASSIGN_REF(tc, &(iterator->common.header), iterator->body.target, target);
+        }
+        else if (REPR(target)->ID == MVM_REPR_ID_MVMIntHash) {
+            iterator = (MVMIter *)MVM_repr_alloc_init(tc,
+                MVM_hll_current(tc)->hash_iterator_type);
+            iterator->body.mode = MVM_ITER_MODE_INT_HASH;
+            iterator->body.hash_state.curr = -1;
+            iterator->body.hash_state.next = 0;
             MVM_ASSIGN_REF(tc, &(iterator->common.header), iterator->body.target, target);
         }
         else if (REPR(target)->ID == MVM_REPR_ID_MVMContext) {
@@ -233,6 +247,11 @@ MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target) {
             MVMObject *ctx_hash = MVM_context_lexicals_as_hash(tc, (MVMContext *)target);
             iterator = (MVMIter *)MVM_iter(tc, ctx_hash);
         }
+        else if (REPR(target)->ID == MVM_REPR_ID_ConcHash) {
+            /* Iterate a snapshot, so other threads can go on writing. */
+            MVMObject *snapshot = MVM_conc_hash_snapshot(tc, target);
+            iterator = (MVMIter *)MVM_iter(tc, snapshot);
+        }
         else {
             MVM_exception_throw_adhoc(tc, "Cannot iterate object with %s representation (%s)",
                 REPR(target)->name, MVM_6model_get_debug_name(tc, target));
@@ -249,21 +268,61 @@ MVMint64 MVM_iter_istrue(MVMThreadContext *tc, MVMIter *iter) {
         case MVM_ITER_MODE_ARRAY_STR:
             return iter->body.array_state.index + 1 < iter->body.array_state.limit ? 1 : 0;
             break;
-        case MVM_ITER_MODE_HASH:
-            return iter->body.hash_state.next != NULL ? 1 : 0;
+        case MVM_ITER_MODE_HASH: {
+            MVMHashBody *hash = &((MVMHash *)iter->body.target)->body;
+            iter->body.hash_state.next = MVM_hash_next_entry(hash, iter->body.hash_state.next);
+            return iter->body.hash_state.next < hash->num_entries ? 1 : 0;
             break;
+        }
+        case MVM_ITER_MODE_INT_HASH: {
+            MVMIntHashBody *hash = &((MVMIntHash *)iter->body.target)->body;
+            iter->body.hash_state.next = MVM_int_hash_next_slot(hash, iter->body.hash_state.next);
+            return iter->body.hash_state.next < hash->alloc_slots ? 1 : 0;
+            break;
+        }
         default:
             MVM_exception_throw_adhoc(tc, "Invalid iteration mode used");
     }
 }
 
+/* Gets the hash entry a hash iterator is at. */
+static MVMHashKV * current_hash_entry(MVMThreadContext *tc, MVMIter *iterator) {
+    MVMHashBody *hash = &((MVMHash *)iterator->body.target)->body;
+    MVMint64     curr = iterator->body.hash_state.curr;
+    if (curr < 0)
+        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
+    if (curr >= hash->num_entries || !hash->entries[curr].key)
+        MVM_exception_throw_adhoc(tc, "The current item of the hash iterator was deleted");
+    return &(hash->entries[curr]);
+}
+
+/* Gets the slot a VMIntHash iterator is at. */
+static MVMIntHashSlot * current_int_hash_slot(MVMThreadContext *tc, MVMIter *iterator) {
+    MVMIntHashBody *hash = &((MVMIntHash *)iterator->body.target)->body;
+    MVMint64        curr = iterator->body.hash_state.curr;
+    if (curr < 0)
+        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
+    if (curr >= hash->alloc_slots || hash->states[curr] != MVM_INT_HASH_FULL)
+        MVM_exception_throw_adhoc(tc, "The current item of the hash iterator was deleted");
+    return &(hash->slots[curr]);
+}
+
 MVMString * MVM_iterkey_s(MVMThreadContext *tc, MVMIter *iterator) {
-    if (REPR(iterator)->ID != MVM_REPR_ID_MVMIter
-            || iterator->body.mode != MVM_ITER_MODE_HASH)
+    if (REPR(iterator)->ID != MVM_REPR_ID_MVMIter || (iterator->body.mode != MVM_ITER_MODE_HASH
+            && iterator->body.mode != MVM_ITER_MODE_INT_HASH))
         MVM_exception_throw_adhoc(tc, "This is not a hash iterator, it's a %s (%s)", REPR(iterator)->name, MVM_6model_get_debug_name(tc, (MVMObject *)iterator));
-    if (!iterator->body.hash_state.curr)
-        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-    return MVM_HASH_KEY(iterator->body.hash_state.curr);
+    if (iterator->body.mode == MVM_ITER_MODE_INT_HASH)
+        return MVM_coerce_i_s(tc, current_int_hash_slot(tc, iterator)->key);
+    return current_hash_entry(tc, iterator)->key;
+}
+
+MVMint64 MVM_iterkey_i(MVMThreadContext *tc, MVMIter *iterator) {
+    if (REPR(iterator)->ID != MVM_REPR_ID_MVMIter || (iterator->body.mode != MVM_ITER_MODE_HASH
+            && iterator->body.mode != MVM_ITER_MODE_INT_HASH))
+        MVM_exception_throw_adhoc(tc, "This is not a hash iterator, it's a %s (%s)", REPR(iterator)->name, MVM_6model_get_debug_name(tc, (MVMObject *)iterator));
+    if (iterator->body.mode == MVM_ITER_MODE_HASH)
+        return MVM_coerce_s_i(tc, current_hash_entry(tc, iterator)->key);
+    return current_int_hash_slot(tc, iterator)->key;
 }
 
 MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
@@ -280,12 +339,27 @@ MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
         REPR(target)->pos_funcs.at_pos(tc, STABLE(target), target, OBJECT_BODY(target), body->array_state.index, &result, MVM_reg_obj);
     }
     else if (iterator->body.mode == MVM_ITER_MODE_HASH) {
-        if (!iterator->body.hash_state.curr)
-            MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-        result.o = iterator->body.hash_state.curr->value;
+        result.o = current_hash_entry(tc, iterator)->value;
         if (!result.o)
             result.o = tc->instance->VMNull;
     }
+    else if (iterator->body.mode == MVM_ITER_MODE_INT_HASH) {
+        MVMRegister value = current_int_hash_slot(tc, iterator)->value;
+        switch (((MVMIntHashREPRData *)STABLE(iterator->body.target)->REPR_data)->value_kind) {
+            case MVM_reg_int64:
+                result.o = MVM_repr_box_int(tc, MVM_hll_current(tc)->int_box_type, value.i64);
+                break;
+            case MVM_reg_num64:
+                result.o = MVM_repr_box_num(tc, MVM_hll_current(tc)->num_box_type, value.n64);
+                break;
+            case MVM_reg_str:
+                result.o = MVM_repr_box_str(tc, MVM_hll_current(tc)->str_box_type, value.s);
+                break;
+            default:
+                result.o = value.o ? value.o : tc->instance->VMNull;
+                break;
+        }
+    }
     else {
         MVM_exception_throw_adhoc(tc, "Unknown iterator mode in iterval");
     }
@@ -5,6 +5,7 @@
 #define MVM_ITER_MODE_ARRAY_NUM     2
 #define MVM_ITER_MODE_ARRAY_STR     3
 #define MVM_ITER_MODE_HASH          4
+#define MVM_ITER_MODE_INT_HASH      5
 
 struct MVMIterBody {
     /* whether hash or array */
@@ -16,8 +17,11 @@ struct MVMIterBody {
     /* next hash item to give or next array index */
     union {
         struct {
-            MVMHashEntry *curr, *next;
-            unsigned      bucket_state;
+            /* Positions in the hash's entries (or for a VMIntHash, its
+             * slots) of the current item (-1 if none yet), and of where to
+             * look for the next one. */
+            MVMint64  curr;
+            MVMuint32 next;
         } hash_state;
         struct {
             MVMint64 index;
@@ -36,4 +40,5 @@ const MVMREPROps * MVMIter_initialize(MVMThreadContext *tc);
 MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target);
 MVMint64 MVM_iter_istrue(MVMThreadContext *tc, MVMIter *iter);
 MVMString * MVM_iterkey_s(MVMThreadContext *tc, MVMIter *iterator);
+MVMint64 MVM_iterkey_i(MVMThreadContext *tc, MVMIter *iterator);
 MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator);
@@ -22,6 +22,14 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     MVM_exception_throw_adhoc(tc, "Cannot copy object with representation MultiCache");
 }
 
+/* Sizes of the hash of trees and the megamorphic hash, given their masks. */
+MVM_STATIC_INLINE size_t trees_size(MVMuint32 mask) {
+    return sizeof(MVMMultiCacheTrees) + mask * sizeof(MVMMultiCacheNode *);
+}
+MVM_STATIC_INLINE size_t mega_size(MVMuint32 mask) {
+    return sizeof(MVMMultiCacheMegaTable) + mask * sizeof(MVMMultiCacheMegaEntry);
+}
+
 /* Called by the VM to mark any GCable items. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMMultiCacheBody *mc = (MVMMultiCacheBody *)data;
@@ -30,16 +38,38 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
         MVM_gc_worklist_add(tc, worklist, &(mc->results[i]));
 }
 
+/* Value of cache_id in megamorphic hash entries that are not in use. */
+#define MVM_MULTICACHE_MEGA_EMPTY      0
+
+/* Notes that a megamorphic cache is gone. Its IDs are never handed out
+ * again, so its entries in the megamorphic hash can no longer be found, and
+ * they are left to be dropped all at once when the hash is next copied. */
+static void remove_megamorphic(MVMThreadContext *tc, MVMuint64 cache_id) {
+    uv_mutex_lock(&(tc->instance->mutex_multi_cache_add));
+    MVM_VECTOR_PUSH(tc->instance->multi_cache_megamorphic_dead, cache_id);
+    uv_mutex_unlock(&(tc->instance->mutex_multi_cache_add));
+}
+
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
-    MVMMultiCache *mc = (MVMMultiCache *)obj;
-    if (mc->body.node_hash_head)
-        MVM_fixed_size_free(tc, tc->instance->fsa, mc->body.cache_memory_size,
-            mc->body.node_hash_head);
-    if (mc->body.results)
+    MVMMultiCacheBody *cache = &((MVMMultiCache *)obj)->body;
+    if (cache->trees) {
+        MVMuint32 i;
+        for (i = 0; i <= cache->trees->mask; i++) {
+            MVMMultiCacheNode *tree = cache->trees->trees[i];
+            if (tree)
+                MVM_fixed_size_free(tc, tc->instance->fsa,
+                    tree[0].no_match * sizeof(MVMMultiCacheNode), tree);
+        }
+        MVM_fixed_size_free(tc, tc->instance->fsa, trees_size(cache->trees->mask),
+            cache->trees);
+    }
+    if (cache->results)
         MVM_fixed_size_free(tc, tc->instance->fsa,
-            mc->body.num_results * sizeof(MVMObject *),
-            mc->body.results);
+            cache->alloc_results * sizeof(MVMObject *),
+            cache->results);
+    if (cache->megamorphic_id)
+        remove_megamorphic(tc, cache->megamorphic_id);
 }
 
 static const MVMStorageSpec storage_spec = {
@@ -64,7 +94,15 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
 /* Calculates the non-GC-managed memory we hold on to. */
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMMultiCacheBody *body = (MVMMultiCacheBody *)data;
-    return body->num_results * sizeof(MVMObject *) + body->cache_memory_size;
+    MVMuint64 size = body->alloc_results * sizeof(MVMObject *);
+    if (body->trees) {
+        MVMuint32 i;
+        size += trees_size(body->trees->mask);
+        for (i = 0; i <= body->trees->mask; i++)
+            if (body->trees->trees[i])
+                size += body->trees->trees[i][0].no_match * sizeof(MVMMultiCacheNode);
+    }
+    return size;
 }
 
 /* Initializes the representation. */
@@ -108,19 +146,27 @@ static const MVMREPROps MVMMultiCache_this_repr = {
 #define MVM_MULTICACHE_ARG_RW_FILTER   (4 * MVM_INTERN_ARITY_LIMIT)
 #define MVM_MULTICACHE_TYPE_ID_FILTER  (0xFFFFFFFFFFFFFFFFULL ^ (MVM_TYPE_CACHE_ID_INCR - 1))
 
-/* Debug support dumps the tree after each addition. */
+
+/* Debug support dumps the trees after each addition. */
 #define MVM_MULTICACHE_DEBUG 0
 #if MVM_MULTICACHE_DEBUG
 static void dump_cache(MVMThreadContext *tc, MVMMultiCacheBody *cache) {
-    MVMint32 num_nodes = cache->cache_memory_size / sizeof(MVMMultiCacheNode);
-    MVMint32 i;
-    printf("Multi cache at %p (%d nodes, %d results)\n",
-        cache, num_nodes, cache->num_results);
-    for (i = 0; i < num_nodes; i++)
-        printf(" - %p -> (Y: %d, N: %d)\n",
-            cache->node_hash_head[i].action.cs,
-            cache->node_hash_head[i].match,
-            cache->node_hash_head[i].no_match);
+    MVMuint32 i;
+    MVMint32 j;
+    printf("Multi cache at %p (%d callsites, %d results%s)\n",
+        cache, cache->trees->used, cache->num_results,
+        cache->megamorphic_id ? ", megamorphic" : "");
+    for (i = 0; i <= cache->trees->mask; i++) {
+        MVMMultiCacheNode *tree = cache->trees->trees[i];
+        if (!tree)
+            continue;
+        printf(" Tree for callsite %p (%d nodes)\n", tree[0].action.cs, tree[0].no_match);
+        for (j = 1; j < tree[0].no_match; j++)
+            printf(" - %llx -> (Y: %d, N: %d)\n",
+                (unsigned long long)tree[j].action.arg_match,
+                tree[j].match,
+                tree[j].no_match);
+    }
     printf("\n");
 }
 #endif
@@ -133,61 +179,54 @@ static MVMint32 is_power_of_2(MVMint32 value) {
 }
 #endif
 
-/* Takes a pointer to a callsite and turns it into an index into the multi cache
- * keyed by callsite. We don't do anything too clever here: just shift away the
- * bits of the pointer we know will be zero, and the take the least significant
- * few bits of it. Hopefully the distribution of memory addresses over time will
- * be sufficient. */
-MVM_STATIC_INLINE size_t hash_callsite(MVMThreadContext *tc, MVMCallsite *cs) {
-    return ((size_t)cs >> 3) & MVM_MULTICACHE_HASH_FILTER;
+/* Takes a pointer to a callsite and turns it into a hash code for the hash of
+ * trees. We don't do anything too clever here: just shift away the bits of
+ * the pointer we know will be zero, leaving the caller to take the least
+ * significant few bits of it. Hopefully the distribution of memory addresses
+ * over time will be sufficient. */
+MVM_STATIC_INLINE MVMuint32 hash_callsite(MVMThreadContext *tc, MVMCallsite *cs) {
+    return (MVMuint32)((size_t)cs >> 3);
 }
 
-/* Adds an entry to the multi-dispatch cache. */
-MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMObject *capture, MVMObject *result) {
-    MVMMultiCacheBody *cache = NULL;
-    MVMCallsite       *cs    = NULL;
-    MVMArgProcContext *apc   = NULL;
-    MVMuint64          match_flags[2 * MVM_INTERN_ARITY_LIMIT];
-    size_t             match_arg_idx[MVM_INTERN_ARITY_LIMIT];
-    MVMuint32          flag, i, num_obj_args, have_head, have_tree,
-                       have_callsite, matched_args, unmatched_arg,
-                       tweak_node, insert_node;
-    size_t             new_size;
-    MVMMultiCacheNode *new_head    = NULL;
-    MVMObject        **new_results = NULL;
-
-    /* Allocate a cache if needed. */
-    if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache) {
-        MVMROOT2(tc, capture, result, {
-            cache_obj = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTMultiCache);
-        });
-    }
-    cache = &((MVMMultiCache *)cache_obj)->body;
+/* Finds the slot in a hash of trees that holds the tree for a callsite, or
+ * the empty slot it would go in. */
+MVM_STATIC_INLINE MVMuint32 tree_slot(MVMThreadContext *tc, MVMMultiCacheTrees *trees, MVMCallsite *cs) {
+    MVMuint32 i = hash_callsite(tc, cs) & trees->mask;
+    while (trees->trees[i] && trees->trees[i][0].action.cs != cs)
+        i = (i + 1) & trees->mask;
+    return i;
+}
 
-    /* Ensure we got a capture in to cache on; bail if not interned. */
-    if (REPR(capture)->ID == MVM_REPR_ID_MVMCallCapture) {
-        apc        = ((MVMCallCapture *)capture)->body.apc;
-        cs         = apc->callsite;
-        if (!cs->is_interned)
-            return cache_obj;
-    }
-    else {
-        MVM_exception_throw_adhoc(tc, "Multi cache addition requires an MVMCallCapture");
-    }
+/* Computes a hash code for an entry in the megamorphic hash. */
+MVM_STATIC_INLINE MVMuint64 hash_megamorphic(MVMuint64 cache_id, MVMCallsite *cs,
+        MVMuint64 *arg_match) {
+    MVMuint64 hash = (cache_id * 0x9E3779B97F4A7C15ULL) ^ ((MVMuint64)(uintptr_t)cs >> 3);
+    MVMuint32 i;
+    for (i = 0; i < MVM_INTERN_ARITY_LIMIT; i++)
+        hash = (hash ^ arg_match[i]) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
 
-    /* Calculate matcher flags for all the object arguments. */
-    num_obj_args = 0;
+/* Computes the argument matchers for the object arguments of a call, in the
+ * order the trees test them, setting the rest of the MVM_INTERN_ARITY_LIMIT
+ * entries to zero. Returns the number of object arguments, or -1 if one is a
+ * container that can't be fetched from without invoking, which makes the
+ * call impossible to cache. */
+static MVMint32 arg_matchers(MVMThreadContext *tc, MVMCallsite *cs, MVMRegister *args,
+        MVMuint64 *arg_match) {
+    MVMuint32 flag, i, num_obj_args = 0;
+    memset(arg_match, 0, MVM_INTERN_ARITY_LIMIT * sizeof(MVMuint64));
     for (i = 0, flag = 0; flag < cs->flag_count; i++, flag++) {
         if (cs->arg_flags[flag] & MVM_CALLSITE_ARG_NAMED)
             i++;
         if ((cs->arg_flags[flag] & MVM_CALLSITE_ARG_MASK) == MVM_CALLSITE_ARG_OBJ) {
-            MVMRegister  arg   = apc->args[i];
+            MVMRegister  arg   = args[i];
             MVMSTable   *st    = STABLE(arg.o);
             MVMuint32    is_rw = 0;
             if (st->container_spec && IS_CONCRETE(arg.o)) {
                 MVMContainerSpec const *contspec = st->container_spec;
                 if (!contspec->fetch_never_invokes)
-                    return cache_obj; /* Impossible to cache. */
+                    return -1;
                 if (REPR(arg.o)->ID != MVM_REPR_ID_NativeRef) {
                     is_rw = contspec->can_store(tc, arg.o);
                     contspec->fetch(tc, arg.o, &arg);
@@ -196,52 +235,228 @@ MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMO
                     is_rw = 1;
                 }
             }
-            match_flags[i] = STABLE(arg.o)->type_cache_id |
+            arg_match[num_obj_args++] = STABLE(arg.o)->type_cache_id |
                 (is_rw ? MVM_MULTICACHE_ARG_RW_FILTER : 0) |
-                (IS_CONCRETE(arg.o) ? MVM_MULTICACHE_ARG_CONC_FILTER : 0);
-            match_arg_idx[num_obj_args] = i;
-            num_obj_args++;
+                (IS_CONCRETE(arg.o) ? MVM_MULTICACHE_ARG_CONC_FILTER : 0) |
+                i;
         }
     }
+    return num_obj_args;
+}
 
-    /* Oobtain the cache addition lock, and then do another lookup to ensure
-     * nobody beat us to making this entry. */
-    uv_mutex_lock(&(tc->instance->mutex_multi_cache_add));
-    if (MVM_multi_cache_find(tc, cache_obj, capture))
-        goto DONE;
+/* Looks up an entry in the megamorphic hash, returning the index of its
+ * result, or 0 (the index of the NULL sentinel result) if there's none. */
+static MVMuint32 find_megamorphic(MVMThreadContext *tc, MVMuint64 cache_id, MVMCallsite *cs,
+        MVMuint64 *arg_match) {
+    MVMMultiCacheMegaTable *table = tc->instance->multi_cache_megamorphic;
+    MVMuint32 i;
+    if (!table)
+        return 0;
+    i = (MVMuint32)hash_megamorphic(cache_id, cs, arg_match) & table->mask;
+    while (1) {
+        MVMMultiCacheMegaEntry *entry = &(table->entries[i]);
+        MVMuint64 entry_id = entry->cache_id;
+        if (entry_id == MVM_MULTICACHE_MEGA_EMPTY)
+            return 0;
+        if (entry_id == cache_id && entry->cs == cs &&
+                memcmp(entry->arg_match, arg_match, sizeof(entry->arg_match)) == 0)
+            return entry->result;
+        i = (i + 1) & table->mask;
+    }
+}
 
-    /* We're now udner the insertion lock and know nobody else can tweak the
-     * cache. First, see if there's even a current version and search tree. */
-    have_head = 0;
-    have_tree = 0;
-    have_callsite = 0;
-    matched_args = 0;
-    unmatched_arg = 0;
-    tweak_node = hash_callsite(tc, cs);
-    if (cache->node_hash_head) {
-        MVMMultiCacheNode *tree = cache->node_hash_head;
-        MVMint32 cur_node = tweak_node;
-        have_head = 1;
-        if (tree[cur_node].action.cs)
-            have_tree = 1;
-
-        /* Now see if we already have this callsite. */
-        do {
-            if (tree[cur_node].action.cs == cs) {
-                have_callsite = 1;
-                cur_node = tree[cur_node].match;
-                break;
+/* Puts an entry in a megamorphic hash that nobody else is writing to. The
+ * entry's cache ID is written last, so readers never see it half done. */
+static void insert_megamorphic(MVMMultiCacheMegaTable *table, MVMuint64 cache_id,
+        MVMCallsite *cs, MVMuint64 *arg_match, MVMuint32 result) {
+    MVMuint32 i = (MVMuint32)hash_megamorphic(cache_id, cs, arg_match) & table->mask;
+    MVMMultiCacheMegaEntry *entry;
+    while (table->entries[i].cache_id != MVM_MULTICACHE_MEGA_EMPTY)
+        i = (i + 1) & table->mask;
+    entry = &(table->entries[i]);
+    entry->cs = cs;
+    memcpy(entry->arg_match, arg_match, sizeof(entry->arg_match));
+    entry->result = result;
+    MVM_barrier();
+    entry->cache_id = cache_id;
+    table->used++;
+}
+
+/* Compares megamorphic cache IDs, for sorting and searching the dead ones. */
+static int cmp_cache_ids(const void *a, const void *b) {
+    MVMuint64 id_a = *(const MVMuint64 *)a;
+    MVMuint64 id_b = *(const MVMuint64 *)b;
+    return id_a < id_b ? -1 : id_a > id_b ? 1 : 0;
+}
+
+/* Checks if an entry of the megamorphic hash is for a cache that is still
+ * alive, given the sorted IDs of the dead caches. */
+MVM_STATIC_INLINE MVMint32 is_live_megamorphic(MVMThreadContext *tc, MVMMultiCacheMegaEntry *entry) {
+    MVMInstance *instance = tc->instance;
+    return entry->cache_id != MVM_MULTICACHE_MEGA_EMPTY && (
+        !MVM_VECTOR_ELEMS(instance->multi_cache_megamorphic_dead) ||
+        !bsearch(&(entry->cache_id), instance->multi_cache_megamorphic_dead,
+            MVM_VECTOR_ELEMS(instance->multi_cache_megamorphic_dead),
+            sizeof(MVMuint64), cmp_cache_ids));
+}
+
+/* Adds an entry to the megamorphic hash, growing it first if needed. Must be
+ * called with the addition lock held. */
+static void add_megamorphic(MVMThreadContext *tc, MVMuint64 cache_id, MVMCallsite *cs,
+        MVMuint64 *arg_match, MVMuint32 result) {
+    MVMMultiCacheMegaTable *table = tc->instance->multi_cache_megamorphic;
+    if (!table || table->used + 1 > (table->mask + 1) / 4 * 3) {
+        /* Copy the live entries to a new hash, at least twice as big as they
+         * need, dropping those of dead caches, and then schedule the old one
+         * for freeing. */
+        MVMMultiCacheMegaTable *new_table;
+        MVMuint32 live = 0, mask = 63, i;
+        qsort(tc->instance->multi_cache_megamorphic_dead,
+            MVM_VECTOR_ELEMS(tc->instance->multi_cache_megamorphic_dead),
+            sizeof(MVMuint64), cmp_cache_ids);
+        if (table)
+            for (i = 0; i <= table->mask; i++)
+                if (is_live_megamorphic(tc, &(table->entries[i])))
+                    live++;
+        while ((mask + 1) / 2 <= live + 1)
+            mask = mask * 2 + 1;
+        new_table = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa, mega_size(mask));
+        new_table->mask = mask;
+        if (table) {
+            for (i = 0; i <= table->mask; i++) {
+                MVMMultiCacheMegaEntry *entry = &(table->entries[i]);
+                if (is_live_megamorphic(tc, entry))
+                    insert_megamorphic(new_table, entry->cache_id, entry->cs,
+                        entry->arg_match, entry->result);
             }
-            tweak_node = cur_node;
-            cur_node = tree[cur_node].no_match;
-        } while (cur_node > 0);
+            MVM_barrier();
+            tc->instance->multi_cache_megamorphic = new_table;
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                mega_size(table->mask), table);
+        }
+        else {
+            MVM_barrier();
+            tc->instance->multi_cache_megamorphic = new_table;
+        }
+        MVM_VECTOR_CLEAR(tc->instance->multi_cache_megamorphic_dead);
+        table = new_table;
+    }
+    insert_megamorphic(table, cache_id, cs, arg_match, result);
+}
+
+/* Adds the entries along all paths through a tree, from the given node down,
+ * to the megamorphic hash. */
+static void add_tree_paths(MVMThreadContext *tc, MVMuint64 cache_id, MVMMultiCacheNode *tree,
+        MVMint32 node, MVMuint64 *arg_match, MVMuint32 depth) {
+    if (node < 0) {
+        add_megamorphic(tc, cache_id, tree[0].action.cs, arg_match, -node);
+        return;
+    }
+    if (node == 0)
+        return;
+    while (node > 0) {
+        arg_match[depth] = tree[node].action.arg_match;
+        add_tree_paths(tc, cache_id, tree, tree[node].match, arg_match, depth + 1);
+        node = tree[node].no_match;
+    }
+    arg_match[depth] = 0;
+}
 
-        /* Chase until we reach an arg we don't match. */
+/* Makes a cache megamorphic, moving its entries to the megamorphic hash. Its
+ * trees are left alone, since readers may be using them, but are no longer
+ * looked at once the cache's megamorphic ID is set. Must be called with the
+ * addition lock held. */
+static void make_megamorphic(MVMThreadContext *tc, MVMMultiCacheBody *cache) {
+    MVMuint64 cache_id = ++tc->instance->multi_cache_megamorphic_id;
+    MVMuint64 arg_match[MVM_INTERN_ARITY_LIMIT];
+    MVMuint32 i;
+    memset(arg_match, 0, sizeof(arg_match));
+    for (i = 0; i <= cache->trees->mask; i++) {
+        MVMMultiCacheNode *tree = cache->trees->trees[i];
+        if (tree)
+            add_tree_paths(tc, cache_id, tree, tree[0].match, arg_match, 0);
+    }
+    MVM_barrier();
+    cache->megamorphic_id = cache_id;
+}
+
+/* Adds a result to a cache's results, growing them if needed, and returns its
+ * index. Must be called with the addition lock held. */
+static MVMuint32 add_result(MVMThreadContext *tc, MVMObject *cache_obj, MVMObject *result) {
+    MVMMultiCacheBody *cache = &((MVMMultiCache *)cache_obj)->body;
+    if (cache->num_results == cache->alloc_results) {
+        MVMuint32   new_alloc   = cache->alloc_results ? cache->alloc_results * 2 : 4;
+        MVMObject **new_results = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+            new_alloc * sizeof(MVMObject *));
+        if (cache->num_results) {
+            memcpy(new_results, cache->results, cache->num_results * sizeof(MVMObject *));
+            MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                cache->alloc_results * sizeof(MVMObject *), cache->results);
+        }
+        else {
+            new_results[0] = NULL; /* Sentinel */
+            cache->num_results = 1;
+        }
+        MVM_barrier();
+        cache->results = new_results;
+        cache->alloc_results = new_alloc;
+    }
+    MVM_ASSIGN_REF(tc, &(cache_obj->header), cache->results[cache->num_results], result);
+    return cache->num_results++;
+}
+
+/* Makes the hash of trees of a cache bigger (or creates it), and schedules
+ * the old one for freeing; the trees themselves are shared. Must be called
+ * with the addition lock held. */
+static MVMMultiCacheTrees * grow_trees(MVMThreadContext *tc, MVMMultiCacheBody *cache) {
+    MVMMultiCacheTrees *old   = cache->trees;
+    MVMuint32           mask  = old ? old->mask * 2 + 1 : MVM_MULTICACHE_HASH_SIZE - 1;
+    MVMMultiCacheTrees *trees = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        trees_size(mask));
+    trees->mask = mask;
+    if (old) {
+        MVMuint32 i;
+        for (i = 0; i <= old->mask; i++) {
+            MVMMultiCacheNode *tree = old->trees[i];
+            if (tree) {
+                trees->trees[tree_slot(tc, trees, tree[0].action.cs)] = tree;
+                trees->used++;
+            }
+        }
+    }
+    MVM_barrier();
+    cache->trees = trees;
+    if (old)
+        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, trees_size(old->mask), old);
+    return trees;
+}
+
+/* Adds an entry to the tree for its callsite, copying only that tree. Must be
+ * called with the addition lock held, and the result already added. */
+static void add_to_tree(MVMThreadContext *tc, MVMMultiCacheBody *cache, MVMCallsite *cs,
+        MVMuint64 *arg_match, MVMuint32 num_obj_args, MVMuint32 result_idx) {
+    MVMMultiCacheTrees *trees = cache->trees;
+    MVMMultiCacheNode  *tree  = NULL;
+    MVMMultiCacheNode  *new_tree;
+    MVMuint32           slot  = 0;
+    MVMuint32           num_nodes, new_num_nodes, i, matched_args, unmatched_arg,
+                        tweak_node, insert_node;
+
+    /* See if we already have a tree for this callsite. */
+    if (trees) {
+        slot = tree_slot(tc, trees, cs);
+        tree = trees->trees[slot];
+    }
+
+    /* Chase until we reach an arg we don't match. */
+    matched_args = 0;
+    unmatched_arg = 0;
+    tweak_node = 0;
+    if (tree) {
+        MVMint32 cur_node = tree[0].match;
         while (cur_node > 0) {
-            MVMuint64 arg_match = tree[cur_node].action.arg_match;
-            MVMuint64 arg_idx   = arg_match & MVM_MULTICACHE_ARG_IDX_FILTER;
             tweak_node = cur_node;
-            if ((match_flags[arg_idx] | arg_idx) == arg_match) {
+            if (tree[cur_node].action.arg_match == arg_match[matched_args]) {
                 matched_args++;
                 unmatched_arg = 0;
                 cur_node = tree[cur_node].match;
@@ -253,96 +468,180 @@ MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMO
         }
 
         /* If we found a candidate, something inconsistent, as we
-         * checked for non-entry above. */
+         * checked for non-entry before adding. */
         if (cur_node != 0)
-            MVM_panic(1, "Corrupt multi dispatch cache: cur_node != 0, re-check == %p",
-                MVM_multi_cache_find(tc, cache_obj, capture));
-    }
-
-    /* Now calculate the new size we'll need to allocate. */
-    new_size = cache->cache_memory_size;
-    if (!have_head)
-        new_size += MVM_MULTICACHE_HASH_SIZE * sizeof(MVMMultiCacheNode);
-    else if (!have_callsite)
-        new_size += sizeof(MVMMultiCacheNode);
-    new_size += (num_obj_args - matched_args) * sizeof(MVMMultiCacheNode);
-
-    /* Allocate and copy existing cache. */
-    new_head = MVM_fixed_size_alloc(tc, tc->instance->fsa, new_size);
-    memcpy(new_head, cache->node_hash_head, cache->cache_memory_size);
-
-    /* If we had no head, set it up. */
-    if (!have_head)
-        memset(new_head, 0, MVM_MULTICACHE_HASH_SIZE * sizeof(MVMMultiCacheNode));
-
-    /* Calculate storage location of new nodes. */
-    insert_node = have_head
-        ? cache->cache_memory_size / sizeof(MVMMultiCacheNode)
-        : MVM_MULTICACHE_HASH_SIZE;
-
-    /* If we had no callsite, add a node for it. */
-    if (!have_callsite) {
-        if (!have_tree) {
-            /* We'll put it in the tree root. */
-            new_head[tweak_node].action.cs = cs;
-        }
-        else {
-            /* We'll insert a new node and chain it from the tweak node. */
-            new_head[insert_node].action.cs = cs;
-            new_head[insert_node].no_match = 0;
-            new_head[tweak_node].no_match = insert_node;
-            tweak_node = insert_node;
-            insert_node++;
-        }
+            MVM_panic(1, "Corrupt multi dispatch cache: cur_node != 0");
+    }
+
+    /* Allocate and copy the existing tree, or set up a new one. */
+    num_nodes = tree ? tree[0].no_match : 1;
+    new_num_nodes = num_nodes + (num_obj_args - matched_args);
+    new_tree = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+        new_num_nodes * sizeof(MVMMultiCacheNode));
+    if (tree) {
+        memcpy(new_tree, tree, num_nodes * sizeof(MVMMultiCacheNode));
+    }
+    else {
+        new_tree[0].action.cs = cs;
+        new_tree[0].match = 0;
     }
+    new_tree[0].no_match = new_num_nodes;
 
     /* Now insert any needed arg matchers. */
+    insert_node = num_nodes;
     for (i = matched_args; i < num_obj_args; i++) {
-        MVMuint32 arg_idx = match_arg_idx[i];
-        new_head[insert_node].action.arg_match = match_flags[arg_idx] | arg_idx;
-        new_head[insert_node].no_match = 0;
+        new_tree[insert_node].action.arg_match = arg_match[i];
+        new_tree[insert_node].match = 0;
+        new_tree[insert_node].no_match = 0;
         if (unmatched_arg) {
-            new_head[tweak_node].no_match = insert_node;
+            new_tree[tweak_node].no_match = insert_node;
             unmatched_arg = 0;
         }
         else {
-            new_head[tweak_node].match = insert_node;
+            new_tree[tweak_node].match = insert_node;
         }
         tweak_node = insert_node;
         insert_node++;
     }
 
-    /* Make a copy of the results, or allocate new (first result is NULL
-     * always) and insert the new result. Schedule old results for freeing. */
-    if (cache->num_results) {
-        new_results = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            (cache->num_results + 1) * sizeof(MVMObject *));
-        memcpy(new_results, cache->results, cache->num_results * sizeof(MVMObject *));
-        MVM_ASSIGN_REF(tc, &(cache_obj->header), new_results[cache->num_results], result);
+    /* Associate final node with result index. */
+    new_tree[tweak_node].match = -(MVMint32)result_idx;
+    MVM_barrier();
+
+    /* Put the new tree in place, growing the hash of trees if it's a new
+     * callsite and the hash is getting full. */
+    if (tree) {
+        trees->trees[slot] = new_tree;
         MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
-            cache->num_results * sizeof(MVMObject *), cache->results);
-        cache->results = new_results;
-        cache->num_results++;
+            num_nodes * sizeof(MVMMultiCacheNode), tree);
     }
     else {
-        new_results = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            2 * sizeof(MVMObject *));
-        new_results[0] = NULL; /* Sentinel */
-        MVM_ASSIGN_REF(tc, &(cache_obj->header), new_results[1], result);
-        cache->results = new_results;
-        cache->num_results = 2;
+        if (!trees || trees->used + 1 > (trees->mask + 1) / 4 * 3)
+            trees = grow_trees(tc, cache);
+        trees->trees[tree_slot(tc, trees, cs)] = new_tree;
+        trees->used++;
     }
-    MVM_barrier();
+}
 
-    /* Associate final node with result index. */
-    new_head[tweak_node].match = -(cache->num_results - 1);
+/* Does a lookup in a cache, without counting it as a hit or miss. */
+static MVMObject * find_in_cache(MVMThreadContext *tc, MVMMultiCacheBody *cache,
+        MVMCallsite *cs, MVMRegister *args) {
+    MVMMultiCacheTrees *trees;
+    MVMMultiCacheNode  *tree;
+    MVMint32 cur_node;
 
-    /* Update the rest. */
-    if (cache->node_hash_head)
-        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
-            cache->cache_memory_size, cache->node_hash_head);
-    cache->node_hash_head = new_head;
-    cache->cache_memory_size = new_size;
+    /* Megamorphic caches look up all the arguments in one go. */
+    if (cache->megamorphic_id) {
+        MVMuint64 arg_match[MVM_INTERN_ARITY_LIMIT];
+        MVMuint32 result;
+        if (arg_matchers(tc, cs, args, arg_match) < 0)
+            return NULL;
+        result = find_megamorphic(tc, cache->megamorphic_id, cs, arg_match);
+        return result ? cache->results[result] : NULL;
+    }
+
+    /* Otherwise, find the tree for the callsite. */
+    trees = cache->trees;
+    if (!trees)
+        return NULL;
+    tree = trees->trees[tree_slot(tc, trees, cs)];
+    if (!tree)
+        return NULL;
+
+    /* Now walk until we match argument type/concreteness/rw. */
+    cur_node = tree[0].match;
+    while (cur_node > 0) {
+        MVMuint64    arg_match = tree[cur_node].action.arg_match;
+        MVMuint64    arg_idx   = arg_match & MVM_MULTICACHE_ARG_IDX_FILTER;
+        MVMuint64    type_id   = arg_match & MVM_MULTICACHE_TYPE_ID_FILTER;
+        MVMRegister  arg       = args[arg_idx];
+        MVMSTable   *st        = STABLE(arg.o);
+        MVMuint64    is_rw     = 0;
+        if (st->container_spec && IS_CONCRETE(arg.o)) {
+            MVMContainerSpec const *contspec = st->container_spec;
+            if (!contspec->fetch_never_invokes)
+                return NULL;
+            if (REPR(arg.o)->ID != MVM_REPR_ID_NativeRef) {
+                is_rw = contspec->can_store(tc, arg.o);
+                contspec->fetch(tc, arg.o, &arg);
+            }
+            else {
+                is_rw = 1;
+            }
+        }
+        if (STABLE(arg.o)->type_cache_id == type_id) {
+            MVMuint32 need_concrete = (arg_match & MVM_MULTICACHE_ARG_CONC_FILTER) ? 1 : 0;
+            if (IS_CONCRETE(arg.o) == need_concrete) {
+                MVMuint32 need_rw = (arg_match & MVM_MULTICACHE_ARG_RW_FILTER) ? 1 : 0;
+                if (need_rw == is_rw) {
+                    cur_node = tree[cur_node].match;
+                    continue;
+                }
+            }
+        }
+        cur_node = tree[cur_node].no_match;
+    }
+
+    /* Negate result and index into results (the first result is always NULL
+     * to save flow control around "no match"). */
+    return cache->results[-cur_node];
+}
+
+/* Adds an entry to the multi-dispatch cache. */
+MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMObject *capture, MVMObject *result) {
+    MVMMultiCacheBody *cache = NULL;
+    MVMCallsite       *cs    = NULL;
+    MVMArgProcContext *apc   = NULL;
+    MVMuint64          arg_match[MVM_INTERN_ARITY_LIMIT];
+    MVMint32           num_obj_args;
+    MVMuint32          result_idx;
+
+    /* Allocate a cache if needed. */
+    if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache) {
+        MVMROOT2(tc, capture, result, {
+            cache_obj = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTMultiCache);
+        });
+    }
+    cache = &((MVMMultiCache *)cache_obj)->body;
+
+    /* Ensure we got a capture in to cache on; bail if not interned. */
+    if (REPR(capture)->ID == MVM_REPR_ID_MVMCallCapture) {
+        apc        = ((MVMCallCapture *)capture)->body.apc;
+        cs         = apc->callsite;
+        if (!cs->is_interned)
+            return cache_obj;
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "Multi cache addition requires an MVMCallCapture");
+    }
+
+    /* Calculate matchers for all the object arguments. */
+    num_obj_args = arg_matchers(tc, cs, apc->args, arg_match);
+    if (num_obj_args < 0)
+        return cache_obj; /* Impossible to cache. */
+
+    /* Oobtain the cache addition lock, and then do another lookup to ensure
+     * nobody beat us to making this entry. */
+    uv_mutex_lock(&(tc->instance->mutex_multi_cache_add));
+    if (find_in_cache(tc, cache, cs, apc->args))
+        goto DONE;
+
+    /* We're now udner the insertion lock and know nobody else can tweak the
+     * cache. Add the result, making sure it's visible before the entry that
+     * leads to it. */
+    result_idx = add_result(tc, cache_obj, result);
+    MVM_barrier();
+
+    /* Add the entry to the tree for its callsite, or to the megamorphic hash,
+     * and make the cache megamorphic if it has got big enough. */
+    if (cache->megamorphic_id) {
+        add_megamorphic(tc, cache->megamorphic_id, cs, arg_match, result_idx);
+    }
+    else {
+        add_to_tree(tc, cache, cs, arg_match, num_obj_args, result_idx);
+        if (cache->num_results - 1 >= MVM_MULTICACHE_MEGAMORPHIC_LIMIT)
+            make_megamorphic(tc, cache);
+    }
 
 #if MVM_MULTICACHE_DEBUG
     printf("Made new entry for callsite with %d object arguments\n", num_obj_args);
@@ -381,8 +680,7 @@ MVMObject * MVM_multi_cache_find(MVMThreadContext *tc, MVMObject *cache_obj, MVM
 MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *cache_obj,
     MVMCallsite *cs, MVMRegister *args) {
     MVMMultiCacheBody *cache = NULL;
-    MVMMultiCacheNode *tree  = NULL;
-    MVMint32 cur_node;
+    MVMObject         *result;
 
     /* Bail if callsite not interned. */
     if (!cs->is_interned)
@@ -392,183 +690,176 @@ MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *
     if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache)
         return NULL;
     cache = &((MVMMultiCache *)cache_obj)->body;
-    if (!cache->node_hash_head)
-        return NULL;
 
-    /* Use hashed callsite to find the node to start with. */
-    cur_node = hash_callsite(tc, cs);
+    /* Look it up, keeping count of how it went if asked to. */
+    result = find_in_cache(tc, cache, cs, args);
+    if (tc->instance->multi_cache_stats)
+        MVM_incr(result ? &(cache->hits) : &(cache->misses));
+    return result;
+}
 
-    /* Walk tree until we match callsite. */
-    tree = cache->node_hash_head;
-    do {
-        if (tree[cur_node].action.cs == cs) {
-            cur_node = tree[cur_node].match;
-            break;
+/* Works out the argument matcher for an argument from spesh arg facts, or
+ * from a type tuple if there is one. Returns 1 if it was worked out, 0 if
+ * the type tuple has no type for the argument, so it can't match anything,
+ * or -1 if too little is known about it to resolve the dispatch. */
+static MVMint32 spesh_arg_matcher(MVMThreadContext *tc, MVMSpeshCallInfo *arg_info,
+        MVMSpeshStatsType *type_tuple, MVMuint64 arg_idx, MVMuint64 *arg_match) {
+    MVMSTable *known_type_st = NULL;
+    MVMuint32  is_conc;
+    MVMuint32  is_rw;
+    if (type_tuple) {
+        MVMuint16 num_pos = arg_info->cs->num_pos;
+        MVMuint64 tt_offset = arg_idx >= num_pos
+            ? ((arg_idx - 1) - num_pos) / 2 + num_pos
+            : arg_idx;
+        is_rw = type_tuple[tt_offset].rw_cont;
+        if (type_tuple[tt_offset].decont_type) {
+            known_type_st = type_tuple[tt_offset].decont_type->st;
+            is_conc = type_tuple[tt_offset].decont_type_concrete;
         }
-        cur_node = tree[cur_node].no_match;
-    } while (cur_node > 0);
-
-    /* Now walk until we match argument type/concreteness/rw. */
-    while (cur_node > 0) {
-        MVMuint64    arg_match = tree[cur_node].action.arg_match;
-        MVMuint64    arg_idx   = arg_match & MVM_MULTICACHE_ARG_IDX_FILTER;
-        MVMuint64    type_id   = arg_match & MVM_MULTICACHE_TYPE_ID_FILTER;
-        MVMRegister  arg       = args[arg_idx];
-        MVMSTable   *st        = STABLE(arg.o);
-        MVMuint64    is_rw     = 0;
-        if (st->container_spec && IS_CONCRETE(arg.o)) {
-            MVMContainerSpec const *contspec = st->container_spec;
-            if (!contspec->fetch_never_invokes)
-                return NULL;
-            if (REPR(arg.o)->ID != MVM_REPR_ID_NativeRef) {
-                is_rw = contspec->can_store(tc, arg.o);
-                contspec->fetch(tc, arg.o, &arg);
-            }
-            else {
-                is_rw = 1;
-            }
+        else if (type_tuple[tt_offset].type) { /* FIXME: tuples with neither decont_type nor type shouldn't appear */
+            known_type_st = type_tuple[tt_offset].type->st;
+            is_conc = type_tuple[tt_offset].type_concrete;
         }
-        if (STABLE(arg.o)->type_cache_id == type_id) {
-            MVMuint32 need_concrete = (arg_match & MVM_MULTICACHE_ARG_CONC_FILTER) ? 1 : 0;
-            if (IS_CONCRETE(arg.o) == need_concrete) {
-                MVMuint32 need_rw = (arg_match & MVM_MULTICACHE_ARG_RW_FILTER) ? 1 : 0;
-                if (need_rw == is_rw) {
-                    cur_node = tree[cur_node].match;
-                    continue;
-                }
-            }
+        else {
+            return 0;
         }
-        cur_node = tree[cur_node].no_match;
     }
+    else {
+        /* Figure out type, concreteness, and rw-ness from facts. */
+        MVMSpeshFacts *facts = arg_idx < MAX_ARGS_FOR_OPT
+            ? arg_info->arg_facts[arg_idx]
+            : NULL;
 
-    /* Negate result and index into results (the first result is always NULL
-     * to save flow control around "no match"). */
-    return cache->results[-cur_node];
+        /* No facts about this argument available from analysis, so can't
+         * resolve the dispatch. */
+        if (!facts)
+            return -1;
+
+        /* Must know type. */
+        if (!(facts->flags & MVM_SPESH_FACT_KNOWN_TYPE))
+            return -1;
+
+        /* Must know if it's concrete or not. */
+        if (!(facts->flags & (MVM_SPESH_FACT_CONCRETE | MVM_SPESH_FACT_TYPEOBJ)))
+            return -1;
+
+        /* If it's a container, must know what's inside it. Otherwise,
+         * we're already good on type info. */
+        if ((facts->flags & MVM_SPESH_FACT_CONCRETE) && STABLE(facts->type)->container_spec) {
+            /* Again, need to know type and concreteness. */
+            if (!(facts->flags & MVM_SPESH_FACT_KNOWN_DECONT_TYPE))
+                return -1;
+            if (!(facts->flags & (MVM_SPESH_FACT_DECONT_CONCRETE | MVM_SPESH_FACT_DECONT_TYPEOBJ)))
+                return -1;
+            known_type_st = STABLE(facts->decont_type);
+            is_conc = (facts->flags & MVM_SPESH_FACT_DECONT_CONCRETE) ? 1 : 0;
+            is_rw = (facts->flags & MVM_SPESH_FACT_RW_CONT) ? 1 : 0;
+        }
+        else {
+            known_type_st = STABLE(facts->type);
+            is_conc = (facts->flags & MVM_SPESH_FACT_CONCRETE) ? 1 : 0;
+            is_rw = is_conc && REPR(facts->type)->ID == MVM_REPR_ID_NativeRef;
+        }
+    }
+    *arg_match = known_type_st->type_cache_id |
+        (is_rw ? MVM_MULTICACHE_ARG_RW_FILTER : 0) |
+        (is_conc ? MVM_MULTICACHE_ARG_CONC_FILTER : 0) |
+        arg_idx;
+    return 1;
 }
 
 /* Do a multi cache lookup based upon spesh arg facts. */
 MVMObject * MVM_multi_cache_find_spesh(MVMThreadContext *tc, MVMObject *cache_obj,
                                        MVMSpeshCallInfo *arg_info,
                                        MVMSpeshStatsType *type_tuple) {
-    MVMMultiCacheBody *cache = NULL;
-    MVMMultiCacheNode *tree  = NULL;
+    MVMMultiCacheBody  *cache = NULL;
+    MVMMultiCacheTrees *trees = NULL;
+    MVMMultiCacheNode  *tree  = NULL;
+    MVMCallsite        *cs    = arg_info->cs;
     MVMint32 cur_node;
 
     /* Bail if callsite not interned. */
-    if (!arg_info->cs->is_interned)
+    if (!cs->is_interned)
         return NULL;
 
     /* If no cache, no result. */
     if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache)
         return NULL;
     cache = &((MVMMultiCache *)cache_obj)->body;
-    if (!cache->node_hash_head)
-        return NULL;
-
-    /* Use hashed callsite to find the node to start with. */
-    cur_node = hash_callsite(tc, arg_info->cs);
 
-    /* Walk tree until we match callsite. */
-    tree = cache->node_hash_head;
-    do {
-        if (tree[cur_node].action.cs == arg_info->cs) {
-            cur_node = tree[cur_node].match;
-            break;
+    /* Megamorphic caches look up the matchers of all the object arguments,
+     * made the same way as for a call, in one go. */
+    if (cache->megamorphic_id) {
+        MVMuint64 arg_match[MVM_INTERN_ARITY_LIMIT];
+        MVMuint32 flag, i, num_obj_args = 0, result;
+        memset(arg_match, 0, sizeof(arg_match));
+        for (i = 0, flag = 0; flag < cs->flag_count; i++, flag++) {
+            if (cs->arg_flags[flag] & MVM_CALLSITE_ARG_NAMED)
+                i++;
+            if ((cs->arg_flags[flag] & MVM_CALLSITE_ARG_MASK) == MVM_CALLSITE_ARG_OBJ)
+                if (spesh_arg_matcher(tc, arg_info, type_tuple, i, &(arg_match[num_obj_args++])) <= 0)
+                    return NULL;
         }
-        cur_node = tree[cur_node].no_match;
-    } while (cur_node > 0);
+        result = find_megamorphic(tc, cache->megamorphic_id, cs, arg_match);
+        return result ? cache->results[result] : NULL;
+    }
+
+    /* Otherwise, find the tree for the callsite. */
+    trees = cache->trees;
+    if (!trees)
+        return NULL;
+    tree = trees->trees[tree_slot(tc, trees, cs)];
+    if (!tree)
+        return NULL;
+    cur_node = tree[0].match;
 
     /* Now walk until we match argument type/concreteness/rw. */
     while (cur_node > 0) {
-        MVMuint64      arg_match = tree[cur_node].action.arg_match;
-        MVMuint64      arg_idx   = arg_match & MVM_MULTICACHE_ARG_IDX_FILTER;
-        MVMuint64      type_id   = arg_match & MVM_MULTICACHE_TYPE_ID_FILTER;
-        MVMSpeshFacts *facts     = arg_idx < MAX_ARGS_FOR_OPT
-            ? arg_info->arg_facts[arg_idx]
-            : NULL;
-        if (type_tuple) {
-            MVMuint16 num_pos = arg_info->cs->num_pos;
-            MVMuint64 tt_offset = arg_idx >= num_pos
-                ? ((arg_idx - 1) - num_pos) / 2 + num_pos
-                : arg_idx;
-            MVMuint32 is_rw = type_tuple[tt_offset].rw_cont;
-            MVMSTable *known_type_st = NULL;
-            MVMuint32 is_conc;
-            if (type_tuple[tt_offset].decont_type) {
-                known_type_st = type_tuple[tt_offset].decont_type->st;
-                is_conc = type_tuple[tt_offset].decont_type_concrete;
-            }
-            else if (type_tuple[tt_offset].type) { /* FIXME: tuples with neither decont_type nor type shouldn't appear */
-                known_type_st = type_tuple[tt_offset].type->st;
-                is_conc = type_tuple[tt_offset].type_concrete;
-            }
-
-            /* Now check if what we have matches what we need. */
-            if (known_type_st && known_type_st->type_cache_id == type_id) {
-                MVMuint32 need_concrete = (arg_match & MVM_MULTICACHE_ARG_CONC_FILTER) ? 1 : 0;
-                if (is_conc == need_concrete) {
-                    MVMuint32 need_rw = (arg_match & MVM_MULTICACHE_ARG_RW_FILTER) ? 1 : 0;
-                    if (need_rw == is_rw) {
-                        cur_node = tree[cur_node].match;
-                        continue;
-                    }
-                }
-            }
-            cur_node = tree[cur_node].no_match;
-        }
-        else if (facts) {
-            /* Figure out type, concreteness, and rw-ness from facts. */
-            MVMSTable *known_type_st = NULL;
-            MVMuint32  is_conc;
-            MVMuint32  is_rw;
-
-            /* Must know type. */
-            if (!(facts->flags & MVM_SPESH_FACT_KNOWN_TYPE))
-                return NULL;
-
-            /* Must know if it's concrete or not. */
-            if (!(facts->flags & (MVM_SPESH_FACT_CONCRETE | MVM_SPESH_FACT_TYPEOBJ)))
-                return NULL;
-
-            /* If it's a container, must know what's inside it. Otherwise,
-             * we're already good on type info. */
-            if ((facts->flags & MVM_SPESH_FACT_CONCRETE) && STABLE(facts->type)->container_spec) {
-                /* Again, need to know type and concreteness. */
-                if (!(facts->flags & MVM_SPESH_FACT_KNOWN_DECONT_TYPE))
-                    return NULL;
-                if (!(facts->flags & (MVM_SPESH_FACT_DECONT_CONCRETE | MVM_SPESH_FACT_DECONT_TYPEOBJ)))
-                    return NULL;
-                known_type_st = STABLE(facts->decont_type);
-                is_conc = (facts->flags & MVM_SPESH_FACT_DECONT_CONCRETE) ? 1 : 0;
-                is_rw = (facts->flags & MVM_SPESH_FACT_RW_CONT) ? 1 : 0;
-            }
-            else {
-                known_type_st = STABLE(facts->type);
-                is_conc = (facts->flags & MVM_SPESH_FACT_CONCRETE) ? 1 : 0;
-                is_rw = is_conc && REPR(facts->type)->ID == MVM_REPR_ID_NativeRef;
-            }
-
-            /* Now check if what we have matches what we need. */
-            if (known_type_st->type_cache_id == type_id) {
-                MVMuint32 need_concrete = (arg_match & MVM_MULTICACHE_ARG_CONC_FILTER) ? 1 : 0;
-                if (is_conc == need_concrete) {
-                    MVMuint32 need_rw = (arg_match & MVM_MULTICACHE_ARG_RW_FILTER) ? 1 : 0;
-                    if (need_rw == is_rw) {
-                        cur_node = tree[cur_node].match;
-                        continue;
-                    }
-                }
-            }
-            cur_node = tree[cur_node].no_match;
-        }
-        else {
-            /* No facts about this argument available from analysis, so
-             * can't resolve the dispatch. */
+        MVMuint64 arg_match = tree[cur_node].action.arg_match;
+        MVMuint64 known_match;
+        MVMint32  known = spesh_arg_matcher(tc, arg_info, type_tuple,
+            arg_match & MVM_MULTICACHE_ARG_IDX_FILTER, &known_match);
+        if (known < 0)
             return NULL;
-        }
+        cur_node = known && known_match == arg_match
+            ? tree[cur_node].match
+            : tree[cur_node].no_match;
     }
 
     /* Negate result and index into results (the first result is always NULL
      * to save flow control around "no match"). */
     return cache->results[-cur_node];
 }
+
+/* Gets statistics about a multi-dispatch cache as a hash, so that it can be
+ * seen how well dispatches through it are being cached. The hit and miss
+ * counts stay at zero unless MVM_MULTI_CACHE_STATS is set. */
+MVMObject * MVM_multi_cache_stats(MVMThreadContext *tc, MVMObject *cache_obj) {
+    static const char *keys[] = { "entries", "callsites", "megamorphic", "hits", "misses" };
+    MVMint64   values[5] = { 0, 0, 0, 0, 0 };
+    MVMObject *result;
+    MVMuint32  i;
+
+    /* Take the figures before allocating, which may move the cache. */
+    if (!MVM_is_null(tc, cache_obj) && IS_CONCRETE(cache_obj) && REPR(cache_obj)->ID == MVM_REPR_ID_MVMMultiCache) {
+        MVMMultiCacheBody *cache = &((MVMMultiCache *)cache_obj)->body;
+        values[0] = cache->num_results ? cache->num_results - 1 : 0;
+        values[1] = cache->trees ? cache->trees->used : 0;
+        values[2] = cache->megamorphic_id ? 1 : 0;
+        values[3] = MVM_load(&(cache->hits));
+        values[4] = MVM_load(&(cache->misses));
+    }
+
+    result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    MVMROOT(tc, result, {
+        for (i = 0; i < 5; i++) {
+            MVMString *key = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, keys[i]);
+            MVMROOT(tc, key, {
+                MVMObject *value = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, values[i]);
+                MVM_repr_bind_key_o(tc, result, key, value);
+            });
+        }
+    });
+    return result;
+}
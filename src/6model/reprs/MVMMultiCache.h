@@ -1,34 +1,41 @@
-/* The multi-dispatch cache is a set of trees keyed on the address of
- * an interned callsite. The tree is represented as  an array of triples,
- * each having the form (action, match, no-match). The match and no-match
- * are either:
+/* The multi-dispatch cache is a hash of trees keyed on the address of an
+ * interned callsite. Each tree is represented as an array of triples, each
+ * having the form (action, match, no-match). The match and no-match are
+ * either:
  *   * Positive, and an index into the array for what to check next
  *   * Zero, meaning we failed to find a match
  *   * Negative, meaning we found a match, and should negate the index
  *     to get a the resulting candidate
  *
- * The first MVM_MULTICACHE_HASH_SIZE entries in the array are tree roots.
- * They are all set to have a NULL callsite matcher when there's no tree
- * there, implying an immediate match failure.
+ * The first node of a tree is in callsite match mode, meaning that its action
+ * is the memory address of the callsite the tree is for. Its match is where
+ * argument matching starts, and since nothing ever links back to it, its
+ * no-match is used to hold the number of nodes in the tree. The trees are
+ * found through an open addressing hash of them, keyed on their callsites,
+ * which grows as more callsites are seen.
  *
- * The matcher starts in callsite match mode, meaning that the matcher is
- * the memory address of a callsite. This naturally handles hash collisions.
- *
- * Once we have a matching callsite, it flips into argument matching mode.
- * The lowermost bits of the action represent the index into the arguments
- * buffer for the argument we need to test. The next bit is for concrete or
- * not. The bit after it is rw or not. The remaining bits correspond to the
- * STable's type cache ID.
+ * The other nodes are in argument matching mode. The lowermost bits of the
+ * action represent the index into the arguments buffer for the argument we
+ * need to test. The next bit is for concrete or not. The bit after it is rw
+ * or not. The remaining bits correspond to the STable's type cache ID.
  *
  * The construction of the tree is such that we only have to test the first
  * argument until we get a match, then the second, etc. This means that common
  * prefixes are factored out, keeping the tree smaller. The use of a single
- * block of memory is also aimed at getting good CPU cache hit rates.
+ * block of memory per tree is also aimed at getting good CPU cache hit rates.
+ *
+ * The trees are immutable, and so can safely be read by many threads, and
+ * kept in thier CPU caches. Upon a new entry, the tree for its callsite will
+ * be copied, and the tweaks made; other trees are left alone. The pointer to
+ * the tree in the hash will then be set to the new tree, and the old tree
+ * memory scheduled for freeing at the next safepoint. The same goes for the
+ * hash of trees itself when it grows.
  *
- * The tree array is immutable, and so can safely be read by many threads, and
- * kept in thier CPU caches. Upon a new entry, the cache will be copied, and the
- * tweaks made. The cache head pointer will then be set to the new cache, and the
- * old cache memory scheduled for freeeing at the next safepoint.
+ * Once a cache has many entries, as happens with heavily overloaded
+ * operators, the trees would get deep, and so it becomes megamorphic: its
+ * entries are moved to a hash shared by all megamorphic caches, keyed on the
+ * cache, the callsite and the argument matchers of all the arguments, and any
+ * later entries go there too.
  */
 
 /* A node in the cache. */
@@ -41,33 +48,77 @@ struct MVMMultiCacheNode {
     MVMint32 no_match;
 };
 
+/* The hash of trees. Replaced in whole when it grows. */
+struct MVMMultiCacheTrees {
+    /* The number of slots (a power of 2) minus one, and how many slots hold
+     * a tree. */
+    MVMuint32 mask;
+    MVMuint32 used;
+
+    /* The trees, or NULL for an empty slot. */
+    MVMMultiCacheNode *trees[1];
+};
+
 /* Body of a multi-dispatch cache. */
 struct MVMMultiCacheBody {
-    /* Pointer to the an array of nodes, which we can initially index
-     * into using a hahsed calsite. Replaced in whole whenever there is
-     * a change. */
-    MVMMultiCacheNode *node_hash_head;
-
-    /* Array of results we may return from the cache. Note that this is
-     * replaced entirely whenever we update the cache. It is append only,
-     * and so will be valid for older versions of the cache too. We must
-     * replace this and do a memory barrier before replacing node_hash_head
-     * with its new version on update. Conversely, readers must read the
-     * node_hash_head and *then* read results here, so it will always have
-     * been udpated in time. */
+    /* The hash of trees, keyed on callsite; NULL until the first entry. */
+    MVMMultiCacheTrees *trees;
+
+    /* Array of results we may return from the cache. It is append only; the
+     * array is replaced with a bigger one when it fills up, and it will be
+     * valid for older versions of the trees too. We must add to this and do
+     * a memory barrier before replacing a tree with its new version on
+     * update. Conversely, readers must read the tree and *then* read results
+     * here, so it will always have been udpated in time. */
     MVMObject **results;
 
-    /* The number of results, so we can GC mark and free. */
-    size_t num_results;
+    /* The number of results, so we can GC mark, and the number there is
+     * space for, so we can free. */
+    MVMuint32 num_results;
+    MVMuint32 alloc_results;
 
-    /* The amount of memory the cache uses. Used for freeing with the fixed
-     * size allocator. */
-    size_t cache_memory_size;
+    /* If the cache is megamorphic, its ID in the megamorphic hash; 0 if not.
+     * Set only after its entries are all in that hash. */
+    MVMuint64 megamorphic_id;
+
+    /* How many lookups found or didn't find a candidate. Only counted if
+     * the instance's multi_cache_stats is set, since it costs an atomic
+     * increment on every dispatch, which contends badly when many threads
+     * share a cache. */
+    AO_t hits;
+    AO_t misses;
 };
 
-/* Hash table size. Must be a power of 2. */
+/* Initial size of the hash of trees. Must be a power of 2. */
 #define MVM_MULTICACHE_HASH_SIZE    8
-#define MVM_MULTICACHE_HASH_FILTER  (MVM_MULTICACHE_HASH_SIZE - 1)
+
+/* Number of entries after which a cache becomes megamorphic. */
+#define MVM_MULTICACHE_MEGAMORPHIC_LIMIT    64
+
+/* An entry in the megamorphic hash. */
+struct MVMMultiCacheMegaEntry {
+    /* The megamorphic ID of the cache the entry is for, or 0 if the entry
+     * is empty. Written last. */
+    MVMuint64 cache_id;
+
+    /* The callsite, and the argument matchers for its object arguments. */
+    MVMCallsite *cs;
+    MVMuint64    arg_match[MVM_INTERN_ARITY_LIMIT];
+
+    /* The index of the result in the cache's results. */
+    MVMuint32 result;
+};
+
+/* The megamorphic hash, shared by all megamorphic caches and replaced in
+ * whole when it grows. */
+struct MVMMultiCacheMegaTable {
+    /* The number of entries (a power of 2) minus one, and how many are not
+     * empty, counting those of caches that are gone. */
+    MVMuint32 mask;
+    MVMuint32 used;
+
+    MVMMultiCacheMegaEntry entries[1];
+};
 
 struct MVMMultiCache {
     MVMObject common;
@@ -83,3 +134,4 @@ MVMObject * MVM_multi_cache_find(MVMThreadContext *tc, MVMObject *cache, MVMObje
 MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *cache,
     MVMCallsite *cs, MVMRegister *args);
 MVMObject * MVM_multi_cache_find_spesh(MVMThreadContext *tc, MVMObject *cache, MVMSpeshCallInfo *arg_info, MVMSpeshStatsType *type_tuple);
+MVMObject * MVM_multi_cache_stats(MVMThreadContext *tc, MVMObject *cache);
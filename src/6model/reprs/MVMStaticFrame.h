@@ -37,6 +37,10 @@ struct MVMStaticFrameBody {
 
     /* Does the frame contain specializable instructions? */
     MVMuint8 specializable;
+
+    /* Was the frame specialized in an earlier run, according to the hot
+     * frame cache? */
+    MVMuint8 spesh_known_hot;
     /* Zero if the frame was never invoked. Above zero is the instrumentation
      * level the VM was atlast time the frame was invoked. See MVMInstance for
      * the VM instance wide field for this. */
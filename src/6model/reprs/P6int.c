@@ -204,10 +204,16 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
     switch (ins->info->opcode) {
         case MVM_OP_box_i: {
             if (repr_data->bits == 64 && !(st->mode_flags & MVM_FINALIZE_TYPE)) {
-                /* Turn into a sp_fastbox_i[_ic] instruction. */
-                MVMint32 int_cache_type_idx = MVM_intcache_type_index(tc, st->WHAT);
-                MVMSpeshFacts *tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
-                MVMSpeshOperand *orig_operands = ins->operands;
+                /* Turn into a sp_fastbox_i[_ic] instruction, unless we know
+                 * the value and have a cached box for it. */
+                MVMint32 int_cache_type_idx;
+                MVMSpeshFacts *tgt_facts;
+                MVMSpeshOperand *orig_operands;
+                if (MVM_intcache_spesh_box(tc, g, ins, st->WHAT))
+                    break;
+                int_cache_type_idx = MVM_intcache_type_index(tc, st->WHAT);
+                tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+                orig_operands = ins->operands;
 
                 MVM_spesh_graph_add_comment(tc, g, ins, "box_i into a %s",
                         MVM_6model_get_stable_debug_name(tc, st));
@@ -630,6 +630,80 @@ static void mk_storage_spec(MVMThreadContext *tc, MVMP6opaqueREPRData * repr_dat
         spec->can_box += MVM_STORAGE_SPEC_CAN_BOX_STR;
 }
 
+/* Attributes are laid out in slot order, except that one which fits in the
+ * padding left before an earlier, more strictly aligned attribute is put
+ * there instead. This packs small natives tightly, while keeping the layout
+ * of a class a prefix of the layouts of its subclasses and mixins, which
+ * change_type relies on. The same layout must be computed from serialized
+ * REPR data, so it depends only on the size and alignment of each slot. */
+typedef struct {
+    MVMuint32 start;
+    MVMuint32 size;
+} P6opaqueHole;
+typedef struct {
+    /* The end of the attributes laid out so far. */
+    MVMuint32 end;
+
+    /* Padding holes, in address order. Each attribute adds at most one
+     * hole, or splits one into two, so one per attribute is enough. */
+    MVMuint32     num_holes;
+    P6opaqueHole *holes;
+} P6opaqueLayout;
+static void layout_init(P6opaqueLayout *layout, MVMuint32 start, MVMuint64 num_attrs) {
+    layout->end       = start;
+    layout->num_holes = 0;
+    layout->holes     = MVM_malloc((num_attrs + 1) * sizeof(P6opaqueHole));
+}
+static MVMuint32 layout_place(P6opaqueLayout *layout, MVMuint32 size, MVMuint32 align) {
+    MVMuint32 i, offset;
+    if (align == 0)
+        align = 1;
+
+    /* Look for a hole the attribute fits in. */
+    for (i = 0; size && i < layout->num_holes; i++) {
+        P6opaqueHole *hole     = &(layout->holes[i]);
+        MVMuint32     hole_end = hole->start + hole->size;
+        offset = hole->start;
+        if (offset % align)
+            offset += align - offset % align;
+        if (offset + size > hole_end)
+            continue;
+
+        /* Found one; keep whatever is left either side of the attribute. */
+        if (offset > hole->start && offset + size < hole_end) {
+            memmove(&(layout->holes[i + 2]), &(layout->holes[i + 1]),
+                (layout->num_holes - i - 1) * sizeof(P6opaqueHole));
+            layout->holes[i + 1].start = offset + size;
+            layout->holes[i + 1].size  = hole_end - (offset + size);
+            hole->size = offset - hole->start;
+            layout->num_holes++;
+        }
+        else if (offset > hole->start) {
+            hole->size = offset - hole->start;
+        }
+        else if (offset + size < hole_end) {
+            hole->start = offset + size;
+            hole->size  = hole_end - hole->start;
+        }
+        else {
+            memmove(hole, hole + 1, (layout->num_holes - i - 1) * sizeof(P6opaqueHole));
+            layout->num_holes--;
+        }
+        return offset;
+    }
+
+    /* Otherwise, it goes on the end, aligned as needed. */
+    offset = layout->end;
+    if (offset % align) {
+        layout->holes[layout->num_holes].start = offset;
+        layout->holes[layout->num_holes].size  = align - offset % align;
+        layout->num_holes++;
+        offset += align - offset % align;
+    }
+    layout->end = offset + size;
+    return offset;
+}
+
 /* Compose the representation. */
 static MVMuint16 * allocate_unbox_slots() {
     MVMuint16 *slots = MVM_malloc(MVM_REPR_MAX_COUNT * sizeof(MVMuint16));
@@ -645,6 +719,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                unboxed_type, i;
     MVMObject *info;
     MVMP6opaqueREPRData *repr_data;
+    P6opaqueLayout layout;
 
     MVMStringConsts       str_consts = tc->instance->str_consts;
     MVMString        * const str_avc = str_consts.auto_viv_container;
@@ -717,11 +792,11 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
     mro_pos          = mro_count;
     cur_slot         = 0;
     cur_type         = 0;
-    cur_alloc_addr   = sizeof(MVMP6opaqueBody);
     cur_obj_attr     = 0;
     cur_init_slot    = 0;
     cur_mark_slot    = 0;
     cur_cleanup_slot = 0;
+    layout_init(&layout, sizeof(MVMP6opaqueBody), total_attrs);
     while (mro_pos--) {
         /* Get info for the class at the current position. */
         MVMObject *class_info = MVM_repr_at_pos_o(tc, info, mro_pos);
@@ -830,14 +905,9 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                 }
             }
 
-            /* C structure needs careful alignment. If cur_alloc_addr is not
-             * aligned to align bytes (cur_alloc_addr % align), make sure it is
-             * before we add the next element. */
-            if (cur_alloc_addr % align) {
-                cur_alloc_addr += align - cur_alloc_addr % align;
-            }
-
-            /* Attribute will live at the current position in the object. */
+            /* Find where the attribute will live in the object, taking care
+             * of its alignment. */
+            cur_alloc_addr = layout_place(&layout, bits / 8, align);
             repr_data->attribute_offsets[cur_slot] = cur_alloc_addr;
 
             /* Handle object attributes, which need marking and may have auto-viv needs. */
@@ -871,9 +941,6 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                         "While composing %s: Associative delegate attribute must be a reference type", MVM_6model_get_stable_debug_name(tc, st));
             }
 
-            /* Add the required space for this type. */
-            cur_alloc_addr += bits / 8;
-
             /* Increment slot count. */
             cur_slot++;
         }
@@ -883,7 +950,8 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
     }
 
     /* Add allocated amount for body to have total object size. */
-    st->size = sizeof(MVMP6opaque) + (cur_alloc_addr - sizeof(MVMP6opaqueBody));
+    st->size = sizeof(MVMP6opaque) + (layout.end - sizeof(MVMP6opaqueBody));
+    MVM_free(layout.holes);
 
     /* Add sentinels/counts. */
     repr_data->gc_obj_mark_offsets_count = cur_obj_attr;
@@ -903,28 +971,26 @@ static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSeri
     /* To calculate size, we need number of attributes and to know about
      * anything flattend in. */
     MVMint64  num_attributes = MVM_serialization_read_int(tc, reader);
-    MVMuint32 cur_offset = sizeof(MVMP6opaque);
     MVMint64  i;
+    P6opaqueLayout layout;
+    layout_init(&layout, sizeof(MVMP6opaqueBody), num_attributes);
     for (i = 0; i < num_attributes; i++) {
         if (MVM_serialization_read_int(tc, reader)) {
             MVMSTable *st = MVM_serialization_read_stable_ref(tc, reader);
             const MVMStorageSpec *ss = st->REPR->get_storage_spec(tc, st);
-            if (ss->inlineable) {
+            if (ss->inlineable)
                 /* TODO: Review if/when we get sub-byte things. */
-                if (cur_offset % ss->align) {
-                    cur_offset += ss->align - cur_offset % ss->align;
-                }
-                cur_offset += ss->bits / 8;
-            }
+                layout_place(&layout, ss->bits / 8, ss->align);
             else
-                cur_offset += sizeof(MVMObject *);
+                layout_place(&layout, sizeof(MVMObject *), ALIGNOF(void *));
         }
         else {
-            cur_offset += sizeof(MVMObject *);
+            layout_place(&layout, sizeof(MVMObject *), ALIGNOF(void *));
         }
     }
 
-    st->size = cur_offset;
+    st->size = sizeof(MVMP6opaque) + (layout.end - sizeof(MVMP6opaqueBody));
+    MVM_free(layout.holes);
 }
 
 /* Serializes the REPR data. */
@@ -1001,6 +1067,7 @@ static void serialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializ
 /* Deserializes representation data. */
 static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
     MVMuint16 i, j, num_classes, cur_offset;
+    P6opaqueLayout layout;
     MVMint16 cur_initialize_slot, cur_gc_mark_slot, cur_gc_cleanup_slot;
 
     MVMP6opaqueREPRData *repr_data = MVM_malloc(sizeof(MVMP6opaqueREPRData));
@@ -1081,21 +1148,19 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
     repr_data->gc_mark_slots       = (MVMint16 *)MVM_malloc((repr_data->num_attributes + 1) * sizeof(MVMint16));
     repr_data->gc_cleanup_slots    = (MVMint16 *)MVM_malloc((repr_data->num_attributes + 1) * sizeof(MVMint16));
     repr_data->gc_obj_mark_offsets_count = 0;
-    cur_offset          = sizeof(MVMP6opaqueBody);
+    layout_init(&layout, sizeof(MVMP6opaqueBody), repr_data->num_attributes);
     cur_initialize_slot = 0;
     cur_gc_mark_slot    = 0;
     cur_gc_cleanup_slot = 0;
     for (i = 0; i < repr_data->num_attributes; i++) {
         if (repr_data->flattened_stables[i] == NULL) {
             /* Store position. */
+            cur_offset = layout_place(&layout, sizeof(MVMObject *), ALIGNOF(void *));
             repr_data->attribute_offsets[i] = cur_offset;
 
             /* Reference type. Needs marking. */
             repr_data->gc_obj_mark_offsets[repr_data->gc_obj_mark_offsets_count] = cur_offset;
             repr_data->gc_obj_mark_offsets_count++;
-
-            /* Increment by pointer size. */
-            cur_offset += sizeof(MVMObject *);
         }
         else {
             /* Store position. */
@@ -1110,19 +1175,15 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
                 repr_data->gc_cleanup_slots[cur_gc_cleanup_slot++] = i;
 
             if (spec->align == 0) {
+                MVM_free(layout.holes);
                 MVM_exception_throw_adhoc(tc, "Serialization error: Storage Spec of P6opaque must not have align set to 0.");
             }
 
-            if (cur_offset % spec->align) {
-                cur_offset += spec->align - cur_offset % spec->align;
-            }
-
-            repr_data->attribute_offsets[i] = cur_offset;
-
-            /* Increment by size reported by representation. */
-            cur_offset += spec->bits / 8;
+            /* Place it, using the size reported by representation. */
+            repr_data->attribute_offsets[i] = layout_place(&layout, spec->bits / 8, spec->align);
         }
     }
+    MVM_free(layout.holes);
     repr_data->initialize_slots[cur_initialize_slot] = -1;
     repr_data->gc_mark_slots[cur_gc_mark_slot] = -1;
     repr_data->gc_cleanup_slots[cur_gc_cleanup_slot] = -1;
@@ -1696,10 +1757,16 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
                 !(st->mode_flags & MVM_FINALIZE_TYPE)) {
             MVMSTable *embedded_st = repr_data->flattened_stables[repr_data->unbox_int_slot];
             if (embedded_st->REPR->ID == MVM_REPR_ID_P6bigint) {
-                /* Turn into a sp_fastbox_bi[_ic] instruction. */
-                MVMint32 int_cache_type_idx = MVM_intcache_type_index(tc, st->WHAT);
-                MVMSpeshFacts *tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
-                MVMSpeshOperand *orig_operands = ins->operands;
+                /* Turn into a sp_fastbox_bi[_ic] instruction, unless we know
+                 * the value and have a cached box for it. */
+                MVMint32 int_cache_type_idx;
+                MVMSpeshFacts *tgt_facts;
+                MVMSpeshOperand *orig_operands;
+                if (MVM_intcache_spesh_box(tc, g, ins, st->WHAT))
+                    break;
+                int_cache_type_idx = MVM_intcache_type_index(tc, st->WHAT);
+                tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+                orig_operands = ins->operands;
                 ins->info = MVM_op_get_op(int_cache_type_idx < 0
                         ? MVM_OP_sp_fastbox_bi
                         : MVM_OP_sp_fastbox_bi_ic);
@@ -2,8 +2,9 @@
  * follows on from this depends on the declaration. For object attributes, it will
  * be a pointer size and point to another MVMObject. For native integers and
  * numbers, it will be the appropriate sized piece of memory to store them
- * right there in the object. Note that P6opaque does not do packed storage, so
- * an int2 gets as much space as an int. */
+ * right there in the object; small ones may be moved into the padding before
+ * an earlier attribute. Note that P6opaque does not do packed storage, so an
+ * int2 gets as much space as an int. */
 struct MVMP6opaqueBody {
     /* If we get mixed into, we may change size. If so, we can't really resize
      * the object, so instead we hang its post-resize form off this pointer.
@@ -0,0 +1,438 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps StringMatcher_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &StringMatcher_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStringMatcher);
+    });
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation StringMatcher");
+}
+
+/* Frees an automaton. */
+static void free_automaton(MVMStringMatcherAutomaton *am) {
+    MVM_free(am->states);
+    MVM_free(am->edges);
+    MVM_free(am);
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMStringMatcher *matcher = (MVMStringMatcher *)obj;
+    if (matcher->body.automaton)
+        free_automaton(matcher->body.automaton);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStringMatcher);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringMatcherAutomaton *am = ((MVMStringMatcherBody *)data)->automaton;
+    if (!am)
+        return 0;
+    return sizeof(MVMStringMatcherAutomaton)
+        + am->num_states * sizeof(MVMStringMatcherState)
+        + (am->num_states - 1) * sizeof(MVMStringMatcherEdge);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStringMatcher_initialize(MVMThreadContext *tc) {
+    return &StringMatcher_this_repr;
+}
+
+static const MVMREPROps StringMatcher_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "StringMatcher", /* name */
+    MVM_REPR_ID_StringMatcher,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a string matcher; throw if not. */
+static MVMStringMatcher * ensure_matcher(MVMThreadContext *tc, MVMObject *matcher, const char *op) {
+    if (MVM_UNLIKELY(REPR(matcher)->ID != MVM_REPR_ID_StringMatcher || !IS_CONCRETE(matcher)))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the StringMatcher representation",
+            op);
+    return (MVMStringMatcher *)matcher;
+}
+
+/* While building the trie, the transitions out of each state are kept in a
+ * linked list. */
+typedef struct {
+    MVMGrapheme32 g;
+    MVMuint32     to;
+    MVMint32      next;
+} BuildEdge;
+static MVMuint32 build_goto(BuildEdge *edges, MVMint32 edge, MVMGrapheme32 g) {
+    for (; edge >= 0; edge = edges[edge].next)
+        if (edges[edge].g == g)
+            return edges[edge].to;
+    return 0;
+}
+
+static int cmp_edges(const void *a, const void *b) {
+    MVMGrapheme32 x = ((const MVMStringMatcherEdge *)a)->g;
+    MVMGrapheme32 y = ((const MVMStringMatcherEdge *)b)->g;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/* Configures the matcher with the needles to look for, which are a list of
+ * strings, building the automaton. If ignorecase is set, the needles are
+ * casefolded, and so is the haystack as we go. Empty needles are ignored. */
+void MVM_string_matcher_configure(MVMThreadContext *tc, MVMObject *matcher,
+                                  MVMObject *needles, MVMint64 ignorecase) {
+    MVMStringMatcherAutomaton *am;
+    MVMuint32  *queue;
+    MVMuint32   max_depth = 0;
+    MVMuint32   q_head, q_tail, i;
+    MVMuint64   num_needles;
+    MVMStringMatcherState root;
+    MVM_VECTOR_DECL(MVMStringMatcherState, states);
+    MVM_VECTOR_DECL(MVMint32, heads);
+    MVM_VECTOR_DECL(BuildEdge, build_edges);
+
+    if (ensure_matcher(tc, matcher, "strmatcherconfigure")->body.automaton)
+        MVM_exception_throw_adhoc(tc, "StringMatcher already configured");
+    num_needles = MVM_repr_elems(tc, needles);
+    if (num_needles > 0x7FFFFFFF)
+        MVM_exception_throw_adhoc(tc, "Too many needles for StringMatcher");
+
+    /* Build a trie of the needles. */
+    MVM_VECTOR_INIT(states, 16);
+    MVM_VECTOR_INIT(heads, 16);
+    MVM_VECTOR_INIT(build_edges, 16);
+    memset(&root, 0, sizeof(MVMStringMatcherState));
+    root.needle = -1;
+    MVM_VECTOR_PUSH(states, root);
+    MVM_VECTOR_PUSH(heads, -1);
+    MVMROOT2(tc, matcher, needles, {
+        for (i = 0; i < num_needles; i++) {
+            MVMString       *needle = MVM_repr_at_pos_s(tc, needles, i);
+            MVMuint32        state  = 0;
+            MVMGraphemeIter  gi;
+            MVM_string_check_arg(tc, needle, "strmatcherconfigure");
+            if (ignorecase)
+                needle = MVM_string_fc(tc, needle);
+            if (!MVM_string_graphs_nocheck(tc, needle))
+                continue;
+            MVM_string_gi_init(tc, &gi, needle);
+            while (MVM_string_gi_has_more(tc, &gi)) {
+                MVMGrapheme32 g    = MVM_string_gi_get_grapheme(tc, &gi);
+                MVMuint32     next = build_goto(build_edges, heads[state], g);
+                if (!next) {
+                    MVMStringMatcherState added;
+                    BuildEdge             edge;
+                    memset(&added, 0, sizeof(MVMStringMatcherState));
+                    next           = MVM_VECTOR_ELEMS(states);
+                    added.depth    = states[state].depth + 1;
+                    added.needle   = -1;
+                    edge.g         = g;
+                    edge.to        = next;
+                    edge.next      = heads[state];
+                    heads[state]   = MVM_VECTOR_ELEMS(build_edges);
+                    MVM_VECTOR_PUSH(build_edges, edge);
+                    MVM_VECTOR_PUSH(states, added);
+                    MVM_VECTOR_PUSH(heads, -1);
+                }
+                state = next;
+            }
+            if (states[state].needle < 0)
+                states[state].needle = (MVMint32)i;
+            if (max_depth < states[state].depth)
+                max_depth = states[state].depth;
+        }
+    });
+
+    /* Work out the failure transitions breadth first, so that those of the
+     * shallower states we need are always there already. */
+    queue  = MVM_malloc(MVM_VECTOR_ELEMS(states) * sizeof(MVMuint32));
+    q_head = q_tail = 0;
+    queue[q_tail++] = 0;
+    while (q_head < q_tail) {
+        MVMuint32 u = queue[q_head++];
+        MVMint32  e;
+        for (e = heads[u]; e >= 0; e = build_edges[e].next) {
+            MVMuint32     v = build_edges[e].to;
+            MVMGrapheme32 g = build_edges[e].g;
+            MVMuint32     t = 0;
+            if (u) {
+                MVMuint32 f = states[u].fail;
+                while (f && !build_goto(build_edges, heads[f], g))
+                    f = states[f].fail;
+                t = build_goto(build_edges, heads[f], g);
+            }
+            states[v].fail   = t;
+            states[v].output = states[t].needle >= 0 ? t : states[t].output;
+            queue[q_tail++]  = v;
+        }
+    }
+    MVM_free(queue);
+
+    /* Lay the transitions out sorted by grapheme, for binary search. */
+    am = MVM_calloc(1, sizeof(MVMStringMatcherAutomaton));
+    am->num_states = MVM_VECTOR_ELEMS(states);
+    am->max_depth  = max_depth;
+    am->ignorecase = ignorecase ? 1 : 0;
+    am->edges      = MVM_malloc((MVM_VECTOR_ELEMS(build_edges) + 1) * sizeof(MVMStringMatcherEdge));
+    q_tail = 0;
+    for (i = 0; i < am->num_states; i++) {
+        MVMint32 e;
+        states[i].first_edge = q_tail;
+        for (e = heads[i]; e >= 0; e = build_edges[e].next) {
+            am->edges[q_tail].g  = build_edges[e].g;
+            am->edges[q_tail].to = build_edges[e].to;
+            q_tail++;
+        }
+        states[i].num_edges = q_tail - states[i].first_edge;
+        qsort(am->edges + states[i].first_edge, states[i].num_edges,
+            sizeof(MVMStringMatcherEdge), cmp_edges);
+    }
+    for (i = 0; i < states[0].num_edges; i++)
+        if (0 <= am->edges[i].g && am->edges[i].g < 128)
+            am->root_ascii[am->edges[i].g] = am->edges[i].to;
+    am->states = states;
+    MVM_VECTOR_DESTROY(heads);
+    MVM_VECTOR_DESTROY(build_edges);
+
+    if (!MVM_trycas(&(((MVMStringMatcher *)matcher)->body.automaton), NULL, am)) {
+        free_automaton(am);
+        MVM_exception_throw_adhoc(tc, "StringMatcher already configured");
+    }
+}
+
+/* Gets the automaton of a matcher, throwing if it isn't configured. */
+static MVMStringMatcherAutomaton * get_automaton(MVMThreadContext *tc, MVMObject *matcher, const char *op) {
+    MVMStringMatcherAutomaton *am = ensure_matcher(tc, matcher, op)->body.automaton;
+    if (!am)
+        MVM_exception_throw_adhoc(tc, "StringMatcher not yet configured");
+    return am;
+}
+
+/* Follows the transition for a grapheme out of a state, going along the
+ * failure transitions until there is one. */
+MVM_STATIC_INLINE MVMuint32 step(MVMStringMatcherAutomaton *am, MVMuint32 state, MVMGrapheme32 g) {
+    while (1) {
+        MVMStringMatcherState *s = &(am->states[state]);
+        if (state == 0 && 0 <= g && g < 128)
+            return am->root_ascii[g];
+        if (s->num_edges) {
+            MVMStringMatcherEdge *edges = am->edges + s->first_edge;
+            MVMuint32 lo = 0, hi = s->num_edges;
+            while (lo < hi) {
+                MVMuint32 mid = (lo + hi) / 2;
+                if (edges[mid].g < g)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo < s->num_edges && edges[lo].g == g)
+                return edges[lo].to;
+        }
+        if (state == 0)
+            return 0;
+        state = s->fail;
+    }
+}
+
+/* Runs the automaton over the haystack from the start position. If all is
+ * set, every occurrence of every needle, including overlapping ones, is
+ * pushed to the results, as its start position, its end position and the
+ * index of the needle, in the order in which they end; the number of them is
+ * returned. Otherwise, just the first occurrence is, and its start position
+ * returned, or -1 if there is none. The first occurrence is the one that
+ * starts first, and of those that do, the longest.
+ *
+ * When ignoring case, a grapheme may casefold to more than one, so we keep
+ * the haystack position of the last max_depth graphemes fed to the
+ * automaton, and only count matches that start and end on the boundaries of
+ * haystack graphemes. */
+/* Checks that the results array is a concrete native int array we can push
+ * to. This is done before the search starts, so that pushing can't throw
+ * once we have memory of our own to free. */
+static void check_results(MVMThreadContext *tc, MVMObject *results, const char *op) {
+    if (!IS_CONCRETE(results) || REPR(results)->ID != MVM_REPR_ID_VMArray
+            || ((MVMArrayREPRData *)STABLE(results)->REPR_data)->slot_type != MVM_ARRAY_I64)
+        MVM_exception_throw_adhoc(tc, "Operation '%s' requires a native int array for its results", op);
+    MVM_VMArray_unshare(tc, results);
+}
+
+static MVMint64 match(MVMThreadContext *tc, MVMObject *matcher, MVMString *haystack,
+                      MVMint64 start, MVMObject *results, MVMint64 all, const char *op) {
+    MVMStringMatcherAutomaton *am = get_automaton(tc, matcher, op);
+    MVMStringIndex  H_graphs;
+    MVMGraphemeIter gi;
+    MVMint64       *ring  = NULL;
+    MVMuint64       mask  = 0;
+    MVMuint64       sym   = 0;
+    MVMuint32       state = 0;
+    MVMint64        found = 0;
+    MVMint64        best_start = -1, best_end = -1, best_needle = -1;
+    MVMint64        index;
+
+    MVM_string_check_arg(tc, haystack, op);
+    check_results(tc, results, op);
+    H_graphs = MVM_string_graphs_nocheck(tc, haystack);
+    if (start < 0 || H_graphs <= start)
+        return all ? 0 : -1;
+    MVM_string_gi_init(tc, &gi, haystack);
+    if (start)
+        MVM_string_gi_move_to(tc, &gi, start);
+    if (am->ignorecase) {
+        MVMuint64 size = 1;
+        while (size < am->max_depth)
+            size *= 2;
+        ring = MVM_malloc(size * sizeof(MVMint64));
+        mask = size - 1;
+    }
+
+    for (index = start; index < H_graphs; index++) {
+        MVMGrapheme32        g        = MVM_string_gi_get_grapheme(tc, &gi);
+        const MVMGrapheme32 *syms     = &g;
+        MVMuint32            num_syms = 1;
+        MVMuint32            j;
+        if (am->ignorecase) {
+            if (0 <= g && g < 128) {
+                if ('A' <= g && g <= 'Z')
+                    g += 'a' - 'A';
+            }
+            else {
+                MVMuint32 num_fc = 0;
+                if (0 <= g) {
+                    const MVMCodepoint *fc;
+                    num_fc = MVM_unicode_get_case_change(tc, g, MVM_unicode_case_change_type_fold, &fc);
+                    syms   = (const MVMGrapheme32 *)fc;
+                }
+                else {
+                    MVMGrapheme32 *fc;
+                    num_fc = MVM_nfg_get_case_change(tc, g, MVM_unicode_case_change_type_fold, &fc);
+                    syms   = fc;
+                }
+                if (num_fc)
+                    num_syms = num_fc;
+                else
+                    syms = &g;
+            }
+        }
+        for (j = 0; j < num_syms; j++, sym++) {
+            MVMStringMatcherState *s;
+            state = step(am, state, syms[j]);
+            s     = &(am->states[state]);
+            if (ring)
+                ring[sym & mask] = j == 0 ? index : -1;
+            if (j + 1 == num_syms && (s->needle >= 0 || s->output)) {
+                /* The failure chain goes from the longest needle ending here
+                 * to the shortest, and so from the one starting first. */
+                MVMuint32 t = s->needle >= 0 ? state : s->output;
+                for (; t; t = am->states[t].output) {
+                    MVMuint32 depth   = am->states[t].depth;
+                    MVMint64  m_start = ring
+                        ? ring[(sym + 1 - depth) & mask]
+                        : index + 1 - depth;
+                    if (m_start < 0)
+                        continue;
+                    if (all) {
+                        MVM_repr_push_i(tc, results, m_start);
+                        MVM_repr_push_i(tc, results, index + 1);
+                        MVM_repr_push_i(tc, results, am->states[t].needle);
+                        found++;
+                    }
+                    else {
+                        if (!found || m_start <= best_start) {
+                            best_start  = m_start;
+                            best_end    = index + 1;
+                            best_needle = am->states[t].needle;
+                            found       = 1;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        /* Anything we find from here on starts after the prefix that the
+         * state stands for does, which takes up at most as many graphemes
+         * as it is long, so can't come before what we already found. */
+        if (!all && found && best_start < index + 1 - (MVMint64)am->states[state].depth)
+            break;
+    }
+    MVM_free(ring);
+
+    if (all)
+        return found;
+    if (!found)
+        return -1;
+    MVM_repr_push_i(tc, results, best_start);
+    MVM_repr_push_i(tc, results, best_end);
+    MVM_repr_push_i(tc, results, best_needle);
+    return best_start;
+}
+
+/* Finds the first occurrence of any needle in the haystack. */
+MVMint64 MVM_string_matcher_first(MVMThreadContext *tc, MVMObject *matcher,
+                                  MVMString *haystack, MVMint64 start, MVMObject *results) {
+    return match(tc, matcher, haystack, start, results, 0, "strmatcherfirst");
+}
+
+/* Finds all occurrences of all needles in the haystack. */
+MVMint64 MVM_string_matcher_all(MVMThreadContext *tc, MVMObject *matcher,
+                                MVMString *haystack, MVMint64 start, MVMObject *results) {
+    return match(tc, matcher, haystack, start, results, 1, "strmatcherall");
+}
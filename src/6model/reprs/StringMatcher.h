@@ -0,0 +1,69 @@
+/* Representation of a precompiled matcher, which finds occurrences of any of
+ * a set of needle strings in a single pass over a haystack, using the
+ * Aho-Corasick algorithm. */
+
+/* A state of the automaton, standing for a prefix of one or more of the
+ * needles. State 0 is the root, which stands for the empty prefix. */
+struct MVMStringMatcherState {
+    /* The transitions out of the state, sorted by grapheme, as a range of
+     * the automaton's edges. */
+    MVMuint32 first_edge;
+    MVMuint32 num_edges;
+
+    /* The state for the longest proper suffix of this state's prefix that
+     * is also a prefix of a needle; we go on from there when there is no
+     * transition for a grapheme. */
+    MVMuint32 fail;
+
+    /* The next state along the failure chain that ends a needle, or 0. */
+    MVMuint32 output;
+
+    /* The length of the prefix, in graphemes. */
+    MVMuint32 depth;
+
+    /* The index of the needle that ends here, or -1 if none does. */
+    MVMint32 needle;
+};
+
+/* A transition from one state to another. */
+struct MVMStringMatcherEdge {
+    MVMGrapheme32 g;
+    MVMuint32     to;
+};
+
+/* The automaton built from the needles. */
+struct MVMStringMatcherAutomaton {
+    MVMStringMatcherState *states;
+    MVMStringMatcherEdge  *edges;
+    MVMuint32              num_states;
+
+    /* The length of the longest needle, in graphemes. */
+    MVMuint32 max_depth;
+
+    /* Whether we match ignoring case; if so, the needles were casefolded. */
+    MVMuint32 ignorecase;
+
+    /* The transitions out of the root for ASCII graphemes, or 0 where there
+     * are none, since that's where we go looking most of the time. */
+    MVMuint32 root_ascii[128];
+};
+
+struct MVMStringMatcherBody {
+    /* The automaton; NULL until the matcher is configured. */
+    MVMStringMatcherAutomaton *automaton;
+};
+struct MVMStringMatcher {
+    MVMObject common;
+    MVMStringMatcherBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStringMatcher_initialize(MVMThreadContext *tc);
+
+/* Operations on a StringMatcher object. */
+void MVM_string_matcher_configure(MVMThreadContext *tc, MVMObject *matcher,
+                                  MVMObject *needles, MVMint64 ignorecase);
+MVMint64 MVM_string_matcher_first(MVMThreadContext *tc, MVMObject *matcher,
+                                  MVMString *haystack, MVMint64 start, MVMObject *results);
+MVMint64 MVM_string_matcher_all(MVMThreadContext *tc, MVMObject *matcher,
+                                MVMString *haystack, MVMint64 start, MVMObject *results);
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include "limits.h"
+#include "platform/mmap.h"
 
 /* This representation's function pointer table. */
 static const MVMREPROps VMArray_this_repr;
@@ -18,6 +19,65 @@ static void exit_single_user(MVMThreadContext *tc, MVMArrayBody *arr) {
 #endif
 }
 
+/* Makes dest a view of elems elements of src's slots, starting from the
+ * given element, without copying them. The two share the slots until one
+ * of them is written to (see unshare). Cloning or slicing only reads src,
+ * so other threads may be doing the same; if src isn't sharing its slots
+ * yet, whichever of us installs the record of them first wins, and the
+ * others free theirs. A file mapped read-only is not shared: writing to
+ * it is an error, which a clone or slice shouldn't inherit, so dest gets a
+ * private copy of the elements it can see instead. */
+static void share_slots(MVMThreadContext *tc, MVMArrayREPRData *repr_data, MVMArrayBody *src,
+        MVMObject *dest_root, MVMArrayBody *dest, MVMuint64 start, MVMuint64 elems) {
+    MVMArrayShared *shared = (MVMArrayShared *)MVM_load(&(src->shared));
+    if (shared && shared->read_only) {
+        size_t mem_size = elems * repr_data->elem_size;
+        dest->shared    = NULL;
+        dest->slots.any = MVM_malloc(mem_size);
+        memcpy(dest->slots.any, src->slots.u8 + (src->start + start) * repr_data->elem_size,
+            mem_size);
+        dest->start     = 0;
+        dest->elems     = elems;
+        dest->ssize     = elems;
+        return;
+    }
+    if (!shared) {
+        shared = MVM_malloc(sizeof(MVMArrayShared));
+        shared->refs  = 1;
+        shared->slots = src->slots.any;
+        shared->ssize = src->ssize;
+        shared->map_handle = NULL;
+        shared->map_size   = 0;
+        shared->read_only  = 0;
+        if (MVM_casptr(&(src->shared), NULL, shared) != NULL) {
+            MVM_free(shared);
+            shared = (MVMArrayShared *)MVM_load(&(src->shared));
+        }
+    }
+    MVM_incr(&(shared->refs));
+    dest->shared    = shared;
+    dest->slots.any = src->slots.any;
+    dest->start     = src->start + start;
+    dest->elems     = elems;
+    dest->ssize     = dest->start + elems;
+
+    /* If dest is already in gen2, it may now reference nursery objects. */
+    if ((repr_data->slot_type == MVM_ARRAY_OBJ || repr_data->slot_type == MVM_ARRAY_STR)
+            && (dest_root->header.flags & MVM_CF_SECOND_GEN))
+        MVM_gc_write_barrier_hit(tc, (MVMCollectable *)dest_root);
+}
+
+/* Lets go of shared slots, freeing them if nothing else uses them. */
+static void release_shared(MVMArrayShared *shared) {
+    if (MVM_decr(&(shared->refs)) == 1) {
+        if (shared->map_size)
+            MVM_platform_unmap_file(shared->slots, shared->map_handle, shared->map_size);
+        else
+            MVM_free(shared->slots);
+        MVM_free(shared);
+    }
+}
+
 /* Creates a new type object of this representation, and associates it with
  * the given HOW. */
 static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
@@ -39,9 +99,8 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
     return st->WHAT;
 }
 
-/* Copies the body of one object to another. The result has the space
- * needed for the current number of elements, which may not be the
- * entire allocated slot size. */
+/* Copies the body of one object to another. The copy shares the slots of
+ * the original until either of them is written to. */
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     MVMArrayBody     *src_body  = (MVMArrayBody *)src;
@@ -50,11 +109,7 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     dest_body->ssize = src_body->elems;
     dest_body->start = 0;
     if (dest_body->elems > 0) {
-        size_t  mem_size     = dest_body->ssize * repr_data->elem_size;
-        size_t  start_pos    = src_body->start * repr_data->elem_size;
-        char   *copy_start   = ((char *)src_body->slots.any) + start_pos;
-        dest_body->slots.any = MVM_malloc(mem_size);
-        memcpy(dest_body->slots.any, copy_start, mem_size);
+        share_slots(tc, repr_data, src_body, dest_root, dest_body, 0, src_body->elems);
     }
     else {
         dest_body->slots.any = NULL;
@@ -103,7 +158,10 @@ static void VMArray_gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVM
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMArray *arr = (MVMArray *)obj;
-    MVM_free(arr->body.slots.any);
+    if (arr->body.shared)
+        release_shared(arr->body.shared);
+    else
+        MVM_free(arr->body.slots.any);
 }
 
 /* Marks the representation data in an STable.*/
@@ -300,6 +358,63 @@ static MVMuint64 zero_slots(MVMThreadContext *tc, MVMArrayBody *body,
     return elems;
 }
 
+/* Called before an array's slots are written to, to make sure it is not
+ * sharing them. If it is the last sharer it takes the slots back for its
+ * own; otherwise (or if they are a mapped file) it copies the elements it
+ * can see. */
+static void unshare(MVMThreadContext *tc, MVMArrayBody *body, MVMArrayREPRData *repr_data) {
+    MVMArrayShared *shared = body->shared;
+    if (!shared)
+        return;
+    if (shared->read_only)
+        MVM_exception_throw_adhoc(tc, "MVMArray: Cannot modify an array mapped read-only from a file");
+    if (MVM_load(&(shared->refs)) == 1 && !shared->map_size) {
+        /* Nothing else can see the slots now, so clear those outside of
+         * our window, as set_size_internal expects. */
+        body->shared = NULL;
+        body->ssize  = shared->ssize;
+        zero_slots(tc, body, 0, body->start, repr_data->slot_type);
+        zero_slots(tc, body, body->start + body->elems, body->ssize, repr_data->slot_type);
+        MVM_free(shared);
+    }
+    else {
+        size_t  mem_size = body->elems * repr_data->elem_size;
+        void   *slots    = NULL;
+        if (mem_size) {
+            slots = MVM_malloc(mem_size);
+            memcpy(slots, body->slots.u8 + body->start * repr_data->elem_size, mem_size);
+        }
+        body->shared    = NULL;
+        body->slots.any = slots;
+        body->start     = 0;
+        body->ssize     = body->elems;
+        release_shared(shared);
+    }
+}
+void MVM_VMArray_unshare(MVMThreadContext *tc, MVMObject *arr) {
+    unshare(tc, &((MVMArray *)arr)->body, (MVMArrayREPRData *)STABLE(arr)->REPR_data);
+}
+
+/* Makes an empty native array use a file mapped into memory as its slots.
+ * The mapping is released when the array, and any slices of it, are gone. */
+void MVM_VMArray_use_mapping(MVMThreadContext *tc, MVMObject *arr, void *block, void *handle,
+        size_t size, MVMuint8 read_only) {
+    MVMArrayREPRData *repr_data = (MVMArrayREPRData *)STABLE(arr)->REPR_data;
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    MVMArrayShared   *shared    = MVM_malloc(sizeof(MVMArrayShared));
+    shared->refs       = 1;
+    shared->slots      = block;
+    shared->ssize      = size / repr_data->elem_size;
+    shared->map_handle = handle;
+    shared->map_size   = size;
+    shared->read_only  = read_only;
+    body->shared       = shared;
+    body->slots.any    = block;
+    body->start        = 0;
+    body->ssize        = shared->ssize;
+    body->elems        = shared->ssize;
+}
+
 static void set_size_internal(MVMThreadContext *tc, MVMArrayBody *body, MVMuint64 n, MVMArrayREPRData *repr_data) {
     MVMuint64   elems = body->elems;
     MVMuint64   start = body->start;
@@ -379,6 +494,7 @@ static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
 
     /* Handle negative indexes and resizing if needed. */
     enter_single_user(tc, body);
+    unshare(tc, body, repr_data);
     if (index < 0) {
         index += body->elems;
         if (index < 0)
@@ -464,6 +580,7 @@ static void set_elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     MVMArrayBody     *body      = (MVMArrayBody *)data;
     enter_single_user(tc, body);
+    unshare(tc, body, repr_data);
     set_size_internal(tc, body, count, repr_data);
     exit_single_user(tc, body);
 }
@@ -472,6 +589,7 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
     MVMArrayBody     *body      = (MVMArrayBody *)data;
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     enter_single_user(tc, body);
+    unshare(tc, body, repr_data);
     set_size_internal(tc, body, body->elems + 1, repr_data);
     switch (repr_data->slot_type) {
         case MVM_ARRAY_OBJ:
@@ -615,7 +733,9 @@ static void pop(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data
         default:
             MVM_exception_throw_adhoc(tc, "MVMArray: Unhandled slot type");
     }
-    zero_slots(tc, body, slot, slot + 1, repr_data->slot_type);
+    /* Only clear the slot if nothing else can see it. */
+    if (!body->shared)
+        zero_slots(tc, body, slot, slot + 1, repr_data->slot_type);
     exit_single_user(tc, body);
 }
 
@@ -626,6 +746,7 @@ static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     /* If we don't have room at the beginning of the slots,
      * make some room (8 slots) for unshifting */
     enter_single_user(tc, body);
+    unshare(tc, body, repr_data);
     if (body->start < 1) {
         MVMuint64 n = 8;
         MVMuint64 elems = body->elems;
@@ -870,7 +991,15 @@ static void aslice(MVMThreadContext *tc, MVMSTable *st, MVMObject *src, void *da
     }
 
     elems = end - start + 1;
+    if (d_repr_data && d_repr_data->slot_type == ((MVMArrayREPRData *)st->REPR_data)->slot_type
+            && !d_body->slots.any) {
+        /* Slicing into an empty array of the same kind, so it can just be
+         * a view of our slots. */
+        share_slots(tc, d_repr_data, s_body, dest, d_body, start, elems);
+        return;
+    }
     if (d_repr_data) {
+        unshare(tc, d_body, d_repr_data);
         set_size_internal(tc, d_body, elems, d_repr_data);
     }
 
@@ -880,7 +1009,7 @@ static void aslice(MVMThreadContext *tc, MVMSTable *st, MVMObject *src, void *da
 static void write_buf(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, char *from, MVMint64 offset, MVMuint64 count) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *)st->REPR_data;
     MVMArrayBody     *body      = (MVMArrayBody *)data;
-    MVMint64 start = body->start;
+    MVMint64 start;
     MVMint64 elems = body->elems;
 
     /* Throw on negative offset. */
@@ -888,6 +1017,9 @@ static void write_buf(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
         MVM_exception_throw_adhoc(tc, "MVMArray: Index out of bounds");
     }
 
+    unshare(tc, body, repr_data);
+    start = body->start;
+
     /* resize the array if necessary*/
     if (elems < offset + count)
         set_size_internal(tc, body, offset + count, repr_data);
@@ -934,6 +1066,7 @@ static void asplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     }
 
     enter_single_user(tc, body);
+    unshare(tc, body, repr_data);
 
     /* When offset == 0, then we may be able to reduce the memmove
      * calls and reallocs by adjusting SELF's start, elems0, and
@@ -1079,6 +1212,7 @@ static AO_t * pos_as_atomic(MVMThreadContext *tc, MVMSTable *st, MVMObject *root
         index += body->elems;
     if (index < 0 || index >= body->elems)
         MVM_exception_throw_adhoc(tc, "Index out of bounds in atomic operation on array");
+    unshare(tc, body, repr_data);
 
     if (sizeof(AO_t) == 8 && (repr_data->slot_type == MVM_ARRAY_I64 ||
             repr_data->slot_type == MVM_ARRAY_U64))
@@ -1382,6 +1516,10 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *) st->REPR_data;
     MVMArrayBody     *body      = (MVMArrayBody *)data;
+    /* Count shared slots only for the part of them we can see, and mapped
+     * files not at all, since the OS can drop their pages at will. */
+    if (body->shared)
+        return body->shared->map_size ? 0 : body->elems * repr_data->elem_size;
     return body->ssize * repr_data->elem_size;
 }
 
@@ -3,6 +3,27 @@
  * this issue.) */
 #define MVM_ARRAY_CONC_DEBUG 0
 
+/* Slot storage shared between an array and slices (or clones) of it. Each
+ * sharer sees its own window of the slots, and takes a private copy before
+ * it writes; the slots are freed when the last sharer lets go of them. */
+struct MVMArrayShared {
+    /* How many arrays are using the slots. */
+    AO_t refs;
+
+    /* The slots themselves, and how many of them were allocated. */
+    void      *slots;
+    MVMuint64  ssize;
+
+    /* If the slots are a file mapped into memory, the platform's handle
+     * for the mapping and its size in bytes; map_size is 0 otherwise. */
+    void      *map_handle;
+    size_t     map_size;
+
+    /* Whether writing to the array is an error, rather than a reason to
+     * take a copy of the slots. */
+    MVMuint8   read_only;
+};
+
 /* Representation used by VM-level arrays. Adopted from QRPA work by
  * Patrick Michaud. */
 struct MVMArrayBody {
@@ -32,6 +53,10 @@ struct MVMArrayBody {
         void       *any;
     } slots;
 
+    /* If the slots are shared with other arrays, the sharing record; NULL
+     * if this array owns its slots outright. */
+    MVMArrayShared *shared;
+
 #if MVM_ARRAY_CONC_DEBUG
     AO_t in_use;
 #endif 
@@ -75,4 +100,7 @@ struct MVMArrayREPRData {
     /* Type object for the element type. */
     MVMObject *elem_type;
 };
+void MVM_VMArray_unshare(MVMThreadContext *tc, MVMObject *arr);
+void MVM_VMArray_use_mapping(MVMThreadContext *tc, MVMObject *arr, void *block, void *handle,
+    size_t size, MVMuint8 read_only);
 void MVM_VMArray_at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind);
@@ -697,6 +697,9 @@ void MVM_serialization_write_ref(MVMThreadContext *tc, MVMSerializationWriter *w
     else if (REPR(ref)->ID == MVM_REPR_ID_Decoder && IS_CONCRETE(ref)) {
         discrim = REFVAR_VM_NULL;
     }
+    else if (REPR(ref)->ID == MVM_REPR_ID_StringMatcher && IS_CONCRETE(ref)) {
+        discrim = REFVAR_VM_NULL;
+    }
     else if (STABLE(ref) == STABLE(tc->instance->boot_types.BOOTInt) && IS_CONCRETE(ref)) {
         discrim = REFVAR_VM_INT;
     }
@@ -1034,9 +1037,14 @@ static void serialize_stable(MVMThreadContext *tc, MVMSerializationWriter *write
     MVM_serialization_write_ref(tc, writer, st->method_cache);
 
     /* Type check cache. */
-    MVM_serialization_write_int(tc, writer, st->type_check_cache_length);
-    for (i = 0; i < st->type_check_cache_length; i++)
-        MVM_serialization_write_ref(tc, writer, st->type_check_cache[i]);
+    if (st->type_check_cache) {
+        MVM_serialization_write_int(tc, writer, st->type_check_cache->length);
+        for (i = 0; i < st->type_check_cache->length; i++)
+            MVM_serialization_write_ref(tc, writer, st->type_check_cache->types[i]);
+    }
+    else {
+        MVM_serialization_write_int(tc, writer, 0);
+    }
 
     /* Mode flags.
        These are stored as MVMuint16, but currently only the bottom 6 bits are
@@ -2583,6 +2591,7 @@ static void deserialize_stable(MVMThreadContext *tc, MVMSerializationReader *rea
     char *st_table_row = reader->root.stables_table + i * STABLES_TABLE_ENTRY_SIZE;
     MVMuint8 flags;
     MVMuint8 mode;
+    MVMint64 type_check_cache_length;
 
     /* Set STable read position, and set current read buffer to the correct thing. */
     reader->stables_data_offset = read_int32(st_table_row, 4);
@@ -2595,8 +2604,7 @@ static void deserialize_stable(MVMThreadContext *tc, MVMSerializationReader *rea
     if (st->being_repossessed) {
         if (st->REPR->gc_free_repr_data)
             st->REPR->gc_free_repr_data(tc, st);
-        MVM_free(st->type_check_cache);
-        st->type_check_cache = NULL;
+        MVM_6model_set_type_check_cache(tc, st, NULL);
         MVM_free(st->boolification_spec);
         st->boolification_spec = NULL;
         MVM_free(st->invocation_spec);
@@ -2615,11 +2623,13 @@ static void deserialize_stable(MVMThreadContext *tc, MVMSerializationReader *rea
     deserialize_method_cache_lazy(tc, st, reader);
 
     /* Type check cache. */
-    st->type_check_cache_length = MVM_serialization_read_int(tc, reader);
-    if (st->type_check_cache_length > 0) {
-        st->type_check_cache = (MVMObject **)MVM_malloc(st->type_check_cache_length * sizeof(MVMObject *));
-        for (i = 0; i < st->type_check_cache_length; i++)
-            MVM_ASSIGN_REF(tc, &(st->header), st->type_check_cache[i], MVM_serialization_read_ref(tc, reader));
+    type_check_cache_length = MVM_serialization_read_int(tc, reader);
+    if (type_check_cache_length > 0) {
+        MVMTypeCheckCache *cache = MVM_6model_type_check_cache_alloc(tc,
+            (MVMuint16)type_check_cache_length);
+        for (i = 0; i < type_check_cache_length; i++)
+            MVM_ASSIGN_REF(tc, &(st->header), cache->types[i], MVM_serialization_read_ref(tc, reader));
+        MVM_6model_set_type_check_cache(tc, st, cache);
     }
 
     /* Mode flags. */
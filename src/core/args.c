@@ -830,10 +830,13 @@ static void flatten_args(MVMThreadContext *tc, MVMArgProcContext *ctx) {
 
             if (arg_info.arg.o && REPR(arg_info.arg.o)->ID == MVM_REPR_ID_MVMHash) {
                 MVMHashBody *body = &((MVMHash *)arg_info.arg.o)->body;
-                MVMHashEntry *current;
+                MVMuint32 pos;
 
-                HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-                    MVMString *arg_name = MVM_HASH_KEY(current);
+                for (pos = 0; pos < body->num_entries; pos++) {
+                    MVMHashKV *current  = &(body->entries[pos]);
+                    MVMString *arg_name = current->key;
+                    if (!arg_name)
+                        continue;
                     if (!seen_name(tc, arg_name, new_args, new_num_pos, new_arg_pos)) {
                         if (new_arg_pos + 1 >= new_args_size) {
                             new_args = MVM_realloc(new_args, (new_args_size *= 2) * sizeof(MVMRegister));
@@ -846,7 +849,7 @@ static void flatten_args(MVMThreadContext *tc, MVMArgProcContext *ctx) {
                         (new_args + new_arg_pos++)->o = current->value;
                         new_arg_flags[new_flag_pos++] = MVM_CALLSITE_ARG_NAMED | MVM_CALLSITE_ARG_OBJ;
                     }
-                });
+                }
             }
             else if (arg_info.arg.o) {
                 MVM_exception_throw_adhoc(tc, "flattening of other hash reprs NYI.");
@@ -90,7 +90,7 @@ MVMCompUnit * MVM_cu_map_from_file_handle(MVMThreadContext *tc, uv_file fd, MVMu
     block = ((char*)block) + pos;
 
     /* Turn it into a compilation unit. */
-    cu = MVM_cu_from_bytes(tc, (MVMuint8 *)block, (MVMuint32)size);
+    cu = MVM_cu_from_bytes(tc, (MVMuint8 *)block, (MVMuint32)(size - pos));
     cu->body.handle = handle;
     cu->body.deallocate = MVM_DEALLOCATE_UNMAP;
     return cu;
@@ -489,13 +489,23 @@ char * MVM_exception_backtrace_line(MVMThreadContext *tc, MVMFrame *cur_frame,
         ? MVM_string_utf8_encode_C_string(tc, name)
         : "<anonymous frame>";
 
-    snprintf(o, 1024, " %s %s:%u  (%s:%s)",
-        not_top ? "from" : "  at",
-        tmp1 ? tmp1 : "<unknown>",
-        line_number,
-        filename_c,
-        name_c
-    );
+    if (cur_frame->tail_calls_elided)
+        snprintf(o, 1024, " %s %s:%u  (%s:%s)  (%u tail calls elided)",
+            not_top ? "from" : "  at",
+            tmp1 ? tmp1 : "<unknown>",
+            line_number,
+            filename_c,
+            name_c,
+            (MVMuint32)cur_frame->tail_calls_elided
+        );
+    else
+        snprintf(o, 1024, " %s %s:%u  (%s:%s)",
+            not_top ? "from" : "  at",
+            tmp1 ? tmp1 : "<unknown>",
+            line_number,
+            filename_c,
+            name_c
+        );
     if (filename)
         MVM_free(filename_c);
     if (name)
@@ -514,7 +524,8 @@ MVMObject * MVM_exception_backtrace(MVMThreadContext *tc, MVMObject *ex_obj) {
     MVMFrame *cur_frame;
     MVMObject *arr = NULL, *annotations = NULL, *row = NULL, *value = NULL;
     MVMuint32 count = 0;
-    MVMString *k_file = NULL, *k_line = NULL, *k_sub = NULL, *k_anno = NULL;
+    MVMString *k_file = NULL, *k_line = NULL, *k_sub = NULL, *k_anno = NULL,
+              *k_elided = NULL;
     MVMuint8 *throw_address;
 
     if (IS_CONCRETE(ex_obj) && REPR(ex_obj)->ID == MVM_REPR_ID_MVMException) {
@@ -533,12 +544,14 @@ MVMObject * MVM_exception_backtrace(MVMThreadContext *tc, MVMObject *ex_obj) {
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&k_line);
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&k_sub);
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&k_anno);
+    MVM_gc_root_temp_push(tc, (MVMCollectable **)&k_elided);
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&cur_frame);
 
     k_file = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "file");
     k_line = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "line");
     k_sub  = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "sub");
     k_anno = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "annotations");
+    k_elided = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "tail_calls_elided");
 
     arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
 
@@ -573,6 +586,11 @@ MVMObject * MVM_exception_backtrace(MVMThreadContext *tc, MVMObject *ex_obj) {
         row = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
         MVM_repr_bind_key_o(tc, row, k_sub, cur_frame->code_ref);
         MVM_repr_bind_key_o(tc, row, k_anno, annotations);
+        if (cur_frame->tail_calls_elided) {
+            value = MVM_repr_box_int(tc, MVM_hll_current(tc)->int_box_type,
+                cur_frame->tail_calls_elided);
+            MVM_repr_bind_key_o(tc, row, k_elided, value);
+        }
 
         MVM_repr_push_o(tc, arr, row);
         MVM_free(annot);
@@ -583,7 +601,7 @@ MVMObject * MVM_exception_backtrace(MVMThreadContext *tc, MVMObject *ex_obj) {
         count++;
     }
 
-    MVM_gc_root_temp_pop_n(tc, 9);
+    MVM_gc_root_temp_pop_n(tc, 10);
 
     return arr;
 }
@@ -54,6 +54,9 @@ static void prepare_and_verify_static_frame(MVMThreadContext *tc, MVMStaticFrame
         /* Validate the bytecode. */
         MVM_validate_static_frame(tc, static_frame);
 
+        /* See if an earlier run found the frame to be hot. */
+        MVM_spesh_hot_hints_lookup(tc, static_frame);
+
         /* Compute work area initial state that we can memcpy into place each
          * time. */
         if (static_frame_body->num_locals)
@@ -286,6 +289,7 @@ static MVMFrame * allocate_frame(MVMThreadContext *tc, MVMStaticFrame *static_fr
         frame->cur_args_callsite = NULL;
         frame->extra = NULL;
         frame->flags = 0;
+        frame->tail_calls_elided = 0;
     }
 
     /* Allocate space for lexicals and work area. */
@@ -1030,6 +1034,126 @@ MVMuint64 MVM_frame_try_return_no_exit_handlers(MVMThreadContext *tc) {
     return remove_one_frame(tc, 0);
 }
 
+/* Attempts to perform a call in tail position by reusing (for a call to the
+ * very same specialization) or replacing (for any other code object) the
+ * current frame, rather than stacking a new frame on top of it. The new
+ * arguments are moved into the caller's args buffer, which is where the
+ * current frame's own parameters came from, so no allocation is needed and
+ * the GC keeps seeing them. Returns non-zero if the tail call was done, and
+ * zero if a normal invocation must be done instead. */
+static MVMint32 try_tail_call(MVMThreadContext *tc, MVMCode *code, MVMCallsite *callsite,
+                              MVMRegister *args, MVMint32 spesh_cand) {
+    MVMFrame *cur_frame = tc->cur_frame;
+    MVMFrame *caller    = cur_frame->caller;
+    MVMStaticFrame *sf  = code->body.sf;
+    MVMuint32 caller_args_space;
+
+    /* Profiling and debugging want to see every frame, and an unspecialized
+     * caller that is logging wants to see our return. */
+    if (tc->instance->profiling || tc->instance->debugserver)
+        return 0;
+    if (MVM_spesh_log_is_caller_logging(tc))
+        return 0;
+
+    /* The frame must not have any extra state hanging off it, and we must
+     * not be the frame that a (nested) runloop is waiting on. */
+    if (cur_frame->extra || !caller || cur_frame == tc->thread_entry_frame)
+        return 0;
+    if (caller->extra && (caller->extra->special_return || caller->extra->special_unwind))
+        return 0;
+
+    /* The return value would skip our own coercion, so only do it if the
+     * caller expects the same kind of result as we do. */
+    if (caller->return_type != cur_frame->return_type)
+        return 0;
+
+    /* We can only move the args into the caller's buffer if we were given
+     * our parameters in it, they were not flattened, and there's space. */
+    if (callsite->has_flattening || cur_frame->params.arg_flags ||
+            cur_frame->params.args != caller->args || !caller->work)
+        return 0;
+    caller_args_space = caller->allocd_work / sizeof(MVMRegister) -
+        (caller->args - caller->work);
+    if (callsite->arg_count > caller_args_space)
+        return 0;
+
+    /* The target must already be prepared for the current instrumentation
+     * level, since the barrier may need to allocate. */
+    if (sf->body.instrumentation_level != tc->instance->instrumentation_level)
+        return 0;
+
+    /* Resolve the candidate if it wasn't preselected by spesh. */
+    if (spesh_cand < 0)
+        spesh_cand = MVM_spesh_arg_guard_run(tc, sf->body.spesh->body.spesh_arg_guard,
+            callsite, args, NULL);
+
+    if (spesh_cand >= 0 && sf == cur_frame->static_info &&
+            sf->body.spesh->body.spesh_candidates[spesh_cand] == cur_frame->spesh_cand &&
+            (MVMObject *)code == cur_frame->code_ref &&
+            code->body.outer == cur_frame->outer &&
+            !sf->body.has_state_vars &&
+            MVM_FRAME_IS_ON_CALLSTACK(tc, cur_frame)) {
+        /* Self-call of the same code object to the same specialization;
+         * since the frame lives on the callstack, nothing can have captured
+         * it, so we can simply reset it and start over. Frames with state
+         * vars are excluded, since resetting the environment would lose
+         * them. */
+        MVMSpeshCandidate *cand = cur_frame->spesh_cand;
+        MVMJitCode *jitcode     = cand->jitcode;
+        MVMuint8 *bytecode      = jitcode ? jitcode->bytecode : cand->bytecode;
+        memcpy(caller->args, args, callsite->arg_count * sizeof(MVMRegister));
+        caller->cur_args_callsite = callsite;
+        MVM_args_proc_cleanup(tc, &cur_frame->params);
+        MVM_args_proc_init(tc, &cur_frame->params, callsite, caller->args);
+        memset(cur_frame->work, 0, (cur_frame->args - cur_frame->work) * sizeof(MVMRegister));
+        if (cur_frame->env)
+            memset(cur_frame->env, 0, cur_frame->allocd_env);
+        cur_frame->cur_args_callsite = NULL;
+        cur_frame->flags             = 0;
+        if (cur_frame->tail_calls_elided < 0xFFFF)
+            cur_frame->tail_calls_elided++;
+        *(tc->interp_cur_op)         = bytecode;
+        *(tc->interp_bytecode_start) = bytecode;
+        if (jitcode)
+            MVM_jit_code_set_current_position(tc, jitcode, cur_frame, jitcode->labels[0]);
+    }
+    else {
+        /* Sibling call; drop the current frame and invoke the target in its
+         * place, so it will return straight into our caller. The current
+         * frame may have held the only reference to the code object, so it
+         * must be rooted until the invocation has taken it. */
+        MVMuint32 elided = cur_frame->tail_calls_elided + 1;
+        memcpy(caller->args, args, callsite->arg_count * sizeof(MVMRegister));
+        caller->cur_args_callsite = callsite;
+        MVMROOT(tc, code, {
+            remove_one_frame(tc, 0);
+            MVM_frame_invoke(tc, code->body.sf, callsite, caller->args,
+                code->body.outer, (MVMObject *)code, spesh_cand);
+        });
+        tc->cur_frame->tail_calls_elided = elided < 0xFFFF ? elided : 0xFFFF;
+    }
+    return 1;
+}
+
+/* Performs an invocation from tail position, if possible without growing the
+ * call stack. The return address, type, and register of the current frame
+ * must already be set up, as for a normal invocation, since we fall back to
+ * that whenever a tail call can't be done. */
+MVM_USED_BY_JIT
+void MVM_frame_tail_invoke(MVMThreadContext *tc, MVMObject *code, MVMCallsite *callsite,
+                           MVMRegister *args, MVMint32 spesh_cand) {
+    if (spesh_cand < 0)
+        code = MVM_frame_find_invokee_multi_ok(tc, code, &callsite, args, NULL);
+    if (REPR(code)->ID == MVM_REPR_ID_MVMCode && IS_CONCRETE(code)) {
+        if (!try_tail_call(tc, (MVMCode *)code, callsite, args, spesh_cand))
+            MVM_frame_invoke(tc, ((MVMCode *)code)->body.sf, callsite, args,
+                ((MVMCode *)code)->body.outer, code, spesh_cand);
+    }
+    else {
+        STABLE(code)->invoke(tc, code, callsite, args);
+    }
+}
+
 /* Unwinds execution state to the specified frame, placing control flow at either
  * an absolute or relative (to start of target frame) address and optionally
  * setting a returned result. */
@@ -102,6 +102,10 @@ struct MVMFrame {
     MVMuint16 allocd_work;
     MVMuint16 allocd_env;
 
+    /* How many frames were dropped by tail calls made from this frame or
+     * from those it replaced, so backtraces can mention them. */
+    MVMuint16 tail_calls_elided;
+
     /* The current spesh correlation ID, if we're interpreting code and
      * recording logs. Zero if interpreting unspecialized and not recording.
      * Junk if running specialized code. */
@@ -228,6 +232,8 @@ MVMFrame * MVM_frame_create_for_deopt(MVMThreadContext *tc, MVMStaticFrame *stat
                                       MVMCode *code_ref);
 MVM_PUBLIC MVMuint64 MVM_frame_try_return(MVMThreadContext *tc);
 MVM_PUBLIC MVMuint64 MVM_frame_try_return_no_exit_handlers(MVMThreadContext *tc);
+void MVM_frame_tail_invoke(MVMThreadContext *tc, MVMObject *code, MVMCallsite *callsite,
+                           MVMRegister *args, MVMint32 spesh_cand);
 void MVM_frame_unwind_to(MVMThreadContext *tc, MVMFrame *frame, MVMuint8 *abs_addr,
                          MVMuint32 rel_addr, MVMObject *return_value, void *jit_return_label);
 MVM_PUBLIC void MVM_frame_destroy(MVMThreadContext *tc, MVMFrame *frame);
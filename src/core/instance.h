@@ -57,6 +57,7 @@ struct MVMStringConsts {
     MVMString *anon;
     MVMString *P6opaque;
     MVMString *array;
+    MVMString *hash;
     MVMString *box_target;
     MVMString *positional_delegate;
     MVMString *associative_delegate;
@@ -266,6 +267,7 @@ struct MVMInstance {
     MVMint8 spesh_inline_log;
     MVMint8 spesh_osr_enabled;
     MVMint8 spesh_pea_enabled;
+    MVMint8 spesh_tco_enabled;
     MVMint8 spesh_nodelay;
     MVMint8 spesh_blocking;
 
@@ -385,10 +387,27 @@ struct MVMInstance {
     MVMIntConstCache    *int_const_cache;
     uv_mutex_t mutex_int_const_cache;
 
+    /* Weak table of interned strings (see strings/intern.c). */
+    MVMString **interned_strings;
+    MVMuint32   num_interned_slots;
+    MVMuint32   num_interned;
+    uv_mutex_t  mutex_string_intern;
+
     /* Multi-dispatch cache addition mutex (additions are relatively
      * rare, so little motivation to have it more fine-grained). */
     uv_mutex_t mutex_multi_cache_add;
 
+    /* The hash holding the entries of megamorphic multi-dispatch caches, the
+     * last megamorphic cache ID handed out, and the IDs of caches that were
+     * freed, whose entries are dropped when the hash is next copied. All
+     * are only changed with the multi-dispatch cache addition mutex held. */
+    MVMMultiCacheMegaTable *multi_cache_megamorphic;
+    MVMuint64               multi_cache_megamorphic_id;
+    MVM_VECTOR_DECL(MVMuint64, multi_cache_megamorphic_dead);
+
+    /* Whether multi-dispatch caches count their hits and misses. */
+    MVMint8 multi_cache_stats;
+
     /* Next type cache ID, to go in STable. */
     AO_t cur_type_cache_id;
 
@@ -469,6 +488,20 @@ struct MVMInstance {
     MVMLoadedCompUnitName *loaded_compunits;
     uv_mutex_t       mutex_loaded_compunits;
 
+    /* Directory to cache bytecode validation results in, if any, and the
+     * caches of the compunits loaded so far. */
+    char               *validation_cache_dir;
+    MVMValidationCache *validation_caches;
+    uv_mutex_t          mutex_validation_cache;
+
+    /* Directory to note which frames were hot enough to specialize in, if
+     * any, the hints for the compunits loaded so far, and whether they were
+     * written out already. */
+    char             *spesh_hot_hints_dir;
+    MVMSpeshHotHints *spesh_hot_hints;
+    MVMuint8          spesh_hot_hints_written;
+    uv_mutex_t        mutex_spesh_hot_hints;
+
     /* Hash of all loaded DLLs. */
     MVMDLLRegistry  *dll_registry;
     uv_mutex_t mutex_dll_registry;
@@ -4,7 +4,7 @@ void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type) {
     int type_index;
     int right_slot = -1;
     uv_mutex_lock(&tc->instance->mutex_int_const_cache);
-    for (type_index = 0; type_index < 4; type_index++) {
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
         if (tc->instance->int_const_cache->types[type_index] == NULL) {
             right_slot = type_index;
             break;
@@ -15,16 +15,18 @@ void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type) {
         }
     }
     if (right_slot != -1) {
-        int val;
-        for (val = -1; val < 15; val++) {
+        /* The boxes live for as long as the VM does, so allocate them
+         * straight into gen2; that also means we can't trigger a GC run
+         * while holding the mutex. They are marked as instance roots. */
+        MVMint64 val;
+        MVM_gc_allocate_gen2_default_set(tc);
+        for (val = MVM_INTCACHE_MIN; val <= MVM_INTCACHE_MAX; val++) {
             MVMObject *obj;
             obj = MVM_repr_alloc_init(tc, type);
             MVM_repr_set_int(tc, obj, val);
-            tc->instance->int_const_cache->cache[type_index][val + 1] = obj;
-            MVM_gc_root_add_permanent_desc(tc,
-                (MVMCollectable **)&tc->instance->int_const_cache->cache[type_index][val + 1],
-                "Boxed integer cache entry");
+            tc->instance->int_const_cache->cache[type_index][val - MVM_INTCACHE_MIN] = obj;
         }
+        MVM_gc_allocate_gen2_default_clear(tc);
         tc->instance->int_const_cache->types[type_index] = type;
         MVM_gc_root_add_permanent_desc(tc,
             (MVMCollectable **)&tc->instance->int_const_cache->types[type_index],
@@ -37,17 +39,17 @@ MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 valu
     int type_index;
     int right_slot = -1;
 
-    if (value < -1 || value >= 15)
+    if (!MVM_intcache_in_range(value))
         return NULL;
 
-    for (type_index = 0; type_index < 4; type_index++) {
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
         if (tc->instance->int_const_cache->types[type_index] == type) {
             right_slot = type_index;
             break;
         }
     }
     if (right_slot != -1) {
-        return tc->instance->int_const_cache->cache[right_slot][value + 1];
+        return MVM_intcache_at(tc, right_slot, value);
     }
     return NULL;
 }
@@ -56,7 +58,7 @@ MVMint32 MVM_intcache_type_index(MVMThreadContext *tc, MVMObject *type) {
     int type_index;
     int found = -1;
     uv_mutex_lock(&tc->instance->mutex_int_const_cache);
-    for (type_index = 0; type_index < 4; type_index++) {
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
         if (tc->instance->int_const_cache->types[type_index] == type) {
             found = type_index;
             break;
@@ -65,3 +67,53 @@ MVMint32 MVM_intcache_type_index(MVMThreadContext *tc, MVMObject *type) {
     uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
     return found;
 }
+
+/* If the value of a box_i instruction is known at specialization time and
+ * there is a cached box for it, turns the instruction into a read of that
+ * box from a spesh slot. Returns non-zero if it did so. */
+MVMint32 MVM_intcache_spesh_box(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins, MVMObject *type) {
+    MVMSpeshFacts *value_facts = MVM_spesh_get_facts(tc, g, ins->operands[1]);
+    MVMSpeshFacts *tgt_facts;
+    MVMObject     *box;
+    MVMint32       type_index;
+
+    if (!(value_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE)
+            || !MVM_intcache_in_range(value_facts->value.i))
+        return 0;
+    type_index = MVM_intcache_type_index(tc, type);
+    if (type_index < 0)
+        return 0;
+    box = MVM_intcache_at(tc, type_index, value_facts->value.i);
+
+    MVM_spesh_graph_add_comment(tc, g, ins, "cached box of %"PRId64" into a %s",
+        value_facts->value.i, MVM_6model_get_debug_name(tc, type));
+    MVM_spesh_use_facts(tc, g, value_facts);
+    MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[1], ins);
+    MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
+    ins->info = MVM_op_get_op(MVM_OP_sp_getspeshslot);
+    ins->operands[1].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g, (MVMCollectable *)box);
+
+    tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+    tgt_facts->flags |= MVM_SPESH_FACT_KNOWN_TYPE | MVM_SPESH_FACT_CONCRETE
+        | MVM_SPESH_FACT_KNOWN_VALUE;
+    tgt_facts->type    = type;
+    tgt_facts->value.o = box;
+    return 1;
+}
+
+/* Marks the cached boxes. */
+void MVM_intcache_gc_mark(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMHeapSnapshotState *snapshot) {
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
+    MVMuint32 type_index, i;
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++) {
+        if (!cache->types[type_index])
+            continue;
+        for (i = 0; i < MVM_INTCACHE_SIZE; i++) {
+            if (worklist)
+                MVM_gc_worklist_add(tc, worklist, &(cache->cache[type_index][i]));
+            else
+                MVM_profile_heap_add_collectable_rel_const_cstr(tc, snapshot,
+                    (MVMCollectable *)cache->cache[type_index][i], "Boxed integer cache entry");
+        }
+    }
+}
@@ -1,8 +1,34 @@
+/* Range of integers we cache boxes for, and how many types we cache them for.
+ * These may be overridden at build time. */
+#ifndef MVM_INTCACHE_MIN
+#define MVM_INTCACHE_MIN   -128
+#endif
+#ifndef MVM_INTCACHE_MAX
+#define MVM_INTCACHE_MAX   1023
+#endif
+#ifndef MVM_INTCACHE_TYPES
+#define MVM_INTCACHE_TYPES 4
+#endif
+#define MVM_INTCACHE_SIZE  (MVM_INTCACHE_MAX - MVM_INTCACHE_MIN + 1)
+
 struct MVMIntConstCache {
-    MVMObject *types[4];
-    MVMObject *cache[4][16];
+    MVMObject *types[MVM_INTCACHE_TYPES];
+    MVMObject *cache[MVM_INTCACHE_TYPES][MVM_INTCACHE_SIZE];
 };
 
 void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type);
 MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 value);
 MVMint32 MVM_intcache_type_index(MVMThreadContext *tc, MVMObject *type);
+MVMint32 MVM_intcache_spesh_box(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins, MVMObject *type);
+void MVM_intcache_gc_mark(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMHeapSnapshotState *snapshot);
+
+/* Checks if a value has a cached box. */
+MVM_STATIC_INLINE MVMint32 MVM_intcache_in_range(MVMint64 value) {
+    return value >= MVM_INTCACHE_MIN && value <= MVM_INTCACHE_MAX;
+}
+
+/* Gets the cached box of a value, given the type's index in the cache. The
+ * value must be in range. */
+MVM_STATIC_INLINE MVMObject * MVM_intcache_at(MVMThreadContext *tc, MVMint32 type_index, MVMint64 value) {
+    return tc->instance->int_const_cache->cache[type_index][value - MVM_INTCACHE_MIN];
+}
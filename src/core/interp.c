@@ -2569,15 +2569,11 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVMObject *types  = GET_REG(cur_op, 2).o;
                 MVMSTable *st     = STABLE(obj);
                 MVMint64 i, elems = REPR(types)->elems(tc, STABLE(types), types, OBJECT_BODY(types));
-                MVMObject **cache = MVM_malloc(sizeof(MVMObject *) * elems);
+                MVMTypeCheckCache *cache = MVM_6model_type_check_cache_alloc(tc, (MVMuint16)elems);
                 for (i = 0; i < elems; i++) {
-                    MVM_ASSIGN_REF(tc, &(st->header), cache[i], MVM_repr_at_pos_o(tc, types, i));
+                    MVM_ASSIGN_REF(tc, &(st->header), cache->types[i], MVM_repr_at_pos_o(tc, types, i));
                 }
-                /* technically this free isn't thread safe */
-                if (st->type_check_cache)
-                    MVM_free(st->type_check_cache);
-                st->type_check_cache = cache;
-                st->type_check_cache_length = (MVMuint16)elems;
+                MVM_6model_set_type_check_cache(tc, st, cache);
                 MVM_SC_WB_ST(tc, st);
                 cur_op += 4;
                 goto NEXT;
@@ -5614,6 +5610,169 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 GET_REG(cur_op, 0).i64 = MVM_platform_total_memory();
                 cur_op += 2;
                 goto NEXT;
+            OP(vecadd):
+                MVM_vecops_add(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(vecmul):
+                MVM_vecops_mul(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(vecfma):
+                MVM_vecops_fma(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o,
+                    GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            OP(veceq):
+                MVM_vecops_eq(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(veclt):
+                MVM_vecops_lt(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(vecle):
+                MVM_vecops_le(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o);
+                cur_op += 6;
+                goto NEXT;
+            OP(vecsum_i):
+                MVM_vecops_sum(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_int64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecsum_n):
+                MVM_vecops_sum(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_num64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecmin_i):
+                MVM_vecops_min(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_int64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecmin_n):
+                MVM_vecops_min(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_num64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecmax_i):
+                MVM_vecops_max(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_int64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecmax_n):
+                MVM_vecops_max(tc, GET_REG(cur_op, 2).o, &GET_REG(cur_op, 0), MVM_reg_num64);
+                cur_op += 4;
+                goto NEXT;
+            OP(vecdot_i):
+                MVM_vecops_dot(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, &GET_REG(cur_op, 0), MVM_reg_int64);
+                cur_op += 6;
+                goto NEXT;
+            OP(vecdot_n):
+                MVM_vecops_dot(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, &GET_REG(cur_op, 0), MVM_reg_num64);
+                cur_op += 6;
+                goto NEXT;
+            OP(internstr):
+                GET_REG(cur_op, 0).s = MVM_string_intern(tc, GET_REG(cur_op, 2).s);
+                cur_op += 4;
+                goto NEXT;
+            OP(strmatcherconfigure):
+                MVM_string_matcher_configure(tc, GET_REG(cur_op, 0).o,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(strmatcherfirst):
+                GET_REG(cur_op, 0).i64 = MVM_string_matcher_first(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).o);
+                cur_op += 10;
+                goto NEXT;
+            OP(strmatcherall):
+                GET_REG(cur_op, 0).i64 = MVM_string_matcher_all(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).o);
+                cur_op += 10;
+                goto NEXT;
+            OP(unicollkey):
+                GET_REG(cur_op, 0).o = MVM_unicode_string_sort_key(tc,
+                    GET_REG(cur_op, 2).s,   GET_REG(cur_op, 4).i64,
+                    GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64,
+                    GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(atikey_i):
+                MVM_int_hash_at_key(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64,
+                    &GET_REG(cur_op, 0), MVM_reg_int64);
+                cur_op += 6;
+                goto NEXT;
+            OP(atikey_n):
+                MVM_int_hash_at_key(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64,
+                    &GET_REG(cur_op, 0), MVM_reg_num64);
+                cur_op += 6;
+                goto NEXT;
+            OP(atikey_s):
+                MVM_int_hash_at_key(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64,
+                    &GET_REG(cur_op, 0), MVM_reg_str);
+                cur_op += 6;
+                goto NEXT;
+            OP(atikey_o):
+                MVM_int_hash_at_key(tc, GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64,
+                    &GET_REG(cur_op, 0), MVM_reg_obj);
+                cur_op += 6;
+                goto NEXT;
+            OP(bindikey_i): {
+                MVMObject *obj = GET_REG(cur_op, 0).o;
+                MVM_int_hash_bind_key(tc, obj, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4), MVM_reg_int64);
+                MVM_SC_WB_OBJ(tc, obj);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(bindikey_n): {
+                MVMObject *obj = GET_REG(cur_op, 0).o;
+                MVM_int_hash_bind_key(tc, obj, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4), MVM_reg_num64);
+                MVM_SC_WB_OBJ(tc, obj);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(bindikey_s): {
+                MVMObject *obj = GET_REG(cur_op, 0).o;
+                MVM_int_hash_bind_key(tc, obj, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4), MVM_reg_str);
+                MVM_SC_WB_OBJ(tc, obj);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(bindikey_o): {
+                MVMObject *obj = GET_REG(cur_op, 0).o;
+                MVM_int_hash_bind_key(tc, obj, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4), MVM_reg_obj);
+                MVM_SC_WB_OBJ(tc, obj);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(existsikey):
+                GET_REG(cur_op, 0).i64 = MVM_int_hash_exists_key(tc,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(deleteikey): {
+                MVMObject *obj = GET_REG(cur_op, 0).o;
+                MVM_int_hash_delete_key(tc, obj, GET_REG(cur_op, 2).i64);
+                MVM_SC_WB_OBJ(tc, obj);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(iterkey_i): {
+                MVMIter *obj = (MVMIter *)GET_REG(cur_op, 2).o;
+                CHECK_CONC(obj);
+                GET_REG(cur_op, 0).i64 = MVM_iterkey_i(tc, obj);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(multicachestats):
+                GET_REG(cur_op, 0).o = MVM_multi_cache_stats(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(mapfile):
+                MVM_file_map(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).s,
+                    GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
             OP(sp_guard): {
                 MVMRegister *target = &GET_REG(cur_op, 0);
                 MVMObject *check = GET_REG(cur_op, 2).o;
@@ -5886,6 +6045,61 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     code->body.outer, (MVMObject *)code, spesh_cand);
                 goto NEXT;
             }
+            OP(sp_tailinvoke_v): {
+                MVMObject   *code       = GET_REG(cur_op, 0).o;
+                MVMRegister *args       = tc->cur_frame->args;
+                MVMint32     spesh_cand = GET_I16(cur_op, 2);
+                tc->cur_frame->return_value = NULL;
+                tc->cur_frame->return_type  = MVM_RETURN_VOID;
+                cur_op += 4;
+                tc->cur_frame->return_address = cur_op;
+                MVM_frame_tail_invoke(tc, code, cur_callsite, args, spesh_cand);
+                goto NEXT;
+            }
+            OP(sp_tailinvoke_i): {
+                MVMObject   *code       = GET_REG(cur_op, 2).o;
+                MVMRegister *args       = tc->cur_frame->args;
+                MVMint32     spesh_cand = GET_I16(cur_op, 4);
+                tc->cur_frame->return_value = &GET_REG(cur_op, 0);
+                tc->cur_frame->return_type  = MVM_RETURN_INT;
+                cur_op += 6;
+                tc->cur_frame->return_address = cur_op;
+                MVM_frame_tail_invoke(tc, code, cur_callsite, args, spesh_cand);
+                goto NEXT;
+            }
+            OP(sp_tailinvoke_n): {
+                MVMObject   *code       = GET_REG(cur_op, 2).o;
+                MVMRegister *args       = tc->cur_frame->args;
+                MVMint32     spesh_cand = GET_I16(cur_op, 4);
+                tc->cur_frame->return_value = &GET_REG(cur_op, 0);
+                tc->cur_frame->return_type  = MVM_RETURN_NUM;
+                cur_op += 6;
+                tc->cur_frame->return_address = cur_op;
+                MVM_frame_tail_invoke(tc, code, cur_callsite, args, spesh_cand);
+                goto NEXT;
+            }
+            OP(sp_tailinvoke_s): {
+                MVMObject   *code       = GET_REG(cur_op, 2).o;
+                MVMRegister *args       = tc->cur_frame->args;
+                MVMint32     spesh_cand = GET_I16(cur_op, 4);
+                tc->cur_frame->return_value = &GET_REG(cur_op, 0);
+                tc->cur_frame->return_type  = MVM_RETURN_STR;
+                cur_op += 6;
+                tc->cur_frame->return_address = cur_op;
+                MVM_frame_tail_invoke(tc, code, cur_callsite, args, spesh_cand);
+                goto NEXT;
+            }
+            OP(sp_tailinvoke_o): {
+                MVMObject   *code       = GET_REG(cur_op, 2).o;
+                MVMRegister *args       = tc->cur_frame->args;
+                MVMint32     spesh_cand = GET_I16(cur_op, 4);
+                tc->cur_frame->return_value = &GET_REG(cur_op, 0);
+                tc->cur_frame->return_type  = MVM_RETURN_OBJ;
+                cur_op += 6;
+                tc->cur_frame->return_address = cur_op;
+                MVM_frame_tail_invoke(tc, code, cur_callsite, args, spesh_cand);
+                goto NEXT;
+            }
             OP(sp_speshresolve):
                 MVM_spesh_plugin_resolve_spesh(tc, MVM_cu_string(tc, cu, GET_UI32(cur_op, 2)),
                     &GET_REG(cur_op, 0), GET_UI32(cur_op, 6),
@@ -6166,9 +6380,9 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             }
             OP(sp_fastbox_i_ic): {
                 MVMint64 value = GET_REG(cur_op, 8).i64;
-                if (value >= -1 && value < 15) {
+                if (MVM_intcache_in_range(value)) {
                     MVMint16 slot = GET_UI16(cur_op, 10);
-                    GET_REG(cur_op, 0).o = tc->instance->int_const_cache->cache[slot][value + 1];
+                    GET_REG(cur_op, 0).o = MVM_intcache_at(tc, slot, value);
                 }
                 else {
                     MVMObject *obj = fastcreate(tc, cur_op);
@@ -6180,9 +6394,9 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             }
             OP(sp_fastbox_bi_ic): {
                 MVMint64 value = GET_REG(cur_op, 8).i64;
-                if (value >= -1 && value < 15) {
+                if (MVM_intcache_in_range(value)) {
                     MVMint16 slot = GET_UI16(cur_op, 10);
-                    GET_REG(cur_op, 0).o = tc->instance->int_const_cache->cache[slot][value + 1];
+                    GET_REG(cur_op, 0).o = MVM_intcache_at(tc, slot, value);
                 }
                 else {
                     MVMObject *obj = fastcreate(tc, cur_op);
@@ -6334,7 +6548,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             OP(sp_boolify_iter_hash): {
                 MVMIter *iter = (MVMIter *)GET_REG(cur_op, 2).o;
 
-                GET_REG(cur_op, 0).i64 = iter->body.hash_state.next != NULL ? 1 : 0;
+                GET_REG(cur_op, 0).i64 = MVM_iter_istrue(tc, iter);
 
                 cur_op += 4;
                 goto NEXT;
@@ -6370,14 +6584,14 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 if (ba->u.smallint.flag == MVM_BIGINT_32_FLAG && bb->u.smallint.flag == MVM_BIGINT_32_FLAG) {
                     MVMuint64 result = (MVMint64)ba->u.smallint.value + (MVMint64)bb->u.smallint.value;
                     if (MVM_IS_32BIT_INT(result)) {
-                        if (result < -1 || result >= 15) {
+                        if (!MVM_intcache_in_range((MVMint64)result)) {
                             result_obj = fastcreate(tc, cur_op);
                             bc = (MVMP6bigintBody *)((char *)result_obj + offset);
                             bc->u.smallint.value = (MVMint32)result;
                             bc->u.smallint.flag = MVM_BIGINT_32_FLAG;
                         }
                         else {
-                            result_obj = tc->instance->int_const_cache->cache[GET_UI16(cur_op, 12)][result + 1];
+                            result_obj = MVM_intcache_at(tc, GET_UI16(cur_op, 12), (MVMint64)result);
                         }
                     }
                 }
@@ -6401,14 +6615,14 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 if (ba->u.smallint.flag == MVM_BIGINT_32_FLAG && bb->u.smallint.flag == MVM_BIGINT_32_FLAG) {
                     MVMuint64 result = (MVMint64)ba->u.smallint.value - (MVMint64)bb->u.smallint.value;
                     if (MVM_IS_32BIT_INT(result)) {
-                        if (result < -1 || result >= 15) {
+                        if (!MVM_intcache_in_range((MVMint64)result)) {
                             result_obj = fastcreate(tc, cur_op);
                             bc = (MVMP6bigintBody *)((char *)result_obj + offset);
                             bc->u.smallint.value = (MVMint32)result;
                             bc->u.smallint.flag = MVM_BIGINT_32_FLAG;
                         }
                         else {
-                            result_obj = tc->instance->int_const_cache->cache[GET_UI16(cur_op, 12)][result + 1];
+                            result_obj = MVM_intcache_at(tc, GET_UI16(cur_op, 12), (MVMint64)result);
                         }
                     }
                 }
@@ -6432,14 +6646,14 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 if (ba->u.smallint.flag == MVM_BIGINT_32_FLAG && bb->u.smallint.flag == MVM_BIGINT_32_FLAG) {
                     MVMuint64 result = (MVMint64)ba->u.smallint.value * (MVMint64)bb->u.smallint.value;
                     if (MVM_IS_32BIT_INT(result)) {
-                        if (result < -1 || result >= 15) {
+                        if (!MVM_intcache_in_range((MVMint64)result)) {
                             result_obj = fastcreate(tc, cur_op);
                             bc = (MVMP6bigintBody *)((char *)result_obj + offset);
                             bc->u.smallint.value = (MVMint32)result;
                             bc->u.smallint.flag = MVM_BIGINT_32_FLAG;
                         }
                         else {
-                            result_obj = tc->instance->int_const_cache->cache[GET_UI16(cur_op, 12)][result + 1];
+                            result_obj = MVM_intcache_at(tc, GET_UI16(cur_op, 12), (MVMint64)result);
                         }
                     }
                 }
@@ -363,7 +363,16 @@ void * MVM_nativecall_unmarshal_vmarray(MVMThreadContext *tc, MVMObject *value)
     else if (REPR(value)->ID == MVM_REPR_ID_VMArray) {
         MVMArrayBody *body          = &((MVMArray *)value)->body;
         MVMArrayREPRData *repr_data = (MVMArrayREPRData *)STABLE(value)->REPR_data;
-        size_t start_pos            = body->start * repr_data->elem_size;
+        MVMArrayShared   *shared    = body->shared;
+        size_t start_pos;
+        /* The native code may write to the array, so if its slots are a
+         * heap buffer another array can see, it gets a copy of its own.
+         * Slots of a mapped file are passed as they are: writing to a
+         * read-only mapping faults as it would for any other memory, and
+         * copying a whole file on each call would defeat mapping it. */
+        if (shared && !shared->map_size && MVM_load(&(shared->refs)) > 1)
+            MVM_VMArray_unshare(tc, value);
+        start_pos = body->start * repr_data->elem_size;
         return ((char *)body->slots.any) + start_pos;
     }
     else
@@ -461,14 +470,41 @@ MVMJitGraph *MVM_nativecall_jit_graph_for_caller_code(
     jg->last_node = unblock_gc_node->next = box_rv_node;
 
     if (0 < body->num_args) {
-        MVMuint16 i = 0, str_arg_count = 0;
+        MVMuint16 i = 0, stack_arg_count = 0;
         call_node->u.call.args = MVM_spesh_alloc(tc, sg, body->num_args * sizeof(MVMJitCallArg));
         for (i = 0; i < body->num_args; i++) {
-            if ((body->arg_types[i] & MVM_NATIVECALL_ARG_TYPE_MASK) == MVM_NATIVECALL_ARG_UTF8STR) {
+            if ((body->arg_types[i] & MVM_NATIVECALL_ARG_TYPE_MASK) == MVM_NATIVECALL_ARG_VMARRAY) {
+                /* Unmarshal arrays with a call too, as they may need to stop
+                 * sharing their slots, and the slots may not start at the
+                 * first element. */
+                MVMJitNode *unmarshal_node;
+
+                if (7 < ++stack_arg_count) /* only got 7 empty slots in the stack scratch space */
+                    goto fail;
+
+                unmarshal_node = MVM_spesh_alloc(tc, sg, sizeof(MVMJitNode));
+                {
+                    MVMJitCallArg unmarshal_args[] = {
+                        { MVM_JIT_INTERP_VAR , { MVM_JIT_INTERP_TC } },
+                        {
+                            dst == -1 ? MVM_JIT_ARG_I64 : MVM_JIT_PARAM_I64 ,
+                            { dst == -1 ? i : arg_ins[i]->operands[1].reg.orig }
+                        }
+                    };
+                    init_c_call_node(tc, sg, unmarshal_node, &MVM_nativecall_unmarshal_vmarray, 2, unmarshal_args);
+                    save_rv_to_stack(tc, unmarshal_node, stack_arg_count);
+                }
+                unmarshal_node->next = jg->first_node;
+                jg->first_node = unmarshal_node;
+
+                call_node->u.call.args[i].type = MVM_JIT_STACK_VALUE;
+                call_node->u.call.args[i].v.lit_i64 = stack_arg_count;
+            }
+            else if ((body->arg_types[i] & MVM_NATIVECALL_ARG_TYPE_MASK) == MVM_NATIVECALL_ARG_UTF8STR) {
                 MVMJitNode *unbox_str_node;
                 MVMJitNode *free_str_node;
 
-                if (7 < ++str_arg_count) /* only got 7 empty slots in the stack scratch space */
+                if (7 < ++stack_arg_count) /* only got 7 empty slots in the stack scratch space */
                     goto fail;
 
                 unbox_str_node = MVM_spesh_alloc(tc, sg, sizeof(MVMJitNode));
@@ -481,17 +517,17 @@ MVMJitGraph *MVM_nativecall_jit_graph_for_caller_code(
                         }
                     };
                     init_c_call_node(tc, sg, unbox_str_node, &MVM_string_utf8_maybe_encode_C_string, 2, unbox_str_args);
-                    save_rv_to_stack(tc, unbox_str_node, str_arg_count);
+                    save_rv_to_stack(tc, unbox_str_node, stack_arg_count);
                 }
                 unbox_str_node->next = jg->first_node;
                 jg->first_node = unbox_str_node;
 
                 call_node->u.call.args[i].type = MVM_JIT_STACK_VALUE;
-                call_node->u.call.args[i].v.lit_i64 = str_arg_count;
+                call_node->u.call.args[i].v.lit_i64 = stack_arg_count;
 
                 if ((body->arg_types[i] & MVM_NATIVECALL_ARG_FREE_STR_MASK) != 0) {
                     MVMJitCallArg free_str_args[] = {
-                        { MVM_JIT_STACK_VALUE , { str_arg_count } }
+                        { MVM_JIT_STACK_VALUE , { stack_arg_count } }
                     };
                     free_str_node = MVM_spesh_alloc(tc, sg, sizeof(MVMJitNode));
                     init_c_call_node(tc, sg, free_str_node, &MVM_free, 1, free_str_args);
@@ -535,9 +571,6 @@ MVMJitGraph *MVM_nativecall_jit_graph_for_caller_code(
                     arg_type = dst == -1 ? MVM_JIT_ARG_PTR : MVM_JIT_PARAM_PTR;
                     break;
                 case MVM_NATIVECALL_ARG_VMARRAY:
-                    if (is_rw) goto fail;
-                    arg_type = dst == -1 ? MVM_JIT_ARG_VMARRAY : MVM_JIT_PARAM_VMARRAY;
-                    break;
                 case MVM_NATIVECALL_ARG_UTF8STR:
                     if (is_rw) goto fail;
                     continue; /* already handled */
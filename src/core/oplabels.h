@@ -824,6 +824,38 @@ static const void * const LABELS[] = {
     &&OP_uname,
     &&OP_freemem,
     &&OP_totalmem,
+    &&OP_vecadd,
+    &&OP_vecmul,
+    &&OP_vecfma,
+    &&OP_veceq,
+    &&OP_veclt,
+    &&OP_vecle,
+    &&OP_vecsum_i,
+    &&OP_vecsum_n,
+    &&OP_vecmin_i,
+    &&OP_vecmin_n,
+    &&OP_vecmax_i,
+    &&OP_vecmax_n,
+    &&OP_vecdot_i,
+    &&OP_vecdot_n,
+    &&OP_internstr,
+    &&OP_strmatcherconfigure,
+    &&OP_strmatcherfirst,
+    &&OP_strmatcherall,
+    &&OP_unicollkey,
+    &&OP_atikey_i,
+    &&OP_atikey_n,
+    &&OP_atikey_s,
+    &&OP_atikey_o,
+    &&OP_bindikey_i,
+    &&OP_bindikey_n,
+    &&OP_bindikey_s,
+    &&OP_bindikey_o,
+    &&OP_existsikey,
+    &&OP_deleteikey,
+    &&OP_iterkey_i,
+    &&OP_multicachestats,
+    &&OP_mapfile,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -850,6 +882,11 @@ static const void * const LABELS[] = {
     &&OP_sp_fastinvoke_n,
     &&OP_sp_fastinvoke_s,
     &&OP_sp_fastinvoke_o,
+    &&OP_sp_tailinvoke_v,
+    &&OP_sp_tailinvoke_i,
+    &&OP_sp_tailinvoke_n,
+    &&OP_sp_tailinvoke_s,
+    &&OP_sp_tailinvoke_o,
     &&OP_sp_speshresolve,
     &&OP_sp_paramnamesused,
     &&OP_sp_getspeshslot,
@@ -988,43 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
@@ -824,102 +824,139 @@
 #define MVM_OP_uname 820
 #define MVM_OP_freemem 821
 #define MVM_OP_totalmem 822
-#define MVM_OP_sp_guard 823
-#define MVM_OP_sp_guardconc 824
-#define MVM_OP_sp_guardtype 825
-#define MVM_OP_sp_guardsf 826
-#define MVM_OP_sp_guardsfouter 827
-#define MVM_OP_sp_guardobj 828
-#define MVM_OP_sp_guardnotobj 829
-#define MVM_OP_sp_guardjustconc 830
-#define MVM_OP_sp_guardjusttype 831
-#define MVM_OP_sp_rebless 832
-#define MVM_OP_sp_resolvecode 833
-#define MVM_OP_sp_decont 834
-#define MVM_OP_sp_getlex_o 835
-#define MVM_OP_sp_getlex_ins 836
-#define MVM_OP_sp_getlex_no 837
-#define MVM_OP_sp_bindlex_in 838
-#define MVM_OP_sp_bindlex_os 839
-#define MVM_OP_sp_getarg_o 840
-#define MVM_OP_sp_getarg_i 841
-#define MVM_OP_sp_getarg_n 842
-#define MVM_OP_sp_getarg_s 843
-#define MVM_OP_sp_fastinvoke_v 844
-#define MVM_OP_sp_fastinvoke_i 845
-#define MVM_OP_sp_fastinvoke_n 846
-#define MVM_OP_sp_fastinvoke_s 847
-#define MVM_OP_sp_fastinvoke_o 848
-#define MVM_OP_sp_speshresolve 849
-#define MVM_OP_sp_paramnamesused 850
-#define MVM_OP_sp_getspeshslot 851
-#define MVM_OP_sp_findmeth 852
-#define MVM_OP_sp_fastcreate 853
-#define MVM_OP_sp_get_o 854
-#define MVM_OP_sp_get_i64 855
-#define MVM_OP_sp_get_i32 856
-#define MVM_OP_sp_get_i16 857
-#define MVM_OP_sp_get_i8 858
-#define MVM_OP_sp_get_n 859
-#define MVM_OP_sp_get_s 860
-#define MVM_OP_sp_bind_o 861
-#define MVM_OP_sp_bind_i64 862
-#define MVM_OP_sp_bind_i32 863
-#define MVM_OP_sp_bind_i16 864
-#define MVM_OP_sp_bind_i8 865
-#define MVM_OP_sp_bind_n 866
-#define MVM_OP_sp_bind_s 867
-#define MVM_OP_sp_bind_s_nowb 868
-#define MVM_OP_sp_p6oget_o 869
-#define MVM_OP_sp_p6ogetvt_o 870
-#define MVM_OP_sp_p6ogetvc_o 871
-#define MVM_OP_sp_p6oget_i 872
-#define MVM_OP_sp_p6oget_n 873
-#define MVM_OP_sp_p6oget_s 874
-#define MVM_OP_sp_p6oget_bi 875
-#define MVM_OP_sp_p6obind_o 876
-#define MVM_OP_sp_p6obind_i 877
-#define MVM_OP_sp_p6obind_n 878
-#define MVM_OP_sp_p6obind_s 879
-#define MVM_OP_sp_p6oget_i32 880
-#define MVM_OP_sp_p6obind_i32 881
-#define MVM_OP_sp_getvt_o 882
-#define MVM_OP_sp_getvc_o 883
-#define MVM_OP_sp_fastbox_i 884
-#define MVM_OP_sp_fastbox_bi 885
-#define MVM_OP_sp_fastbox_i_ic 886
-#define MVM_OP_sp_fastbox_bi_ic 887
-#define MVM_OP_sp_deref_get_i64 888
-#define MVM_OP_sp_deref_get_n 889
-#define MVM_OP_sp_deref_bind_i64 890
-#define MVM_OP_sp_deref_bind_n 891
-#define MVM_OP_sp_getlexvia_o 892
-#define MVM_OP_sp_getlexvia_ins 893
-#define MVM_OP_sp_bindlexvia_os 894
-#define MVM_OP_sp_bindlexvia_in 895
-#define MVM_OP_sp_getstringfrom 896
-#define MVM_OP_sp_getwvalfrom 897
-#define MVM_OP_sp_jit_enter 898
-#define MVM_OP_sp_boolify_iter 899
-#define MVM_OP_sp_boolify_iter_arr 900
-#define MVM_OP_sp_boolify_iter_hash 901
-#define MVM_OP_sp_cas_o 902
-#define MVM_OP_sp_atomicload_o 903
-#define MVM_OP_sp_atomicstore_o 904
-#define MVM_OP_sp_add_I 905
-#define MVM_OP_sp_sub_I 906
-#define MVM_OP_sp_mul_I 907
-#define MVM_OP_sp_bool_I 908
-#define MVM_OP_prof_enter 909
-#define MVM_OP_prof_enterspesh 910
-#define MVM_OP_prof_enterinline 911
-#define MVM_OP_prof_enternative 912
-#define MVM_OP_prof_exit 913
-#define MVM_OP_prof_allocated 914
-#define MVM_OP_prof_replaced 915
-#define MVM_OP_ctw_check 916
-#define MVM_OP_coverage_log 917
-#define MVM_OP_breakpoint 918
+#define MVM_OP_vecadd 823
+#define MVM_OP_vecmul 824
+#define MVM_OP_vecfma 825
+#define MVM_OP_veceq 826
+#define MVM_OP_veclt 827
+#define MVM_OP_vecle 828
+#define MVM_OP_vecsum_i 829
+#define MVM_OP_vecsum_n 830
+#define MVM_OP_vecmin_i 831
+#define MVM_OP_vecmin_n 832
+#define MVM_OP_vecmax_i 833
+#define MVM_OP_vecmax_n 834
+#define MVM_OP_vecdot_i 835
+#define MVM_OP_vecdot_n 836
+#define MVM_OP_internstr 837
+#define MVM_OP_strmatcherconfigure 838
+#define MVM_OP_strmatcherfirst 839
+#define MVM_OP_strmatcherall 840
+#define MVM_OP_unicollkey 841
+#define MVM_OP_atikey_i 842
+#define MVM_OP_atikey_n 843
+#define MVM_OP_atikey_s 844
+#define MVM_OP_atikey_o 845
+#define MVM_OP_bindikey_i 846
+#define MVM_OP_bindikey_n 847
+#define MVM_OP_bindikey_s 848
+#define MVM_OP_bindikey_o 849
+#define MVM_OP_existsikey 850
+#define MVM_OP_deleteikey 851
+#define MVM_OP_iterkey_i 852
+#define MVM_OP_multicachestats 853
+#define MVM_OP_mapfile 854
+#define MVM_OP_sp_guard 855
+#define MVM_OP_sp_guardconc 856
+#define MVM_OP_sp_guardtype 857
+#define MVM_OP_sp_guardsf 858
+#define MVM_OP_sp_guardsfouter 859
+#define MVM_OP_sp_guardobj 860
+#define MVM_OP_sp_guardnotobj 861
+#define MVM_OP_sp_guardjustconc 862
+#define MVM_OP_sp_guardjusttype 863
+#define MVM_OP_sp_rebless 864
+#define MVM_OP_sp_resolvecode 865
+#define MVM_OP_sp_decont 866
+#define MVM_OP_sp_getlex_o 867
+#define MVM_OP_sp_getlex_ins 868
+#define MVM_OP_sp_getlex_no 869
+#define MVM_OP_sp_bindlex_in 870
+#define MVM_OP_sp_bindlex_os 871
+#define MVM_OP_sp_getarg_o 872
+#define MVM_OP_sp_getarg_i 873
+#define MVM_OP_sp_getarg_n 874
+#define MVM_OP_sp_getarg_s 875
+#define MVM_OP_sp_fastinvoke_v 876
+#define MVM_OP_sp_fastinvoke_i 877
+#define MVM_OP_sp_fastinvoke_n 878
+#define MVM_OP_sp_fastinvoke_s 879
+#define MVM_OP_sp_fastinvoke_o 880
+#define MVM_OP_sp_tailinvoke_v 881
+#define MVM_OP_sp_tailinvoke_i 882
+#define MVM_OP_sp_tailinvoke_n 883
+#define MVM_OP_sp_tailinvoke_s 884
+#define MVM_OP_sp_tailinvoke_o 885
+#define MVM_OP_sp_speshresolve 886
+#define MVM_OP_sp_paramnamesused 887
+#define MVM_OP_sp_getspeshslot 888
+#define MVM_OP_sp_findmeth 889
+#define MVM_OP_sp_fastcreate 890
+#define MVM_OP_sp_get_o 891
+#define MVM_OP_sp_get_i64 892
+#define MVM_OP_sp_get_i32 893
+#define MVM_OP_sp_get_i16 894
+#define MVM_OP_sp_get_i8 895
+#define MVM_OP_sp_get_n 896
+#define MVM_OP_sp_get_s 897
+#define MVM_OP_sp_bind_o 898
+#define MVM_OP_sp_bind_i64 899
+#define MVM_OP_sp_bind_i32 900
+#define MVM_OP_sp_bind_i16 901
+#define MVM_OP_sp_bind_i8 902
+#define MVM_OP_sp_bind_n 903
+#define MVM_OP_sp_bind_s 904
+#define MVM_OP_sp_bind_s_nowb 905
+#define MVM_OP_sp_p6oget_o 906
+#define MVM_OP_sp_p6ogetvt_o 907
+#define MVM_OP_sp_p6ogetvc_o 908
+#define MVM_OP_sp_p6oget_i 909
+#define MVM_OP_sp_p6oget_n 910
+#define MVM_OP_sp_p6oget_s 911
+#define MVM_OP_sp_p6oget_bi 912
+#define MVM_OP_sp_p6obind_o 913
+#define MVM_OP_sp_p6obind_i 914
+#define MVM_OP_sp_p6obind_n 915
+#define MVM_OP_sp_p6obind_s 916
+#define MVM_OP_sp_p6oget_i32 917
+#define MVM_OP_sp_p6obind_i32 918
+#define MVM_OP_sp_getvt_o 919
+#define MVM_OP_sp_getvc_o 920
+#define MVM_OP_sp_fastbox_i 921
+#define MVM_OP_sp_fastbox_bi 922
+#define MVM_OP_sp_fastbox_i_ic 923
+#define MVM_OP_sp_fastbox_bi_ic 924
+#define MVM_OP_sp_deref_get_i64 925
+#define MVM_OP_sp_deref_get_n 926
+#define MVM_OP_sp_deref_bind_i64 927
+#define MVM_OP_sp_deref_bind_n 928
+#define MVM_OP_sp_getlexvia_o 929
+#define MVM_OP_sp_getlexvia_ins 930
+#define MVM_OP_sp_bindlexvia_os 931
+#define MVM_OP_sp_bindlexvia_in 932
+#define MVM_OP_sp_getstringfrom 933
+#define MVM_OP_sp_getwvalfrom 934
+#define MVM_OP_sp_jit_enter 935
+#define MVM_OP_sp_boolify_iter 936
+#define MVM_OP_sp_boolify_iter_arr 937
+#define MVM_OP_sp_boolify_iter_hash 938
+#define MVM_OP_sp_cas_o 939
+#define MVM_OP_sp_atomicload_o 940
+#define MVM_OP_sp_atomicstore_o 941
+#define MVM_OP_sp_add_I 942
+#define MVM_OP_sp_sub_I 943
+#define MVM_OP_sp_mul_I 944
+#define MVM_OP_sp_bool_I 945
+#define MVM_OP_prof_enter 946
+#define MVM_OP_prof_enterspesh 947
+#define MVM_OP_prof_enterinline 948
+#define MVM_OP_prof_enternative 949
+#define MVM_OP_prof_exit 950
+#define MVM_OP_prof_allocated 951
+#define MVM_OP_prof_replaced 952
+#define MVM_OP_ctw_check 953
+#define MVM_OP_coverage_log 954
+#define MVM_OP_breakpoint 955
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
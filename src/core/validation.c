@@ -662,6 +662,10 @@ void MVM_validate_static_frame(MVMThreadContext *tc,
     MVMStaticFrameBody *fb = &static_frame->body;
     Validator val[1];
 
+    /* Nothing to do if an earlier run already found the frame valid. */
+    if (MVM_validation_cache_lookup(tc, static_frame))
+        return;
+
     val->tc        = tc;
     val->cu        = fb->cu;
     val->frame     = static_frame;
@@ -725,6 +729,8 @@ void MVM_validate_static_frame(MVMThreadContext *tc,
     validate_branch_targets(val);
     validate_final_return(val);
 
-    /* Validation successful. Clear up instruction offsets. */
+    /* Validation successful. Clear up instruction offsets, and remember the
+     * result for future runs. */
     MVM_free(val->labels);
+    MVM_validation_cache_add(tc, static_frame);
 }
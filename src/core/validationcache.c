@@ -0,0 +1,259 @@
+#include "moar.h"
+#include <sha1.h>
+
+/* Validating bytecode is done the first time each frame is invoked, which
+ * for large, precompiled module trees adds up to a noticeable part of the
+ * startup time. When MVM_VALIDATION_CACHE is set to a directory, we record
+ * there which frames of each compilation unit loaded from a file passed
+ * validation, so later runs can skip validating them again. */
+
+/* Magic at the start of a cache file; bump it if the format changes. */
+static const char MAGIC[MVM_VALIDATION_CACHE_MAGIC_SIZE] = { 'M', 'V', 'M', 'V', 'A', 'L', '0', '1' };
+
+static int cmp_entries(const void *a, const void *b) {
+    MVMuint32 x = *(const MVMuint32 *)a & ~MVM_VALIDATION_CACHE_SPECIALIZABLE;
+    MVMuint32 y = *(const MVMuint32 *)b & ~MVM_VALIDATION_CACHE_SPECIALIZABLE;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/* Finds an entry for a frame offset in sorted entries. */
+MVMuint32 * MVM_validation_cache_find_entry(MVMuint32 *entries, MVMuint32 num, MVMuint32 offset) {
+    return num ? bsearch(&offset, entries, num, sizeof(MVMuint32), cmp_entries) : NULL;
+}
+
+static char * cache_file_name(const char *dir, const char *hash, const char *ext, const char *suffix) {
+    size_t len = strlen(dir) + strlen(hash) + strlen(ext) + strlen(suffix) + 2;
+    char *name = MVM_malloc(len);
+    snprintf(name, len, "%s/%s%s%s", dir, hash, ext, suffix);
+    return name;
+}
+
+/* Gets the hex SHA-1 that identifies a compilation unit in the cache
+ * directories. It is computed the first time any of the caches asks for it
+ * and then kept on the compilation unit; should two threads race to compute
+ * it, the loser frees its copy. */
+const char * MVM_validation_cache_hash(MVMThreadContext *tc, MVMCompUnit *cu) {
+    char *hash = (char *)MVM_load(&cu->body.cache_hash);
+    if (!hash) {
+        MVMuint16    num_ops = 0;
+        SHA1Context  context;
+        while (MVM_op_get_op(num_ops))
+            num_ops++;
+        hash = MVM_malloc(41);
+        SHA1Init(&context);
+        SHA1Update(&context, (unsigned char *)MVM_VERSION, strlen(MVM_VERSION));
+        SHA1Update(&context, (unsigned char *)&num_ops, sizeof(num_ops));
+        SHA1Update(&context, cu->body.data_start, cu->body.data_size);
+        SHA1Final(&context, hash);
+        if (MVM_casptr(&cu->body.cache_hash, NULL, hash) != NULL) {
+            MVM_free(hash);
+            hash = (char *)MVM_load(&cu->body.cache_hash);
+        }
+    }
+    return hash;
+}
+
+/* Reads the entries of a cache file, if there is one, returning them and
+ * setting *num; returns NULL if the file is missing or not valid. */
+MVMuint32 * MVM_validation_cache_read_entries(const char *dir, const char *hash,
+        const char *ext, const char *magic, MVMuint32 *num) {
+    char      *name    = cache_file_name(dir, hash, ext, "");
+    FILE      *fh      = fopen(name, "rb");
+    MVMuint32 *entries = NULL;
+    MVM_free(name);
+    *num = 0;
+    if (fh) {
+        char      found[MVM_VALIDATION_CACHE_MAGIC_SIZE];
+        MVMuint32 count;
+        if (fread(found, sizeof(found), 1, fh) == 1 && memcmp(found, magic, sizeof(found)) == 0
+                && fread(&count, sizeof(MVMuint32), 1, fh) == 1 && count > 0) {
+            entries = MVM_malloc(count * sizeof(MVMuint32));
+            if (fread(entries, sizeof(MVMuint32), count, fh) == count) {
+                *num = count;
+            }
+            else {
+                MVM_free(entries);
+                entries = NULL;
+            }
+        }
+        fclose(fh);
+    }
+    return entries;
+}
+
+/* Merges the entries already known with those added during this run, and
+ * writes them out. Files are written under a temporary name and then renamed
+ * into place, so concurrently running processes never see a partial file. */
+void MVM_validation_cache_write_entries(const char *dir, const char *hash,
+        const char *ext, const char *magic, MVMuint32 *known, MVMuint32 num_known,
+        MVMuint32 *added, MVMuint32 num_added) {
+    MVMuint32  num     = num_known + num_added;
+    MVMuint32  i, j;
+    MVMuint32 *entries;
+    char      *temp;
+    char       suffix[32];
+    FILE      *fh;
+    if (!num_added)
+        return;
+    entries = MVM_malloc(num * sizeof(MVMuint32));
+    if (num_known)
+        memcpy(entries, known, num_known * sizeof(MVMuint32));
+    memcpy(entries + num_known, added, num_added * sizeof(MVMuint32));
+    qsort(entries, num, sizeof(MVMuint32), cmp_entries);
+    for (i = 1, j = 1; i < num; i++)
+        if (cmp_entries(&entries[i], &entries[j - 1]) != 0)
+            entries[j++] = entries[i];
+    num = j;
+
+    snprintf(suffix, sizeof(suffix), ".%"PRIi64".tmp", MVM_proc_getpid(NULL));
+    temp = cache_file_name(dir, hash, ext, suffix);
+    fh   = fopen(temp, "wb");
+    if (fh) {
+        int ok = fwrite(magic, MVM_VALIDATION_CACHE_MAGIC_SIZE, 1, fh) == 1
+            && fwrite(&num, sizeof(MVMuint32), 1, fh) == 1
+            && fwrite(entries, sizeof(MVMuint32), num, fh) == num;
+        if (fclose(fh) == 0 && ok) {
+            char    *name = cache_file_name(dir, hash, ext, "");
+            uv_fs_t  req;
+            if (uv_fs_rename(NULL, &req, temp, name, NULL) < 0)
+                remove(temp);
+            uv_fs_req_cleanup(&req);
+            MVM_free(name);
+        }
+        else {
+            remove(temp);
+        }
+    }
+    MVM_free(temp);
+    MVM_free(entries);
+}
+
+/* Gets the validation cache of a compilation unit, setting it up the first
+ * time. Returns NULL if the compilation unit can't be cached, because it was
+ * not loaded from a file. The hashing and reading of the cache file are done
+ * without holding the lock; should another thread have set up the cache in
+ * the meantime, we use its cache and throw ours away. */
+static MVMValidationCache * get_cache(MVMThreadContext *tc, MVMCompUnit *cu) {
+    MVMInstance        *instance = tc->instance;
+    MVMValidationCache *cache;
+    MVMuint8            checked;
+
+    uv_mutex_lock(&instance->mutex_validation_cache);
+    checked = cu->body.validation_cache_checked;
+    cache   = cu->body.validation_cache;
+    uv_mutex_unlock(&instance->mutex_validation_cache);
+    if (checked)
+        return cache;
+
+    if (cu->body.deallocate == MVM_DEALLOCATE_UNMAP) {
+        cache = MVM_calloc(1, sizeof(MVMValidationCache));
+        memcpy(cache->hash, MVM_validation_cache_hash(tc, cu), sizeof(cache->hash));
+        cache->known = MVM_validation_cache_read_entries(instance->validation_cache_dir,
+            cache->hash, ".valid", MAGIC, &(cache->num_known));
+    }
+
+    uv_mutex_lock(&instance->mutex_validation_cache);
+    if (cu->body.validation_cache_checked) {
+        if (cache) {
+            MVM_free(cache->known);
+            MVM_free(cache);
+        }
+    }
+    else {
+        if (cache) {
+            cache->next = instance->validation_caches;
+            instance->validation_caches = cache;
+        }
+        cu->body.validation_cache = cache;
+        cu->body.validation_cache_checked = 1;
+    }
+    cache = cu->body.validation_cache;
+    uv_mutex_unlock(&instance->mutex_validation_cache);
+    return cache;
+}
+
+/* Gets the offset that identifies a static frame within its compilation
+ * unit, or -1 if it has none (for example, if it was created at runtime). */
+MVMint64 MVM_validation_cache_frame_offset(MVMStaticFrame *sf) {
+    MVMStaticFrameBody *fb = &sf->body;
+    MVMCompUnitBody    *cb = &fb->cu->body;
+    if (fb->orig_bytecode < cb->data_start
+            || fb->orig_bytecode + fb->bytecode_size > cb->data_start + cb->data_size
+            || fb->orig_bytecode - cb->data_start >= MVM_VALIDATION_CACHE_SPECIALIZABLE)
+        return -1;
+    return fb->orig_bytecode - cb->data_start;
+}
+
+/* Checks if a static frame is known to pass validation. If so, sets up the
+ * things that validation would otherwise have, and returns non-zero. */
+MVMint32 MVM_validation_cache_lookup(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMStaticFrameBody *fb = &sf->body;
+    MVMCompUnit        *cu = fb->cu;
+    MVMValidationCache *cache;
+    MVMint64            offset;
+    MVMuint32          *found;
+    MVMuint16           i;
+
+    if (!tc->instance->validation_cache_dir)
+        return 0;
+    cache = get_cache(tc, cu);
+    if (!cache || (offset = MVM_validation_cache_frame_offset(sf)) < 0)
+        return 0;
+    found = MVM_validation_cache_find_entry(cache->known, cache->num_known, (MVMuint32)offset);
+    if (!found)
+        return 0;
+
+    /* The validator resolves extension ops; if some are not registered yet,
+     * let it report the error as usual. */
+    for (i = 0; i < cu->body.num_extops; i++)
+        if (!MVM_ext_resolve_extop_record(tc, &cu->body.extops[i]))
+            return 0;
+
+    if (*found & MVM_VALIDATION_CACHE_SPECIALIZABLE)
+        fb->specializable = 1;
+    return 1;
+}
+
+/* Notes that a static frame passed validation. */
+void MVM_validation_cache_add(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMInstance        *instance = tc->instance;
+    MVMValidationCache *cache;
+    MVMint64            offset;
+    if (!instance->validation_cache_dir)
+        return;
+    cache = get_cache(tc, sf->body.cu);
+    if (!cache || (offset = MVM_validation_cache_frame_offset(sf)) < 0)
+        return;
+    uv_mutex_lock(&instance->mutex_validation_cache);
+    MVM_VECTOR_PUSH(cache->added, (MVMuint32)offset
+        | (sf->body.specializable ? MVM_VALIDATION_CACHE_SPECIALIZABLE : 0));
+    uv_mutex_unlock(&instance->mutex_validation_cache);
+}
+
+/* Writes out the cache files that have new entries. The caches are left in
+ * place, since at exit background threads may still be validating frames
+ * and adding to them. */
+void MVM_validation_cache_write(MVMInstance *instance) {
+    MVMValidationCache *cache;
+    if (!instance->validation_cache_dir)
+        return;
+    uv_mutex_lock(&instance->mutex_validation_cache);
+    for (cache = instance->validation_caches; cache; cache = cache->next)
+        MVM_validation_cache_write_entries(instance->validation_cache_dir, cache->hash,
+            ".valid", MAGIC, cache->known, cache->num_known,
+            cache->added, MVM_VECTOR_ELEMS(cache->added));
+    uv_mutex_unlock(&instance->mutex_validation_cache);
+}
+
+/* Frees the caches, once no thread can be using them any more. */
+void MVM_validation_cache_destroy(MVMInstance *instance) {
+    MVMValidationCache *cache = instance->validation_caches;
+    instance->validation_caches = NULL;
+    while (cache) {
+        MVMValidationCache *next = cache->next;
+        MVM_VECTOR_DESTROY(cache->added);
+        MVM_free(cache->known);
+        MVM_free(cache);
+        cache = next;
+    }
+}
@@ -0,0 +1,41 @@
+/* Frames of a compilation unit that are already known to pass bytecode
+ * validation, from a side cache kept across runs. A compilation unit is
+ * identified by a SHA-1 of its bytecode (and of the VM version and op
+ * count, since what validates depends on those too), and a frame by the
+ * offset of its bytecode in the compilation unit. */
+struct MVMValidationCache {
+    /* Hex SHA-1 of the compilation unit, which names the cache file. */
+    char hash[41];
+
+    /* Sorted entries read from the cache file. Each is the offset of a
+     * frame's bytecode, with MVM_VALIDATION_CACHE_SPECIALIZABLE set if the
+     * frame contains a specializable op. */
+    MVMuint32 *known;
+    MVMuint32  num_known;
+
+    /* Entries for frames validated during this run, to be written out. */
+    MVM_VECTOR_DECL(MVMuint32, added);
+
+    /* Next cache in the instance's list of them. */
+    MVMValidationCache *next;
+};
+
+#define MVM_VALIDATION_CACHE_SPECIALIZABLE 0x80000000
+
+/* Size of the magic at the start of each cache file. */
+#define MVM_VALIDATION_CACHE_MAGIC_SIZE 8
+
+MVMint32 MVM_validation_cache_lookup(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_validation_cache_add(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_validation_cache_write(MVMInstance *instance);
+void MVM_validation_cache_destroy(MVMInstance *instance);
+
+/* Helpers shared with other caches kept alongside compilation units. */
+const char * MVM_validation_cache_hash(MVMThreadContext *tc, MVMCompUnit *cu);
+MVMint64 MVM_validation_cache_frame_offset(MVMStaticFrame *sf);
+MVMuint32 * MVM_validation_cache_find_entry(MVMuint32 *entries, MVMuint32 num, MVMuint32 offset);
+MVMuint32 * MVM_validation_cache_read_entries(const char *dir, const char *hash,
+    const char *ext, const char *magic, MVMuint32 *num);
+void MVM_validation_cache_write_entries(const char *dir, const char *hash,
+    const char *ext, const char *magic, MVMuint32 *known, MVMuint32 num_known,
+    MVMuint32 *added, MVMuint32 num_added);
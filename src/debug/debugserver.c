@@ -2,7 +2,7 @@
 #include "platform/threads.h"
 
 #define DEBUGSERVER_MAJOR_PROTOCOL_VERSION 1
-#define DEBUGSERVER_MINOR_PROTOCOL_VERSION 1
+#define DEBUGSERVER_MINOR_PROTOCOL_VERSION 2
 
 #define bool int
 #define true TRUE
@@ -1840,36 +1840,40 @@ static MVMint32 request_object_metadata(MVMThreadContext *dtc, cmp_ctx_t *ctx, r
     }
     else if (repr_id == MVM_REPR_ID_MVMHash) {
         if (IS_CONCRETE(target)) {
-            slots += 4; /* num_buckets, num_items, nonideal_items, ineff_expands */
+            slots += 6; /* num_buckets, num_items, nonideal_items, ineff_expands,
+                           num_entries, alloc_entries */
         }
         slots += 3; /* features */
         cmp_write_map(ctx, slots);
 
         if (IS_CONCRETE(target)) {
-            MVMHashBody *body = (MVMHashBody *)OBJECT_BODY(target);
-            MVMHashEntry *handle = body->hash_head;
-            UT_hash_table *tbl = handle ? body->hash_head->hash_handle.tbl : 0;
-
-            if (tbl) {
-                cmp_write_str(ctx, "mvmhash_num_buckets", 19);
-                cmp_write_int(ctx, tbl->num_buckets);
-                cmp_write_str(ctx, "mvmhash_num_items", 17);
-                cmp_write_int(ctx, tbl->num_items);
-                cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
-                cmp_write_int(ctx, tbl->nonideal_items);
-                cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
-                cmp_write_int(ctx, tbl->ineff_expands);
-            }
-            else {
-                cmp_write_str(ctx, "mvmhash_num_buckets", 19);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_num_items", 17);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
-                cmp_write_int(ctx, 0);
+            MVMHashBody *body     = (MVMHashBody *)OBJECT_BODY(target);
+            MVMuint32    buckets  = 2 * body->alloc_entries;
+            MVMuint32    nonideal = 0;
+            MVMuint32    i;
+
+            /* Keys that didn't get the index slot their hash picks. */
+            for (i = 0; i < buckets; i++) {
+                MVMuint32 entry = body->index[i].entry;
+                if (entry && ((MVMuint32)body->entries[entry - 1].hash & (buckets - 1)) != i)
+                    nonideal++;
             }
+
+            /* The keys from before VMHash used an open addressing table are
+             * kept, with the index slots as buckets; it never expands
+             * ineffectively. */
+            cmp_write_str(ctx, "mvmhash_num_buckets", 19);
+            cmp_write_int(ctx, buckets);
+            cmp_write_str(ctx, "mvmhash_num_items", 17);
+            cmp_write_int(ctx, body->num_items);
+            cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
+            cmp_write_int(ctx, nonideal);
+            cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
+            cmp_write_int(ctx, 0);
+            cmp_write_str(ctx, "mvmhash_num_entries", 19);
+            cmp_write_int(ctx, body->num_entries);
+            cmp_write_str(ctx, "mvmhash_alloc_entries", 21);
+            cmp_write_int(ctx, body->alloc_entries);
         }
 
         write_object_features(dtc, ctx, 0, 0, 1);
@@ -2156,9 +2160,8 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
 
     if (REPR(target)->ID == MVM_REPR_ID_MVMHash) {
         MVMHashBody *body = (MVMHashBody *)OBJECT_BODY(target);
-        MVMuint64 count = HASH_CNT(hash_handle, body->hash_head);
-
-        MVMHashEntry *entry = NULL;
+        MVMuint64 count = body->num_items;
+        MVMuint32 pos;
 
         cmp_write_map(ctx, 4);
         cmp_write_str(ctx, "id", 2);
@@ -2172,8 +2175,9 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
         cmp_write_str(ctx, "contents", 8);
         cmp_write_map(ctx, count);
 
-        HASH_ITER(dtc, hash_handle, body->hash_head, entry, {
-            char *key = MVM_string_utf8_encode_C_string(dtc, entry->hash_handle.key);
+        for (pos = MVM_hash_next_entry(body, 0); pos < body->num_entries; pos = MVM_hash_next_entry(body, pos + 1)) {
+            MVMHashKV *entry = &(body->entries[pos]);
+            char *key = MVM_string_utf8_encode_C_string(dtc, entry->key);
             MVMObject *value = entry->value;
             char *value_debug_name = value ? MVM_6model_get_debug_name(dtc, value) : "VMNull";
 
@@ -2197,7 +2201,7 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
                 cmp_write_bool(ctx, STABLE(value)->container_spec == NULL ? 0 : 1);
 
             MVM_free(key);
-        });
+        }
     }
 
     return 0;
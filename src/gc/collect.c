@@ -386,8 +386,9 @@ void MVM_gc_mark_collectable(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMC
         /* Add all references in the STable to the work list. */
         MVMSTable *new_addr_st = (MVMSTable *)new_addr;
         MVM_gc_worklist_add(tc, worklist, &new_addr_st->method_cache);
-        for (i = 0; i < new_addr_st->type_check_cache_length; i++)
-            MVM_gc_worklist_add(tc, worklist, &new_addr_st->type_check_cache[i]);
+        if (new_addr_st->type_check_cache)
+            for (i = 0; i < new_addr_st->type_check_cache->length; i++)
+                MVM_gc_worklist_add(tc, worklist, &new_addr_st->type_check_cache->types[i]);
         if (new_addr_st->container_spec)
             if (new_addr_st->container_spec->gc_mark_data)
                 new_addr_st->container_spec->gc_mark_data(tc, new_addr_st, worklist);
@@ -171,6 +171,10 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
         MVM_finalize_walk_queues(tc, gen);
         clear_intrays(tc, gen);
 
+        GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
+            "Thread %d run %d : Co-ordinator sweeping interned strings\n");
+        MVM_string_intern_gc_sweep(tc, gen);
+
         if (gen == MVMGCGenerations_Both) {
             MVMThread *cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
@@ -101,6 +101,8 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
         add_collectable(tc, worklist, snapshot, int_to_str_cache[i],
             "Integer to string cache entry");
 
+    MVM_intcache_gc_mark(tc, worklist, snapshot);
+
     /* okay, so this makes the weak hash slightly less weak.. for certain
      * keys of it anyway... */
     HASH_ITER_FAST(tc, hash_handle, tc->instance->sc_weakhash, current, {
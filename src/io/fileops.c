@@ -1,4 +1,5 @@
 #include "moar.h"
+#include "platform/mmap.h"
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -376,3 +377,62 @@ MVMString * MVM_file_readlink(MVMThreadContext *tc, MVMString *path) {
 
     return result;
 }
+
+/* Maps a file into memory as the slots of an empty native array, so that its
+ * contents can be read without copying them. With MVM_FILE_MAP_READONLY any
+ * attempt to modify the array throws (clones and slices of it get their own
+ * copy of the elements, and may be modified); with MVM_FILE_MAP_PRIVATE the
+ * first modification takes a private copy, and the file itself is never
+ * changed. */
+void MVM_file_map(MVMThreadContext *tc, MVMObject *target, MVMString *filename, MVMint64 mode) {
+    MVMArrayREPRData *repr_data;
+    char             *a;
+    void             *block;
+    void             *handle = NULL;
+    MVMuint64         size;
+    uv_fs_t           req;
+    uv_file           fd;
+
+    /* Ensure the target is in the correct form. */
+    if (!IS_CONCRETE(target) || REPR(target)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "mapfile requires a native array to map into");
+    repr_data = (MVMArrayREPRData *)STABLE(target)->REPR_data;
+    if (repr_data->slot_type == MVM_ARRAY_OBJ || repr_data->slot_type == MVM_ARRAY_STR
+            || repr_data->elem_size == 0)
+        MVM_exception_throw_adhoc(tc, "mapfile requires a native int or num array");
+    if (((MVMArray *)target)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "mapfile requires an empty array");
+    if (mode != MVM_FILE_MAP_READONLY && mode != MVM_FILE_MAP_PRIVATE)
+        MVM_exception_throw_adhoc(tc, "Unknown mapfile mode %"PRId64, mode);
+
+    a = MVM_string_utf8_c8_encode_C_string(tc, filename);
+    if ((fd = uv_fs_open(NULL, &req, a, O_RDONLY, 0, NULL)) < 0) {
+        MVM_free(a);
+        MVM_exception_throw_adhoc(tc, "Failed to open file: %s", uv_strerror(req.result));
+    }
+    MVM_free(a);
+
+    if (uv_fs_fstat(NULL, &req, fd, NULL) < 0) {
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc(tc, "Failed to stat file: %s", uv_strerror(req.result));
+    }
+    size = req.statbuf.st_size;
+    if ((MVMuint64)(size_t)size != size) {
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc(tc, "File of %"PRIu64" bytes is too large to map", size);
+    }
+
+    /* A file too short to hold a single element leaves the array empty. */
+    if (size < repr_data->elem_size) {
+        uv_fs_close(NULL, &req, fd, NULL);
+        return;
+    }
+
+    block = MVM_platform_map_file(fd, &handle, (size_t)size, 0);
+    uv_fs_close(NULL, &req, fd, NULL);
+    if (!block)
+        MVM_exception_throw_adhoc(tc, "Failed to map file into memory");
+
+    MVM_VMArray_use_mapping(tc, target, block, handle, (size_t)size,
+        mode == MVM_FILE_MAP_READONLY);
+}
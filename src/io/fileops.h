@@ -24,6 +24,9 @@
 #define MVM_STAT_PLATFORM_BLOCKSIZE -6
 #define MVM_STAT_PLATFORM_BLOCKS    -7
 
+#define MVM_FILE_MAP_READONLY        0       /* Modifying the array throws. */
+#define MVM_FILE_MAP_PRIVATE         1       /* Modifying the array copies it. */
+
 MVMint64 MVM_file_stat(MVMThreadContext *tc, MVMString *filename, MVMint64 status, MVMint32 use_lstat);
 MVMnum64 MVM_file_time(MVMThreadContext *tc, MVMString *filename, MVMint64 status, MVMint32 use_lstat);
 void MVM_file_copy(MVMThreadContext *tc, MVMString *src, MVMString *dest);
@@ -39,3 +42,4 @@ MVMString * MVM_file_in_libpath(MVMThreadContext *tc, MVMString *orig);
 void MVM_file_link(MVMThreadContext *tc, MVMString *oldpath, MVMString *newpath);
 void MVM_file_symlink(MVMThreadContext *tc, MVMString *oldpath, MVMString *newpath);
 MVMString * MVM_file_readlink(MVMThreadContext *tc, MVMString *path);
+void MVM_file_map(MVMThreadContext *tc, MVMObject *target, MVMString *filename, MVMint64 mode);
@@ -351,6 +351,16 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_cpucores: return MVM_platform_cpu_count;
     case MVM_OP_freemem: return MVM_platform_free_memory;
     case MVM_OP_totalmem: return MVM_platform_total_memory;
+    case MVM_OP_vecadd: return MVM_vecops_add;
+    case MVM_OP_vecmul: return MVM_vecops_mul;
+    case MVM_OP_vecfma: return MVM_vecops_fma;
+    case MVM_OP_veceq: return MVM_vecops_eq;
+    case MVM_OP_veclt: return MVM_vecops_lt;
+    case MVM_OP_vecle: return MVM_vecops_le;
+    case MVM_OP_vecsum_i: case MVM_OP_vecsum_n: return MVM_vecops_sum;
+    case MVM_OP_vecmin_i: case MVM_OP_vecmin_n: return MVM_vecops_min;
+    case MVM_OP_vecmax_i: case MVM_OP_vecmax_n: return MVM_vecops_max;
+    case MVM_OP_vecdot_i: case MVM_OP_vecdot_n: return MVM_vecops_dot;
     case MVM_OP_getsignals: return MVM_io_get_signals;
     case MVM_OP_sleep: return MVM_platform_sleep;
     case MVM_OP_getlexref_i32: case MVM_OP_getlexref_i16: case MVM_OP_getlexref_i8: case MVM_OP_getlexref_i: return MVM_nativeref_lex_i;
@@ -367,7 +377,25 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_atposref_n: return MVM_nativeref_pos_n;
     case MVM_OP_atposref_s: return MVM_nativeref_pos_s;
     case MVM_OP_indexingoptimized: return MVM_string_indexing_optimized;
-    case MVM_OP_sp_boolify_iter: return MVM_iter_istrue;
+    case MVM_OP_internstr: return MVM_string_intern;
+    case MVM_OP_strmatcherconfigure: return MVM_string_matcher_configure;
+    case MVM_OP_strmatcherfirst: return MVM_string_matcher_first;
+    case MVM_OP_strmatcherall: return MVM_string_matcher_all;
+    case MVM_OP_atikey_i:
+    case MVM_OP_atikey_n:
+    case MVM_OP_atikey_s:
+    case MVM_OP_atikey_o: return MVM_int_hash_at_key;
+    case MVM_OP_bindikey_i:
+    case MVM_OP_bindikey_n:
+    case MVM_OP_bindikey_s:
+    case MVM_OP_bindikey_o: return MVM_int_hash_bind_key;
+    case MVM_OP_existsikey: return MVM_int_hash_exists_key;
+    case MVM_OP_deleteikey: return MVM_int_hash_delete_key;
+    case MVM_OP_iterkey_i: return MVM_iterkey_i;
+    case MVM_OP_multicachestats: return MVM_multi_cache_stats;
+    case MVM_OP_mapfile: return MVM_file_map;
+    case MVM_OP_sp_boolify_iter:
+    case MVM_OP_sp_boolify_iter_hash: return MVM_iter_istrue;
     case MVM_OP_prof_allocated: return MVM_profile_log_allocated;
     case MVM_OP_prof_exit: return MVM_profile_log_exit;
     case MVM_OP_sp_resolvecode: return MVM_frame_resolve_invokee_spesh;
@@ -448,6 +476,7 @@ static MVMint32 consume_invoke(MVMThreadContext *tc, MVMJitGraph *jg,
     MVMint16      spesh_cand_or_sf_slot;
     MVMint16      is_fast;
     MVMint16      is_resolve = 0;
+    MVMint16      is_tail = 0;
     MVMuint32     resolve_offset = 0;
 
     while ((ins = ins->next)) {
@@ -557,6 +586,46 @@ static MVMint32 consume_invoke(MVMThreadContext *tc, MVMJitGraph *jg,
             spesh_cand_or_sf_slot = ins->operands[2].lit_i16;
             is_fast               = 1;
             goto checkargs;
+        case MVM_OP_sp_tailinvoke_v:
+            return_type           = MVM_RETURN_VOID;
+            return_register       = -1;
+            code_register_or_name = ins->operands[0].reg.orig;
+            spesh_cand_or_sf_slot = ins->operands[1].lit_i16;
+            is_fast               = 0;
+            is_tail               = 1;
+            goto checkargs;
+        case MVM_OP_sp_tailinvoke_o:
+            return_type           = MVM_RETURN_OBJ;
+            return_register       = ins->operands[0].reg.orig;
+            code_register_or_name = ins->operands[1].reg.orig;
+            spesh_cand_or_sf_slot = ins->operands[2].lit_i16;
+            is_fast               = 0;
+            is_tail               = 1;
+            goto checkargs;
+        case MVM_OP_sp_tailinvoke_s:
+            return_type           = MVM_RETURN_STR;
+            return_register       = ins->operands[0].reg.orig;
+            code_register_or_name = ins->operands[1].reg.orig;
+            spesh_cand_or_sf_slot = ins->operands[2].lit_i16;
+            is_fast               = 0;
+            is_tail               = 1;
+            goto checkargs;
+        case MVM_OP_sp_tailinvoke_i:
+            return_type           = MVM_RETURN_INT;
+            return_register       = ins->operands[0].reg.orig;
+            code_register_or_name = ins->operands[1].reg.orig;
+            spesh_cand_or_sf_slot = ins->operands[2].lit_i16;
+            is_fast               = 0;
+            is_tail               = 1;
+            goto checkargs;
+        case MVM_OP_sp_tailinvoke_n:
+            return_type           = MVM_RETURN_NUM;
+            return_register       = ins->operands[0].reg.orig;
+            code_register_or_name = ins->operands[1].reg.orig;
+            spesh_cand_or_sf_slot = ins->operands[2].lit_i16;
+            is_fast               = 0;
+            is_tail               = 1;
+            goto checkargs;
         case MVM_OP_sp_speshresolve:
             return_type           = MVM_RETURN_OBJ;
             return_register       = ins->operands[0].reg.orig;;
@@ -596,6 +665,7 @@ static MVMint32 consume_invoke(MVMThreadContext *tc, MVMJitGraph *jg,
     node->u.invoke.reentry_label         = reentry_label;
     node->u.invoke.is_fast               = is_fast;
     node->u.invoke.is_resolve            = is_resolve;
+    node->u.invoke.is_tail               = is_tail;
     jg_append_node(jg, node);
 
     /* append reentry label */
@@ -774,6 +844,14 @@ static void jg_sc_wb(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshOperand chec
     jg_append_call_c(tc, jg, &MVM_SC_WB_OBJ, 2, args, MVM_JIT_RV_VOID, -1);
 }
 
+/* Checks if spesh knows an operand is a concrete VMIntHash, in which case
+ * the integer key ops can call straight into its lookup. */
+static MVMint32 known_int_hash(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshOperand operand) {
+    MVMSpeshFacts *facts = MVM_spesh_get_facts(tc, jg->sg, operand);
+    return (facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) && (facts->flags & MVM_SPESH_FACT_CONCRETE)
+        && facts->type && REPR(facts->type)->ID == MVM_REPR_ID_MVMIntHash;
+}
+
 static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                                MVMSpeshIterator *iter, MVMSpeshIns *ins) {
     MVMint16 op = ins->info->opcode;
@@ -1822,7 +1900,6 @@ start:
     case MVM_OP_islist:
     case MVM_OP_ishash:
     case MVM_OP_sp_boolify_iter_arr:
-    case MVM_OP_sp_boolify_iter_hash:
     case MVM_OP_lexprimspec:
     case MVM_OP_objprimspec:
     case MVM_OP_objprimbits:
@@ -2606,7 +2683,8 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
         break;
     }
-    case MVM_OP_sp_boolify_iter: {
+    case MVM_OP_sp_boolify_iter:
+    case MVM_OP_sp_boolify_iter_hash: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMint16 obj = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
@@ -2947,7 +3025,8 @@ start:
     case MVM_OP_lc:
     case MVM_OP_tc:
     case MVM_OP_fc:
-    case MVM_OP_indexingoptimized: {
+    case MVM_OP_indexingoptimized:
+    case MVM_OP_internstr: {
         MVMint16 dst    = ins->operands[0].reg.orig;
         MVMint16 string = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
@@ -3575,6 +3654,214 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 0, NULL, MVM_JIT_RV_INT, dst);
         break;
     }
+    case MVM_OP_vecadd:
+    case MVM_OP_vecmul:
+    case MVM_OP_veceq:
+    case MVM_OP_veclt:
+    case MVM_OP_vecle: {
+        MVMint16 dest = ins->operands[0].reg.orig;
+        MVMint16 a    = ins->operands[1].reg.orig;
+        MVMint16 b    = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { dest } },
+                                 { MVM_JIT_REG_VAL, { a } },
+                                 { MVM_JIT_REG_VAL, { b } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_vecfma: {
+        MVMint16 dest = ins->operands[0].reg.orig;
+        MVMint16 a    = ins->operands[1].reg.orig;
+        MVMint16 b    = ins->operands[2].reg.orig;
+        MVMint16 c    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { dest } },
+                                 { MVM_JIT_REG_VAL, { a } },
+                                 { MVM_JIT_REG_VAL, { b } },
+                                 { MVM_JIT_REG_VAL, { c } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_vecsum_i:
+    case MVM_OP_vecsum_n:
+    case MVM_OP_vecmin_i:
+    case MVM_OP_vecmin_n:
+    case MVM_OP_vecmax_i:
+    case MVM_OP_vecmax_n: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 a   = ins->operands[1].reg.orig;
+        MVMuint16 kind = op == MVM_OP_vecsum_n || op == MVM_OP_vecmin_n || op == MVM_OP_vecmax_n
+            ? MVM_reg_num64 : MVM_reg_int64;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { a } },
+                                 { MVM_JIT_REG_ADDR, { dst } },
+                                 { MVM_JIT_LITERAL, { kind } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_vecdot_i:
+    case MVM_OP_vecdot_n: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 a   = ins->operands[1].reg.orig;
+        MVMint16 b   = ins->operands[2].reg.orig;
+        MVMuint16 kind = op == MVM_OP_vecdot_n ? MVM_reg_num64 : MVM_reg_int64;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { a } },
+                                 { MVM_JIT_REG_VAL, { b } },
+                                 { MVM_JIT_REG_ADDR, { dst } },
+                                 { MVM_JIT_LITERAL, { kind } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_strmatcherconfigure: {
+        MVMint16 matcher = ins->operands[0].reg.orig;
+        MVMint16 needles = ins->operands[1].reg.orig;
+        MVMint16 flags   = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { matcher } },
+                                 { MVM_JIT_REG_VAL, { needles } },
+                                 { MVM_JIT_REG_VAL, { flags } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_strmatcherfirst:
+    case MVM_OP_strmatcherall: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 matcher  = ins->operands[1].reg.orig;
+        MVMint16 haystack = ins->operands[2].reg.orig;
+        MVMint16 start    = ins->operands[3].reg.orig;
+        MVMint16 results  = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { matcher } },
+                                 { MVM_JIT_REG_VAL, { haystack } },
+                                 { MVM_JIT_REG_VAL, { start } },
+                                 { MVM_JIT_REG_VAL, { results } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_atikey_i:
+    case MVM_OP_atikey_n:
+    case MVM_OP_atikey_s:
+    case MVM_OP_atikey_o: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 invocant = ins->operands[1].reg.orig;
+        MVMint16 key      = ins->operands[2].reg.orig;
+        MVMint16 kind     = op == MVM_OP_atikey_i ? MVM_reg_int64 :
+                            op == MVM_OP_atikey_n ? MVM_reg_num64 :
+                            op == MVM_OP_atikey_s ? MVM_reg_str :
+                                                    MVM_reg_obj;
+        if (known_int_hash(tc, jg, ins->operands[1])) {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR,  { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_STABLE,  { invocant } },
+                                     { MVM_JIT_REG_VAL,     { invocant } },
+                                     { MVM_JIT_REG_OBJBODY, { invocant } },
+                                     { MVM_JIT_REG_VAL,     { key } },
+                                     { MVM_JIT_REG_ADDR,    { dst } },
+                                     { MVM_JIT_LITERAL,     { kind } } };
+            jg_append_call_c(tc, jg, MVMIntHash_at_int_key, 7, args, MVM_JIT_RV_VOID, -1);
+            MVM_spesh_graph_add_comment(tc, iter->graph, ins, "JIT: devirtualized");
+        }
+        else {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_VAL,    { invocant } },
+                                     { MVM_JIT_REG_VAL,    { key } },
+                                     { MVM_JIT_REG_ADDR,   { dst } },
+                                     { MVM_JIT_LITERAL,    { kind } } };
+            jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        }
+        break;
+    }
+    case MVM_OP_bindikey_i:
+    case MVM_OP_bindikey_n:
+    case MVM_OP_bindikey_s:
+    case MVM_OP_bindikey_o: {
+        MVMint16 invocant = ins->operands[0].reg.orig;
+        MVMint16 key      = ins->operands[1].reg.orig;
+        MVMint16 value    = ins->operands[2].reg.orig;
+        MVMint16 kind     = op == MVM_OP_bindikey_i ? MVM_reg_int64 :
+                            op == MVM_OP_bindikey_n ? MVM_reg_num64 :
+                            op == MVM_OP_bindikey_s ? MVM_reg_str :
+                                                      MVM_reg_obj;
+        if (known_int_hash(tc, jg, ins->operands[0])) {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR,  { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_STABLE,  { invocant } },
+                                     { MVM_JIT_REG_VAL,     { invocant } },
+                                     { MVM_JIT_REG_OBJBODY, { invocant } },
+                                     { MVM_JIT_REG_VAL,     { key } },
+                                     { MVM_JIT_REG_VAL,     { value } },
+                                     { MVM_JIT_LITERAL,     { kind } } };
+            jg_append_call_c(tc, jg, MVMIntHash_bind_int_key, 7, args, MVM_JIT_RV_VOID, -1);
+            MVM_spesh_graph_add_comment(tc, iter->graph, ins, "JIT: devirtualized");
+        }
+        else {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_VAL,    { invocant } },
+                                     { MVM_JIT_REG_VAL,    { key } },
+                                     { MVM_JIT_REG_VAL,    { value } },
+                                     { MVM_JIT_LITERAL,    { kind } } };
+            jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        }
+        jg_sc_wb(tc, jg, ins->operands[0]);
+        break;
+    }
+    case MVM_OP_existsikey: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 invocant = ins->operands[1].reg.orig;
+        MVMint16 key      = ins->operands[2].reg.orig;
+        if (known_int_hash(tc, jg, ins->operands[1])) {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR,  { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_STABLE,  { invocant } },
+                                     { MVM_JIT_REG_VAL,     { invocant } },
+                                     { MVM_JIT_REG_OBJBODY, { invocant } },
+                                     { MVM_JIT_REG_VAL,     { key } } };
+            jg_append_call_c(tc, jg, MVMIntHash_exists_int_key, 5, args, MVM_JIT_RV_INT, dst);
+            MVM_spesh_graph_add_comment(tc, iter->graph, ins, "JIT: devirtualized");
+        }
+        else {
+            MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                     { MVM_JIT_REG_VAL,    { invocant } },
+                                     { MVM_JIT_REG_VAL,    { key } } };
+            jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_INT, dst);
+        }
+        break;
+    }
+    case MVM_OP_deleteikey: {
+        MVMint16 invocant = ins->operands[0].reg.orig;
+        MVMint16 key      = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL,    { invocant } },
+                                 { MVM_JIT_REG_VAL,    { key } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        jg_sc_wb(tc, jg, ins->operands[0]);
+        break;
+    }
+    case MVM_OP_iterkey_i: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint32 invocant = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL,    { invocant } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_multicachestats: {
+        MVMint16 dst   = ins->operands[0].reg.orig;
+        MVMint16 cache = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cache } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_mapfile: {
+        MVMint16 target   = ins->operands[0].reg.orig;
+        MVMint16 filename = ins->operands[1].reg.orig;
+        MVMint16 mode     = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { target } },
+                                 { MVM_JIT_REG_VAL, { filename } },
+                                 { MVM_JIT_REG_VAL, { mode } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
     case MVM_OP_getsignals: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMJitCallArg args[] =  { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } } };
@@ -186,6 +186,7 @@ struct MVMJitInvoke {
     MVMint16      spesh_cand_or_sf_slot;
     MVMint8       is_fast;
     MVMint8       is_resolve;
+    MVMint8       is_tail;
     MVMuint32     resolve_offset;           /* Only for spesh resolve */
     MVMint32      reentry_label;
 };
@@ -86,6 +86,7 @@ The following environment variables are respected:\n\
     MVM_SPESH_INLINE_DISABLE    Disables inlining\n\
     MVM_SPESH_OSR_DISABLE       Disables on-stack replacement\n\
     MVM_SPESH_PEA_DISABLE       Disables partial escape analysis and related optimizations\n\
+    MVM_SPESH_TCO_DISABLE       Disables tail call optimization\n\
     MVM_SPESH_BLOCKING          Blocks log-sending thread while specializer runs\n\
     MVM_SPESH_LOG               Specifies a dynamic optimizer log file\n\
     MVM_SPESH_NODELAY           Run dynamic optimization even for cold frames\n\
@@ -96,6 +97,9 @@ The following environment variables are respected:\n\
     MVM_JIT_PERF_MAP            Create a map file for the 'perf' profiler (linux only)\n\
     MVM_JIT_DUMP_BYTECODE       Dump bytecode in temporary directory\n\
     MVM_SPESH_INLINE_LOG        Dump details of inlining attempts to stderr\n\
+    MVM_VALIDATION_CACHE        Directory in which to remember which frames passed bytecode validation\n\
+    MVM_SPESH_HOT_HINTS         Directory in which to note which frames were hot, to specialize them early in later runs\n\
+    MVM_MULTI_CACHE_STATS       Count hits and misses of multi-dispatch caches, for nqp::multicachestats\n\
     MVM_CROSS_THREAD_WRITE_LOG  Log unprotected cross-thread object writes to stderr\n\
     MVM_COVERAGE_LOG            Append (de-duped by default) line-by-line coverage messages to this file\n\
     MVM_COVERAGE_CONTROL        If set to 1, non-de-duping coverage started with nqp::coveragecontrol(1),\n\
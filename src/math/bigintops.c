@@ -845,7 +845,8 @@ void MVM_bigint_from_str(MVMThreadContext *tc, MVMObject *a, const char *buf) {
         body->u.bigint = i_cpy;
     }
 }
-#define can_fit_into_8bit(g) ((-128 <= (g) && (g) <= 127))
+/* Matches the range of MVM_STRING_GRAPHEME_8 storage, which is unsigned. */
+#define can_fit_into_8bit(g) ((0 <= (g) && (g) <= 255))
 MVMObject * MVM_coerce_sI(MVMThreadContext *tc, MVMString *s, MVMObject *type) {
     char *buf = NULL;
     int is_malloced = 0;
@@ -868,7 +869,7 @@ MVMObject * MVM_coerce_sI(MVMThreadContext *tc, MVMString *s, MVMObject *type) {
         case MVM_STRING_GRAPHEME_32:
             for (i = 0; i < s->body.num_graphs; i++) {
                 buf[i] = can_fit_into_8bit(s->body.storage.blob_32[i])
-                    ? s->body.storage.blob_32[i]
+                    ? (char)(MVMGrapheme8)s->body.storage.blob_32[i]
                     : '?'; /* Add a filler bogus char if it can't fit */
             }
             break;
@@ -877,7 +878,7 @@ MVMObject * MVM_coerce_sI(MVMThreadContext *tc, MVMString *s, MVMObject *type) {
             MVM_string_gi_init(tc, &gi, s);
             for (i = 0; i < s->body.num_graphs; i++) {
                 MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
-                buf[i] = can_fit_into_8bit(g) ? g : '?';
+                buf[i] = can_fit_into_8bit(g) ? (char)(MVMGrapheme8)g : '?';
             }
             break;
         }
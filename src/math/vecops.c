@@ -0,0 +1,392 @@
+#include "moar.h"
+#include "platform/simd.h"
+#include <math.h>
+
+/* Bulk arithmetic, reductions and comparisons over native int64 and num64
+ * arrays (VMArray), so that numeric code need not go through the
+ * interpreter or JIT once per element. On x86 with GCC or Clang we have
+ * SSE2 and AVX2 kernels, picked at runtime by what the CPU supports; the
+ * plain C loops are used elsewhere and for whatever the kernels leave over
+ * at the end of an array.
+ *
+ * Integer arithmetic wraps around, as elsewhere in the VM. The order in
+ * which reductions add up num elements is unspecified, so sums and dot
+ * products may differ in the last bits between machines, and min and max
+ * give an unspecified result if the array contains a NaN. */
+
+/* Operations done by the elementwise kernels. */
+enum {
+    VEC_ADD,
+    VEC_MUL,
+    VEC_FMA,
+    VEC_EQ,
+    VEC_LT,
+    VEC_LE
+};
+
+/* Operations done by the reduction kernels. */
+enum {
+    VEC_SUM,
+    VEC_MIN,
+    VEC_MAX,
+    VEC_DOT
+};
+
+/* Portable kernels. These all start at index i, so they can also finish off
+ * what a SIMD kernel did not handle. */
+static void elementwise_n(int op, MVMnum64 *d, const MVMnum64 *a, const MVMnum64 *b,
+        const MVMnum64 *c, size_t i, size_t n) {
+    MVMint64 *di = (MVMint64 *)d;
+    switch (op) {
+        case VEC_ADD: for (; i < n; i++) d[i] = a[i] + b[i]; break;
+        case VEC_MUL: for (; i < n; i++) d[i] = a[i] * b[i]; break;
+        case VEC_FMA: for (; i < n; i++) d[i] = fma(a[i], b[i], c[i]); break;
+        case VEC_EQ:  for (; i < n; i++) di[i] = a[i] == b[i]; break;
+        case VEC_LT:  for (; i < n; i++) di[i] = a[i] < b[i]; break;
+        case VEC_LE:  for (; i < n; i++) di[i] = a[i] <= b[i]; break;
+    }
+}
+static void elementwise_i(int op, MVMint64 *d, const MVMint64 *a, const MVMint64 *b,
+        const MVMint64 *c, size_t i, size_t n) {
+    const MVMuint64 *ua = (const MVMuint64 *)a, *ub = (const MVMuint64 *)b,
+                    *uc = (const MVMuint64 *)c;
+    switch (op) {
+        case VEC_ADD: for (; i < n; i++) d[i] = (MVMint64)(ua[i] + ub[i]); break;
+        case VEC_MUL: for (; i < n; i++) d[i] = (MVMint64)(ua[i] * ub[i]); break;
+        case VEC_FMA: for (; i < n; i++) d[i] = (MVMint64)(ua[i] * ub[i] + uc[i]); break;
+        case VEC_EQ:  for (; i < n; i++) d[i] = a[i] == b[i]; break;
+        case VEC_LT:  for (; i < n; i++) d[i] = a[i] < b[i]; break;
+        case VEC_LE:  for (; i < n; i++) d[i] = a[i] <= b[i]; break;
+    }
+}
+static MVMnum64 reduce_n(int op, MVMnum64 acc, const MVMnum64 *a, const MVMnum64 *b,
+        size_t i, size_t n) {
+    switch (op) {
+        case VEC_SUM: for (; i < n; i++) acc += a[i]; break;
+        case VEC_MIN: for (; i < n; i++) if (a[i] < acc) acc = a[i]; break;
+        case VEC_MAX: for (; i < n; i++) if (a[i] > acc) acc = a[i]; break;
+        case VEC_DOT: for (; i < n; i++) acc += a[i] * b[i]; break;
+    }
+    return acc;
+}
+static MVMint64 reduce_i(int op, MVMint64 acc, const MVMint64 *a, const MVMint64 *b,
+        size_t i, size_t n) {
+    MVMuint64 uacc = (MVMuint64)acc;
+    switch (op) {
+        case VEC_SUM: for (; i < n; i++) uacc += (MVMuint64)a[i]; return (MVMint64)uacc;
+        case VEC_MIN: for (; i < n; i++) if (a[i] < acc) acc = a[i]; break;
+        case VEC_MAX: for (; i < n; i++) if (a[i] > acc) acc = a[i]; break;
+        case VEC_DOT: for (; i < n; i++) uacc += (MVMuint64)a[i] * (MVMuint64)b[i]; return (MVMint64)uacc;
+    }
+    return acc;
+}
+
+#if MVM_SIMD_X86
+/* SSE2 kernels; these return how many elements they handled. */
+static MVM_SIMD_TARGET("sse2") size_t elementwise_n_sse2(int op, MVMnum64 *d, const MVMnum64 *a,
+        const MVMnum64 *b, size_t n) {
+    const __m128d one = _mm_castsi128_pd(_mm_set1_epi64x(1));
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a + i), y = _mm_loadu_pd(b + i), r;
+        switch (op) {
+            case VEC_ADD: r = _mm_add_pd(x, y); break;
+            case VEC_MUL: r = _mm_mul_pd(x, y); break;
+            case VEC_EQ:  r = _mm_and_pd(_mm_cmpeq_pd(x, y), one); break;
+            case VEC_LT:  r = _mm_and_pd(_mm_cmplt_pd(x, y), one); break;
+            case VEC_LE:  r = _mm_and_pd(_mm_cmple_pd(x, y), one); break;
+            default:      return 0;
+        }
+        _mm_storeu_pd(d + i, r);
+    }
+    return i;
+}
+static MVM_SIMD_TARGET("sse2") size_t elementwise_i_sse2(int op, MVMint64 *d, const MVMint64 *a,
+        const MVMint64 *b, size_t n) {
+    size_t i = 0;
+    if (op != VEC_ADD)
+        return 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_si128((__m128i *)(d + i), _mm_add_epi64(
+            _mm_loadu_si128((const __m128i *)(a + i)),
+            _mm_loadu_si128((const __m128i *)(b + i))));
+    return i;
+}
+static MVM_SIMD_TARGET("sse2") size_t reduce_n_sse2(int op, MVMnum64 *acc, const MVMnum64 *a,
+        const MVMnum64 *b, size_t n) {
+    double lanes[2];
+    __m128d r;
+    size_t i;
+    if (n < 4)
+        return 0;
+    r = op == VEC_DOT ? _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)) : _mm_loadu_pd(a);
+    for (i = 2; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a + i);
+        switch (op) {
+            case VEC_SUM: r = _mm_add_pd(r, x); break;
+            case VEC_MIN: r = _mm_min_pd(r, x); break;
+            case VEC_MAX: r = _mm_max_pd(r, x); break;
+            case VEC_DOT: r = _mm_add_pd(r, _mm_mul_pd(x, _mm_loadu_pd(b + i))); break;
+        }
+    }
+    _mm_storeu_pd(lanes, r);
+    *acc = reduce_n(op == VEC_DOT ? VEC_SUM : op, lanes[0], lanes, NULL, 1, 2);
+    return i;
+}
+static MVM_SIMD_TARGET("sse2") size_t reduce_i_sse2(int op, MVMint64 *acc, const MVMint64 *a, size_t n) {
+    MVMint64 lanes[2];
+    __m128i r;
+    size_t i;
+    if (op != VEC_SUM || n < 4)
+        return 0;
+    r = _mm_loadu_si128((const __m128i *)a);
+    for (i = 2; i + 2 <= n; i += 2)
+        r = _mm_add_epi64(r, _mm_loadu_si128((const __m128i *)(a + i)));
+    _mm_storeu_si128((__m128i *)lanes, r);
+    *acc = (MVMint64)((MVMuint64)lanes[0] + (MVMuint64)lanes[1]);
+    return i;
+}
+
+/* AVX2 kernels; these return how many elements they handled. */
+static MVM_SIMD_TARGET("avx2,fma") size_t elementwise_n_avx2(int op, MVMnum64 *d, const MVMnum64 *a,
+        const MVMnum64 *b, const MVMnum64 *c, size_t n) {
+    const __m256d one = _mm256_castsi256_pd(_mm256_set1_epi64x(1));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i), y = _mm256_loadu_pd(b + i), r;
+        switch (op) {
+            case VEC_ADD: r = _mm256_add_pd(x, y); break;
+            case VEC_MUL: r = _mm256_mul_pd(x, y); break;
+            case VEC_FMA: r = _mm256_fmadd_pd(x, y, _mm256_loadu_pd(c + i)); break;
+            case VEC_EQ:  r = _mm256_and_pd(_mm256_cmp_pd(x, y, _CMP_EQ_OQ), one); break;
+            case VEC_LT:  r = _mm256_and_pd(_mm256_cmp_pd(x, y, _CMP_LT_OQ), one); break;
+            case VEC_LE:  r = _mm256_and_pd(_mm256_cmp_pd(x, y, _CMP_LE_OQ), one); break;
+            default:      return 0;
+        }
+        _mm256_storeu_pd(d + i, r);
+    }
+    return i;
+}
+static MVM_SIMD_TARGET("avx2") size_t elementwise_i_avx2(int op, MVMint64 *d, const MVMint64 *a,
+        const MVMint64 *b, size_t n) {
+    const __m256i one = _mm256_set1_epi64x(1);
+    size_t i = 0;
+    /* There's no 64-bit multiply before AVX-512, so leave those be. */
+    if (op == VEC_MUL || op == VEC_FMA)
+        return 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i r;
+        switch (op) {
+            case VEC_ADD: r = _mm256_add_epi64(x, y); break;
+            case VEC_EQ:  r = _mm256_and_si256(_mm256_cmpeq_epi64(x, y), one); break;
+            case VEC_LT:  r = _mm256_and_si256(_mm256_cmpgt_epi64(y, x), one); break;
+            case VEC_LE:  r = _mm256_andnot_si256(_mm256_cmpgt_epi64(x, y), one); break;
+            default:      return 0;
+        }
+        _mm256_storeu_si256((__m256i *)(d + i), r);
+    }
+    return i;
+}
+static MVM_SIMD_TARGET("avx2,fma") size_t reduce_n_avx2(int op, MVMnum64 *acc, const MVMnum64 *a,
+        const MVMnum64 *b, size_t n) {
+    double lanes[4];
+    __m256d r;
+    size_t i;
+    if (n < 8)
+        return 0;
+    r = op == VEC_DOT ? _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)) : _mm256_loadu_pd(a);
+    for (i = 4; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(a + i);
+        switch (op) {
+            case VEC_SUM: r = _mm256_add_pd(r, x); break;
+            case VEC_MIN: r = _mm256_min_pd(r, x); break;
+            case VEC_MAX: r = _mm256_max_pd(r, x); break;
+            case VEC_DOT: r = _mm256_fmadd_pd(x, _mm256_loadu_pd(b + i), r); break;
+        }
+    }
+    _mm256_storeu_pd(lanes, r);
+    *acc = reduce_n(op == VEC_DOT ? VEC_SUM : op, lanes[0], lanes, NULL, 1, 4);
+    return i;
+}
+static MVM_SIMD_TARGET("avx2") size_t reduce_i_avx2(int op, MVMint64 *acc, const MVMint64 *a, size_t n) {
+    MVMint64 lanes[4];
+    __m256i r;
+    size_t i;
+    if (op == VEC_DOT || n < 8)
+        return 0;
+    r = _mm256_loadu_si256((const __m256i *)a);
+    for (i = 4; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        switch (op) {
+            case VEC_SUM: r = _mm256_add_epi64(r, x); break;
+            case VEC_MIN: r = _mm256_blendv_epi8(r, x, _mm256_cmpgt_epi64(r, x)); break;
+            case VEC_MAX: r = _mm256_blendv_epi8(r, x, _mm256_cmpgt_epi64(x, r)); break;
+        }
+    }
+    _mm256_storeu_si256((__m256i *)lanes, r);
+    *acc = reduce_i(op, lanes[0], lanes, NULL, 1, 4);
+    return i;
+}
+#endif
+
+/* Gets the body of a native int64 or num64 array, or throws if it's not
+ * one, and hands back its slot type. */
+static MVMArrayBody * get_body(MVMThreadContext *tc, MVMObject *arr, const char *name,
+        MVMuint8 *slot_type) {
+    if (REPR(arr)->ID == MVM_REPR_ID_VMArray && IS_CONCRETE(arr)) {
+        MVMuint8 type = ((MVMArrayREPRData *)STABLE(arr)->REPR_data)->slot_type;
+        if (type == MVM_ARRAY_I64 || type == MVM_ARRAY_N64) {
+            *slot_type = type;
+            return &((MVMArray *)arr)->body;
+        }
+    }
+    MVM_exception_throw_adhoc(tc, "%s requires a native int or num array (got %s)",
+        name, MVM_6model_get_debug_name(tc, arr));
+}
+
+/* Applies an elementwise operation, putting the results into dest. */
+static void elementwise(MVMThreadContext *tc, int op, const char *name, MVMObject *dest,
+        MVMObject *a, MVMObject *b, MVMObject *c) {
+    MVMArrayBody *ab, *bb, *cb = NULL, *db;
+    MVMuint8 type, btype, ctype, dtype;
+    size_t n, i = 0;
+
+    ab = get_body(tc, a, name, &type);
+    bb = get_body(tc, b, name, &btype);
+    if (c)
+        cb = get_body(tc, c, name, &ctype);
+    if (btype != type || (c && ctype != type))
+        MVM_exception_throw_adhoc(tc, "%s requires arrays of the same native type", name);
+    n = ab->elems;
+    if (bb->elems != n || (c && cb->elems != n))
+        MVM_exception_throw_adhoc(tc, "%s requires arrays of the same length (got %"PRIu64" and %"PRIu64")",
+            name, ab->elems, bb->elems != n ? bb->elems : cb->elems);
+    db = get_body(tc, dest, name, &dtype);
+    if (dtype != (op >= VEC_EQ ? MVM_ARRAY_I64 : type))
+        MVM_exception_throw_adhoc(tc, "%s requires a destination array of %s",
+            name, op >= VEC_EQ || type == MVM_ARRAY_I64 ? "int" : "num");
+
+    /* Resizing the destination may move its slots, so find them after. */
+    MVM_repr_pos_set_elems(tc, dest, n);
+
+    if (type == MVM_ARRAY_N64) {
+        MVMnum64 *d        = db->slots.n64 + db->start;
+        const MVMnum64 *as = ab->slots.n64 + ab->start;
+        const MVMnum64 *bs = bb->slots.n64 + bb->start;
+        const MVMnum64 *cs = c ? cb->slots.n64 + cb->start : NULL;
+#if MVM_SIMD_X86
+        switch (MVM_platform_simd_level()) {
+            case MVM_SIMD_AVX2: i = elementwise_n_avx2(op, d, as, bs, cs, n); break;
+            case MVM_SIMD_SSE2: i = elementwise_n_sse2(op, d, as, bs, n); break;
+        }
+#endif
+        elementwise_n(op, d, as, bs, cs, i, n);
+    }
+    else {
+        MVMint64 *d        = db->slots.i64 + db->start;
+        const MVMint64 *as = ab->slots.i64 + ab->start;
+        const MVMint64 *bs = bb->slots.i64 + bb->start;
+        const MVMint64 *cs = c ? cb->slots.i64 + cb->start : NULL;
+#if MVM_SIMD_X86
+        switch (MVM_platform_simd_level()) {
+            case MVM_SIMD_AVX2: i = elementwise_i_avx2(op, d, as, bs, n); break;
+            case MVM_SIMD_SSE2: i = elementwise_i_sse2(op, d, as, bs, n); break;
+        }
+#endif
+        elementwise_i(op, d, as, bs, cs, i, n);
+    }
+}
+
+/* Reduces an array (or, for dot products, a pair of arrays) to a single
+ * value, which goes into the result register. */
+static void reduce(MVMThreadContext *tc, int op, const char *name, MVMObject *a, MVMObject *b,
+        MVMRegister *result, MVMuint16 kind) {
+    MVMArrayBody *ab, *bb = NULL;
+    MVMuint8 type, btype;
+    size_t n, i = 0;
+
+    ab = get_body(tc, a, name, &type);
+    if (b) {
+        bb = get_body(tc, b, name, &btype);
+        if (btype != type)
+            MVM_exception_throw_adhoc(tc, "%s requires arrays of the same native type", name);
+        if (bb->elems != ab->elems)
+            MVM_exception_throw_adhoc(tc, "%s requires arrays of the same length (got %"PRIu64" and %"PRIu64")",
+                name, ab->elems, bb->elems);
+    }
+    if ((kind == MVM_reg_num64) != (type == MVM_ARRAY_N64))
+        MVM_exception_throw_adhoc(tc, "%s requires a native %s array", name,
+            kind == MVM_reg_num64 ? "num" : "int");
+    n = ab->elems;
+    if (n == 0 && (op == VEC_MIN || op == VEC_MAX))
+        MVM_exception_throw_adhoc(tc, "%s requires a non-empty array", name);
+
+    if (type == MVM_ARRAY_N64) {
+        const MVMnum64 *as = ab->slots.n64 + ab->start;
+        const MVMnum64 *bs = b ? bb->slots.n64 + bb->start : NULL;
+        MVMnum64 acc = op == VEC_MIN || op == VEC_MAX ? as[0] : 0.0;
+#if MVM_SIMD_X86
+        switch (MVM_platform_simd_level()) {
+            case MVM_SIMD_AVX2: i = reduce_n_avx2(op, &acc, as, bs, n); break;
+            case MVM_SIMD_SSE2: i = reduce_n_sse2(op, &acc, as, bs, n); break;
+        }
+#endif
+        result->n64 = reduce_n(op, acc, as, bs, i, n);
+    }
+    else {
+        const MVMint64 *as = ab->slots.i64 + ab->start;
+        const MVMint64 *bs = b ? bb->slots.i64 + bb->start : NULL;
+        MVMint64 acc = op == VEC_MIN || op == VEC_MAX ? as[0] : 0;
+#if MVM_SIMD_X86
+        switch (MVM_platform_simd_level()) {
+            case MVM_SIMD_AVX2: i = reduce_i_avx2(op, &acc, as, n); break;
+            case MVM_SIMD_SSE2: i = reduce_i_sse2(op, &acc, as, n); break;
+        }
+#endif
+        result->i64 = reduce_i(op, acc, as, bs, i, n);
+    }
+}
+
+void MVM_vecops_add(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b) {
+    elementwise(tc, VEC_ADD, "vecadd", dest, a, b, NULL);
+}
+
+void MVM_vecops_mul(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b) {
+    elementwise(tc, VEC_MUL, "vecmul", dest, a, b, NULL);
+}
+
+/* Computes a * b + c; for nums, with a single rounding. */
+void MVM_vecops_fma(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b, MVMObject *c) {
+    elementwise(tc, VEC_FMA, "vecfma", dest, a, b, c);
+}
+
+/* Comparisons put 1 or 0 into an int64 destination array. */
+void MVM_vecops_eq(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b) {
+    elementwise(tc, VEC_EQ, "veceq", dest, a, b, NULL);
+}
+
+void MVM_vecops_lt(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b) {
+    elementwise(tc, VEC_LT, "veclt", dest, a, b, NULL);
+}
+
+void MVM_vecops_le(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b) {
+    elementwise(tc, VEC_LE, "vecle", dest, a, b, NULL);
+}
+
+void MVM_vecops_sum(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind) {
+    reduce(tc, VEC_SUM, "vecsum", a, NULL, result, kind);
+}
+
+void MVM_vecops_min(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind) {
+    reduce(tc, VEC_MIN, "vecmin", a, NULL, result, kind);
+}
+
+void MVM_vecops_max(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind) {
+    reduce(tc, VEC_MAX, "vecmax", a, NULL, result, kind);
+}
+
+void MVM_vecops_dot(MVMThreadContext *tc, MVMObject *a, MVMObject *b, MVMRegister *result, MVMuint16 kind) {
+    reduce(tc, VEC_DOT, "vecdot", a, b, result, kind);
+}
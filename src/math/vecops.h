@@ -0,0 +1,11 @@
+/* Bulk operations on native int64 and num64 arrays. */
+void MVM_vecops_add(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b);
+void MVM_vecops_mul(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b);
+void MVM_vecops_fma(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b, MVMObject *c);
+void MVM_vecops_eq(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b);
+void MVM_vecops_lt(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b);
+void MVM_vecops_le(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b);
+void MVM_vecops_sum(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind);
+void MVM_vecops_min(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind);
+void MVM_vecops_max(MVMThreadContext *tc, MVMObject *a, MVMRegister *result, MVMuint16 kind);
+void MVM_vecops_dot(MVMThreadContext *tc, MVMObject *a, MVMObject *b, MVMRegister *result, MVMuint16 kind);
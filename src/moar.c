@@ -77,9 +77,9 @@ MVMInstance * MVM_vm_create_instance(void) {
 
     char *spesh_log, *spesh_nodelay, *spesh_disable, *spesh_inline_disable,
          *spesh_osr_disable, *spesh_limit, *spesh_blocking, *spesh_inline_log,
-         *spesh_pea_disable;
+         *spesh_pea_disable, *spesh_tco_disable;
     char *jit_expr_disable, *jit_disable, *jit_last_frame, *jit_last_bb;
-    char *dynvar_log;
+    char *dynvar_log, *spesh_hot_hints;
     int init_stat;
 
     /* Set up instance data structure. */
@@ -138,6 +138,12 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up loaded compunits hash mutex. */
     init_mutex(instance->mutex_loaded_compunits, "loaded compunits");
 
+    /* Set up bytecode validation cache mutex. */
+    init_mutex(instance->mutex_validation_cache, "validation cache");
+
+    /* Set up hot frame hints mutex. */
+    init_mutex(instance->mutex_spesh_hot_hints, "spesh hot frame hints");
+
     /* Set up container registry mutex. */
     init_mutex(instance->mutex_container_registry, "container registry");
 
@@ -153,6 +159,9 @@ MVMInstance * MVM_vm_create_instance(void) {
     instance->int_const_cache = MVM_calloc(1, sizeof(MVMIntConstCache));
     instance->int_to_str_cache = MVM_calloc(MVM_INT_TO_STR_CACHE_SIZE, sizeof(MVMString *));
 
+    /* Set up string interning mutex; the table is created on first use. */
+    init_mutex(instance->mutex_string_intern, "string intern table");
+
     /* Initialize Unicode database and NFG. */
     MVM_unicode_init(instance->main_thread);
     MVM_nfg_init(instance->main_thread);
@@ -223,6 +232,9 @@ MVMInstance * MVM_vm_create_instance(void) {
         spesh_pea_disable = getenv("MVM_SPESH_PEA_DISABLE");
         if (!spesh_pea_disable || !spesh_pea_disable[0])
             instance->spesh_pea_enabled = 1;
+        spesh_tco_disable = getenv("MVM_SPESH_TCO_DISABLE");
+        if (!spesh_tco_disable || !spesh_tco_disable[0])
+            instance->spesh_tco_enabled = 1;
     }
 
     init_mutex(instance->mutex_parameterization_add, "parameterization");
@@ -349,7 +361,26 @@ MVMInstance * MVM_vm_create_instance(void) {
     }
     else
         instance->dynvar_log_fh = NULL;
+#ifndef MVM_BIGENDIAN
+    /* Validation also byte-swaps the bytecode on big endian platforms, so it
+     * can't be skipped there. */
+    {
+        char *validation_cache = getenv("MVM_VALIDATION_CACHE");
+        if (validation_cache && validation_cache[0]) {
+            size_t len = strlen(validation_cache) + 1;
+            instance->validation_cache_dir = MVM_malloc(len);
+            memcpy(instance->validation_cache_dir, validation_cache, len);
+        }
+    }
+#endif
+    spesh_hot_hints = getenv("MVM_SPESH_HOT_HINTS");
+    if (spesh_hot_hints && spesh_hot_hints[0]) {
+        size_t len = strlen(spesh_hot_hints) + 1;
+        instance->spesh_hot_hints_dir = MVM_malloc(len);
+        memcpy(instance->spesh_hot_hints_dir, spesh_hot_hints, len);
+    }
     instance->nfa_debug_enabled = getenv("MVM_NFA_DEB") ? 1 : 0;
+    instance->multi_cache_stats = getenv("MVM_MULTI_CACHE_STATS") ? 1 : 0;
     if (getenv("MVM_CROSS_THREAD_WRITE_LOG")) {
         instance->cross_thread_write_logging = 1;
         instance->cross_thread_write_logging_include_locked =
@@ -485,6 +516,8 @@ void MVM_vm_exit(MVMInstance *instance) {
         fprintf(instance->dynvar_log_fh, "- x 0 0 0 0 %"PRId64" %"PRIu64" %"PRIu64"\n", instance->dynvar_log_lasttime, uv_hrtime(), uv_hrtime());
         fclose(instance->dynvar_log_fh);
     }
+    MVM_validation_cache_write(instance);
+    MVM_spesh_hot_hints_write(instance);
 
     /* And, we're done. */
     exit(0);
@@ -577,6 +610,18 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
 
     /* Clean up Hash of filenames of compunits loaded from disk. */
     uv_mutex_destroy(&instance->mutex_loaded_compunits);
+
+    /* Write out and clean up bytecode validation caches. */
+    MVM_validation_cache_write(instance);
+    MVM_validation_cache_destroy(instance);
+    uv_mutex_destroy(&instance->mutex_validation_cache);
+    MVM_free(instance->validation_cache_dir);
+
+    /* Write out and clean up hot frame hints. */
+    MVM_spesh_hot_hints_write(instance);
+    MVM_spesh_hot_hints_destroy(instance);
+    uv_mutex_destroy(&instance->mutex_spesh_hot_hints);
+    MVM_free(instance->spesh_hot_hints_dir);
     MVM_HASH_DESTROY(instance->main_thread, hash_handle, MVMLoadedCompUnitName, instance->loaded_compunits);
 
     /* Clean up Container registry. */
@@ -589,8 +634,10 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     /* Clean up Hash of hashes of symbol tables per hll. */
     uv_mutex_destroy(&instance->mutex_hll_syms);
 
-    /* Clean up multi cache addition mutex. */
+    /* Clean up multi cache addition mutex and the list of dead megamorphic
+     * caches. */
     uv_mutex_destroy(&instance->mutex_multi_cache_add);
+    MVM_VECTOR_DESTROY(instance->multi_cache_megamorphic_dead);
 
     /* Clean up parameterization addition mutex. */
     uv_mutex_destroy(&instance->mutex_parameterization_add);
@@ -632,6 +679,10 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_free(instance->int_const_cache);
     MVM_free(instance->int_to_str_cache);
 
+    /* Clean up string interning table. */
+    uv_mutex_destroy(&instance->mutex_string_intern);
+    MVM_string_intern_destroy(instance);
+
     /* Clean up event loop mutex. */
     uv_mutex_destroy(&instance->mutex_event_loop);
 
@@ -106,6 +106,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/frame.h"
 #include "core/callstack.h"
 #include "core/validation.h"
+#include "core/validationcache.h"
 #include "core/bytecode.h"
 #include "core/bytecodedump.h"
 #include "core/ops.h"
@@ -114,6 +115,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/loadbytecode.h"
 #include "core/bitmap.h"
 #include "math/num.h"
+#include "math/vecops.h"
 #include "core/coerce.h"
 #include "core/ext.h"
 #ifdef HAVE_LIBFFI
@@ -157,6 +159,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "spesh/deopt.h"
 #include "spesh/log.h"
 #include "spesh/threshold.h"
+#include "spesh/hothints.h"
 #include "spesh/inline.h"
 #include "spesh/osr.h"
 #include "spesh/iterator.h"
@@ -172,11 +175,13 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "strings/decode_stream.h"
 #include "strings/ascii.h"
 #include "strings/parse_num.h"
+#include "strings/scan.h"
 #include "strings/utf8.h"
 #include "strings/utf8_c8.h"
 #include "strings/utf16.h"
 #include "strings/iter.h"
 #include "strings/ops.h"
+#include "strings/intern.h"
 #include "strings/unicode_gen.h"
 #include "strings/unicode.h"
 #include "strings/latin1.h"
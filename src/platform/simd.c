@@ -0,0 +1,21 @@
+#include "moar.h"
+#include "platform/simd.h"
+
+MVMint32 MVM_platform_simd_level(void) {
+    /* Racing to set this up is harmless; everyone ends up with the same. */
+    static MVMint32 level = -1;
+    if (level < 0) {
+#if MVM_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            level = MVM_SIMD_AVX2;
+        else if (__builtin_cpu_supports("sse2"))
+            level = MVM_SIMD_SSE2;
+        else
+            level = MVM_SIMD_NONE;
+#else
+        level = MVM_SIMD_NONE;
+#endif
+    }
+    return level;
+}
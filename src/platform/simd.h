@@ -0,0 +1,21 @@
+/* Support for SIMD kernels that are picked at runtime by what the CPU we
+ * are running on supports. On x86 with GCC or Clang, functions marked with
+ * MVM_SIMD_TARGET may use the SSE2 or AVX2 intrinsics from <immintrin.h>,
+ * even if the rest of the VM is built for a plainer CPU; elsewhere there
+ * are no kernels, and only the portable code is used. */
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MVM_SIMD_X86 1
+#include <immintrin.h>
+#define MVM_SIMD_TARGET(features) __attribute__((target(features)))
+#else
+#define MVM_SIMD_X86 0
+#endif
+
+/* Which kernels the CPU can use. The AVX2 level also implies FMA, which
+ * every CPU with AVX2 we know of has. */
+#define MVM_SIMD_NONE 0
+#define MVM_SIMD_SSE2 1
+#define MVM_SIMD_AVX2 2
+
+MVMint32 MVM_platform_simd_level(void);
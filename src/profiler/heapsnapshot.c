@@ -370,9 +370,10 @@ static void process_workitems(MVMThreadContext *tc, MVMHeapSnapshotState *ss) {
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
                     (MVMCollectable *)st->method_cache, "Method cache");
 
-                for (i = 0; i < st->type_check_cache_length; i++)
-                    MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                        (MVMCollectable *)st->type_check_cache[i], "Type cache entry");
+                if (st->type_check_cache)
+                    for (i = 0; i < st->type_check_cache->length; i++)
+                        MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
+                            (MVMCollectable *)st->type_check_cache->types[i], "Type cache entry");
 
                 if (st->container_spec && st->container_spec->gc_mark_data) {
                     st->container_spec->gc_mark_data(tc, st, ss->gcwl);
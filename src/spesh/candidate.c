@@ -191,6 +191,9 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     MVM_barrier();
     spesh->body.num_spesh_candidates++;
 
+    /* Remember the frame is hot, for the sake of later runs. */
+    MVM_spesh_hot_hints_add(tc, p->sf);
+
     /* If we're logging, dump the upadated arg guards also. */
     if (MVM_spesh_debug_enabled(tc)) {
         char *guard_dump = MVM_spesh_dump_arg_guard(tc, p->sf);
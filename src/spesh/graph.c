@@ -354,6 +354,11 @@ static void build_cfg(MVMThreadContext *tc, MVMSpeshGraph *g, MVMStaticFrame *sf
         case MVM_OP_invoke_n:
         case MVM_OP_invoke_s:
         case MVM_OP_invoke_o:
+        case MVM_OP_sp_tailinvoke_v:
+        case MVM_OP_sp_tailinvoke_i:
+        case MVM_OP_sp_tailinvoke_n:
+        case MVM_OP_sp_tailinvoke_s:
+        case MVM_OP_sp_tailinvoke_o:
         case MVM_OP_return_i:
         case MVM_OP_return_n:
         case MVM_OP_return_s:
@@ -0,0 +1,103 @@
+#include "moar.h"
+
+/* Each run has to gather statistics on a frame before it is hot enough to
+ * be specialized and JIT-compiled, so a program only reaches its peak speed
+ * after warming up. When MVM_SPESH_HOT_HINTS is set to a directory, we record
+ * there which frames of each compilation unit loaded from a file were
+ * specialized, and in later runs lower the threshold for those frames, so
+ * they are specialized from the first statistics gathered on them.
+ *
+ * The specializations themselves are not cached: they, and the machine code
+ * the JIT produces from them, refer to objects (types, STables, spesh slot
+ * contents) by their address in this particular process. */
+
+/* Magic at the start of a hints file; bump it if the format changes. */
+static const char MAGIC[MVM_VALIDATION_CACHE_MAGIC_SIZE] = { 'M', 'V', 'M', 'H', 'O', 'T', '0', '1' };
+
+/* Gets the hot frame hints of a compilation unit, setting them up the first
+ * time. Returns NULL if the compilation unit can't have any, because it was
+ * not loaded from a file. Called with the compilation unit's frame
+ * deserialization lock held. */
+static MVMSpeshHotHints * get_hints(MVMThreadContext *tc, MVMCompUnit *cu) {
+    MVMInstance *instance = tc->instance;
+    if (!cu->body.spesh_hot_hints_checked) {
+        cu->body.spesh_hot_hints_checked = 1;
+        if (cu->body.deallocate == MVM_DEALLOCATE_UNMAP) {
+            MVMSpeshHotHints *hints = MVM_calloc(1, sizeof(MVMSpeshHotHints));
+            memcpy(hints->hash, MVM_validation_cache_hash(tc, cu), sizeof(hints->hash));
+            hints->known = MVM_validation_cache_read_entries(instance->spesh_hot_hints_dir,
+                hints->hash, ".hot", MAGIC, &(hints->num_known));
+
+            uv_mutex_lock(&instance->mutex_spesh_hot_hints);
+            hints->next = instance->spesh_hot_hints;
+            instance->spesh_hot_hints = hints;
+            uv_mutex_unlock(&instance->mutex_spesh_hot_hints);
+
+            cu->body.spesh_hot_hints = hints;
+        }
+    }
+    return cu->body.spesh_hot_hints;
+}
+
+/* Checks if a static frame was specialized in an earlier run, and if so
+ * marks it as known to be hot. Called when the frame is prepared. */
+void MVM_spesh_hot_hints_lookup(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMSpeshHotHints *hints;
+    MVMint64          offset;
+    if (!tc->instance->spesh_hot_hints_dir || !tc->instance->spesh_enabled)
+        return;
+    hints = get_hints(tc, sf->body.cu);
+    if (!hints || (offset = MVM_validation_cache_frame_offset(sf)) < 0)
+        return;
+    if (MVM_validation_cache_find_entry(hints->known, hints->num_known, (MVMuint32)offset))
+        sf->body.spesh_known_hot = 1;
+}
+
+/* Notes that a static frame was specialized. Called on the spesh worker
+ * thread; the frame was prepared, so its compilation unit's hints were set
+ * up already, if it has one. */
+void MVM_spesh_hot_hints_add(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMInstance      *instance = tc->instance;
+    MVMSpeshHotHints *hints;
+    MVMint64          offset;
+    if (!instance->spesh_hot_hints_dir || sf->body.spesh_known_hot)
+        return;
+    hints = sf->body.cu->body.spesh_hot_hints;
+    if (!hints || (offset = MVM_validation_cache_frame_offset(sf)) < 0)
+        return;
+    uv_mutex_lock(&instance->mutex_spesh_hot_hints);
+    if (!instance->spesh_hot_hints_written)
+        MVM_VECTOR_PUSH(hints->added, (MVMuint32)offset);
+    uv_mutex_unlock(&instance->mutex_spesh_hot_hints);
+}
+
+/* Writes out the hints files that have new entries. Only done once; the
+ * spesh worker may still be running, so the hints are kept around until
+ * the instance is destroyed. */
+void MVM_spesh_hot_hints_write(MVMInstance *instance) {
+    MVMSpeshHotHints *hints;
+    if (!instance->spesh_hot_hints_dir)
+        return;
+    uv_mutex_lock(&instance->mutex_spesh_hot_hints);
+    if (!instance->spesh_hot_hints_written) {
+        instance->spesh_hot_hints_written = 1;
+        for (hints = instance->spesh_hot_hints; hints; hints = hints->next)
+            MVM_validation_cache_write_entries(instance->spesh_hot_hints_dir, hints->hash,
+                ".hot", MAGIC, hints->known, hints->num_known,
+                hints->added, MVM_VECTOR_ELEMS(hints->added));
+    }
+    uv_mutex_unlock(&instance->mutex_spesh_hot_hints);
+}
+
+/* Frees the hot frame hints. */
+void MVM_spesh_hot_hints_destroy(MVMInstance *instance) {
+    MVMSpeshHotHints *hints = instance->spesh_hot_hints;
+    while (hints) {
+        MVMSpeshHotHints *next = hints->next;
+        MVM_VECTOR_DESTROY(hints->added);
+        MVM_free(hints->known);
+        MVM_free(hints);
+        hints = next;
+    }
+    instance->spesh_hot_hints = NULL;
+}
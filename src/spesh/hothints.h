@@ -0,0 +1,25 @@
+/* Frames of a compilation unit that got specialized in earlier runs, from a
+ * hints file kept across runs. Compilation units and frames are identified
+ * the same way as in the bytecode validation cache. */
+struct MVMSpeshHotHints {
+    /* Hex SHA-1 of the compilation unit, which names the hints file. */
+    char hash[41];
+
+    /* Sorted offsets of the bytecode of frames known to be hot. */
+    MVMuint32 *known;
+    MVMuint32  num_known;
+
+    /* Offsets of frames specialized during this run, to be written out. */
+    MVM_VECTOR_DECL(MVMuint32, added);
+
+    /* Next hints in the instance's list of them. */
+    MVMSpeshHotHints *next;
+};
+
+/* The specialization threshold used for frames known to be hot. */
+#define MVM_SPESH_HOT_HINTS_THRESHOLD 10
+
+void MVM_spesh_hot_hints_lookup(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_spesh_hot_hints_add(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_spesh_hot_hints_write(MVMInstance *instance);
+void MVM_spesh_hot_hints_destroy(MVMInstance *instance);
@@ -227,6 +227,47 @@ int MVM_spesh_inline_get_max_size(MVMThreadContext *tc, MVMStaticFrame *sf) {
     return sf->body.cu->body.hll_config->max_inline_size;
 }
 
+/* Tail invocations in the inlinee are no longer in tail position once it is
+ * part of the inliner, so turn them back into normal invocations. */
+static void untail_invokes(MVMThreadContext *tc, MVMSpeshGraph *ig) {
+    MVMSpeshBB *bb = ig->entry;
+    while (bb) {
+        MVMSpeshIns *ins = bb->first_ins;
+        while (ins) {
+            MVMint16 cand;
+            switch (ins->info->opcode) {
+                case MVM_OP_sp_tailinvoke_v:
+                    cand = ins->operands[1].lit_i16;
+                    ins->info = MVM_op_get_op(cand >= 0
+                        ? MVM_OP_sp_fastinvoke_v : MVM_OP_invoke_v);
+                    break;
+                case MVM_OP_sp_tailinvoke_i:
+                    cand = ins->operands[2].lit_i16;
+                    ins->info = MVM_op_get_op(cand >= 0
+                        ? MVM_OP_sp_fastinvoke_i : MVM_OP_invoke_i);
+                    break;
+                case MVM_OP_sp_tailinvoke_n:
+                    cand = ins->operands[2].lit_i16;
+                    ins->info = MVM_op_get_op(cand >= 0
+                        ? MVM_OP_sp_fastinvoke_n : MVM_OP_invoke_n);
+                    break;
+                case MVM_OP_sp_tailinvoke_s:
+                    cand = ins->operands[2].lit_i16;
+                    ins->info = MVM_op_get_op(cand >= 0
+                        ? MVM_OP_sp_fastinvoke_s : MVM_OP_invoke_s);
+                    break;
+                case MVM_OP_sp_tailinvoke_o:
+                    cand = ins->operands[2].lit_i16;
+                    ins->info = MVM_op_get_op(cand >= 0
+                        ? MVM_OP_sp_fastinvoke_o : MVM_OP_invoke_o);
+                    break;
+            }
+            ins = ins->next;
+        }
+        bb = bb->linear_next;
+    }
+}
+
 /* Sees if it will be possible to inline the target code ref, given we could
  * already identify a spesh candidate. Returns NULL if no inlining is possible
  * or a graph ready to be merged if it will be possible. */
@@ -254,6 +295,7 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
     /* Build graph from the already-specialized bytecode and check if we can
      * inline the graph. */
     ig = MVM_spesh_graph_create_from_cand(tc, target_sf, cand, 0, &deopt_usage_ins);
+    untail_invokes(tc, ig);
     if (is_graph_inlineable(tc, inliner, target_sf, invoke_ins, ig, no_inline_reason, no_inline_info)) {
         /* We can inline it. Do facts discovery, which also sets usage counts.
          * We also need to bump counts for any inline's code_ref_reg to make
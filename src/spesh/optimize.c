@@ -2783,6 +2783,11 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
         case MVM_OP_bindpos_s:
         case MVM_OP_bindpos_o:
         case MVM_OP_deletekey:
+        case MVM_OP_bindikey_i:
+        case MVM_OP_bindikey_n:
+        case MVM_OP_bindikey_s:
+        case MVM_OP_bindikey_o:
+        case MVM_OP_deleteikey:
         case MVM_OP_setelemspos:
         case MVM_OP_splice:
         case MVM_OP_bindattr_i:
@@ -2816,6 +2821,11 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
         case MVM_OP_pop_o:
         case MVM_OP_existskey:
         case MVM_OP_existspos:
+        case MVM_OP_atikey_i:
+        case MVM_OP_atikey_n:
+        case MVM_OP_atikey_s:
+        case MVM_OP_atikey_o:
+        case MVM_OP_existsikey:
         case MVM_OP_getattr_i:
         case MVM_OP_getattr_n:
         case MVM_OP_getattr_s:
@@ -3319,6 +3329,121 @@ static void merge_bbs(MVMThreadContext *tc, MVMSpeshGraph *g) {
     }
 }
 
+/* Checks if a frame declares any lexical that a callee may look at through
+ * its caller chain: dynamic variables, and the $_, $/, $! and cursor
+ * variables that get set from the caller's point of view. Such frames must stay on the call
+ * stack for the duration of any call they make. */
+static MVMint32 has_caller_visible_lexicals(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMLexicalRegistry **lexreg = sf->body.lexical_names_list;
+    MVMuint32 i;
+    for (i = 0; i < sf->body.num_lexicals; i++) {
+        MVMString *name = lexreg[i]->key;
+        MVMuint32 graphs = MVM_string_graphs_nocheck(tc, name);
+        if (graphs >= 2) {
+            MVMGrapheme32 twigil = MVM_string_get_grapheme_at_nocheck(tc, name, 1);
+            if (twigil == '*')
+                return 1;
+            if (graphs == 2 && MVM_string_get_grapheme_at_nocheck(tc, name, 0) == '$' &&
+                    (twigil == '_' || twigil == '/' || twigil == '!' || twigil == 0xA2))
+                return 1;
+        }
+    }
+    return 0;
+}
+
+/* Finds the instruction that will be executed after the given one, if it is
+ * reached by simply falling through to it. */
+static MVMSpeshIns * next_fallthrough_ins(MVMThreadContext *tc, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    while (!ins->next) {
+        if (bb->num_succ != 1 || bb->succ[0] != bb->linear_next)
+            return NULL;
+        bb = bb->linear_next;
+        if (bb->inlined)
+            return NULL;
+        if (bb->first_ins)
+            return bb->first_ins;
+    }
+    return ins->next;
+}
+
+/* Looks for invocations in tail position, that is, those whose result is
+ * immediately returned, and turns them into tail invocations. These will at
+ * runtime try to reuse or replace the current frame rather than stacking a
+ * new one on top of it. This is only possible in frames that have no
+ * handlers, exit handlers, or state, and that don't declare anything that a
+ * callee might look up through its caller. */
+static void tail_call_pass(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    MVMSpeshBB *bb;
+    MVMStaticFrame *sf = g->sf;
+    if (g->num_handlers || sf->body.has_exit_handler || sf->body.has_state_vars)
+        return;
+    if (has_caller_visible_lexicals(tc, sf))
+        return;
+    bb = g->entry;
+    while (bb) {
+        MVMSpeshIns *ins = bb->inlined ? NULL : bb->first_ins;
+        while (ins) {
+            MVMuint16 tail_op   = 0;
+            MVMuint16 return_op = 0;
+            MVMint16  cand      = -1;
+            MVMSpeshIns *ret;
+            switch (ins->info->opcode) {
+                case MVM_OP_invoke_v: tail_op = MVM_OP_sp_tailinvoke_v; return_op = MVM_OP_return; break;
+                case MVM_OP_invoke_i: tail_op = MVM_OP_sp_tailinvoke_i; return_op = MVM_OP_return_i; break;
+                case MVM_OP_invoke_n: tail_op = MVM_OP_sp_tailinvoke_n; return_op = MVM_OP_return_n; break;
+                case MVM_OP_invoke_s: tail_op = MVM_OP_sp_tailinvoke_s; return_op = MVM_OP_return_s; break;
+                case MVM_OP_invoke_o: tail_op = MVM_OP_sp_tailinvoke_o; return_op = MVM_OP_return_o; break;
+                case MVM_OP_sp_fastinvoke_v:
+                    tail_op = MVM_OP_sp_tailinvoke_v; return_op = MVM_OP_return;
+                    cand = ins->operands[1].lit_i16;
+                    break;
+                case MVM_OP_sp_fastinvoke_i:
+                    tail_op = MVM_OP_sp_tailinvoke_i; return_op = MVM_OP_return_i;
+                    cand = ins->operands[2].lit_i16;
+                    break;
+                case MVM_OP_sp_fastinvoke_n:
+                    tail_op = MVM_OP_sp_tailinvoke_n; return_op = MVM_OP_return_n;
+                    cand = ins->operands[2].lit_i16;
+                    break;
+                case MVM_OP_sp_fastinvoke_s:
+                    tail_op = MVM_OP_sp_tailinvoke_s; return_op = MVM_OP_return_s;
+                    cand = ins->operands[2].lit_i16;
+                    break;
+                case MVM_OP_sp_fastinvoke_o:
+                    tail_op = MVM_OP_sp_tailinvoke_o; return_op = MVM_OP_return_o;
+                    cand = ins->operands[2].lit_i16;
+                    break;
+            }
+            if (tail_op && (ret = next_fallthrough_ins(tc, bb, ins)) &&
+                    ret->info->opcode == return_op &&
+                    (return_op == MVM_OP_return ||
+                        (ret->operands[0].reg.orig == ins->operands[0].reg.orig &&
+                         ret->operands[0].reg.i == ins->operands[0].reg.i))) {
+                /* The return instruction stays in place; it is reached if we
+                 * can't do the tail call at runtime and fall back to a normal
+                 * invocation. */
+                if (return_op == MVM_OP_return) {
+                    MVMSpeshOperand *operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+                    operands[0] = ins->operands[0];
+                    operands[1].lit_i16 = cand;
+                    ins->operands = operands;
+                }
+                else {
+                    MVMSpeshOperand *operands = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+                    operands[0] = ins->operands[0];
+                    operands[1] = ins->operands[1];
+                    operands[2].lit_i16 = cand;
+                    ins->operands = operands;
+                }
+                ins->info = MVM_op_get_op(tail_op);
+                MVM_spesh_graph_add_comment(tc, g, ins, "tail call");
+            }
+            ins = ins->next;
+        }
+        bb = bb->linear_next;
+    }
+}
+
 /* Drives the overall optimization work taking place on a spesh graph. */
 void MVM_spesh_optimize(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshPlanned *p) {
     /* Before starting, we eliminate dead basic blocks that were tossed by
@@ -3358,6 +3483,11 @@ void MVM_spesh_optimize(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshPlanned
     MVM_spesh_eliminate_dead_ins(tc, g);
     MVM_spesh_eliminate_dead_bbs(tc, g, 1);
 
+    /* With the graph in its final shape, turn calls in tail position into
+     * tail calls. */
+    if (tc->instance->spesh_tco_enabled)
+        tail_call_pass(tc, g);
+
 #if MVM_SPESH_CHECK_DU
     MVM_spesh_usages_check(tc, g);
 #endif
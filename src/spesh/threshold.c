@@ -6,6 +6,8 @@ MVMuint32 MVM_spesh_threshold(MVMThreadContext *tc, MVMStaticFrame *sf) {
     MVMuint32 bs = sf->body.bytecode_size;
     if (tc->instance->spesh_nodelay)
         return 1;
+    if (sf->body.spesh_known_hot)
+        return MVM_SPESH_HOT_HINTS_THRESHOLD;
     if (bs <= 2048)
         return 150;
     else if (bs <= 8192)
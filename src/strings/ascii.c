@@ -140,6 +140,8 @@ char * MVM_string_ascii_encode_substr(MVMThreadContext *tc, MVMString *str, MVMu
     size_t         result_alloc;
     MVMuint8      *repl_bytes = NULL;
     MVMuint64      repl_length;
+    MVMuint32      i = 0;
+    MVMCodepointIter ci;
 
     /* must check start first since it's used in the length check */
     if (start < 0 || start > strgraphs)
@@ -147,52 +149,46 @@ char * MVM_string_ascii_encode_substr(MVMThreadContext *tc, MVMString *str, MVMu
     if (length < -1 || start + lengthu > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
+    /* ASCII in 8-bit storage needs no encoding; copy it directly. */
+    if ((result = (MVMuint8 *)MVM_string_encode_8bit_copy(tc, str, (MVMStringIndex)start,
+            lengthu, 0, translate_newlines, output_size)))
+        return (char *)result;
+
     if (replacement)
         repl_bytes = (MVMuint8 *) MVM_string_ascii_encode_substr(tc, replacement,
             &repl_length, 0, -1, NULL, translate_newlines);
 
     result_alloc = lengthu;
     result = MVM_malloc(result_alloc + 1);
-    if (str->body.storage_type == MVM_STRING_GRAPHEME_ASCII) {
-        /* No encoding needed; directly copy. */
-        memcpy(result, str->body.storage.blob_ascii, lengthu);
-        result[lengthu] = 0;
-        if (output_size)
-            *output_size = lengthu;
-    }
-    else {
-        MVMuint32 i = 0;
-        MVMCodepointIter ci;
-        MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
-        while (MVM_string_ci_has_more(tc, &ci)) {
-            MVMCodepoint ord = MVM_string_ci_get_codepoint(tc, &ci);
-            if (i == result_alloc) {
-                result_alloc += 8;
+    MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+    while (MVM_string_ci_has_more(tc, &ci)) {
+        MVMCodepoint ord = MVM_string_ci_get_codepoint(tc, &ci);
+        if (i == result_alloc) {
+            result_alloc += 8;
+            result = MVM_realloc(result, result_alloc + 1);
+        }
+        if (0 <= ord && ord <= 127) {
+            result[i++] = (MVMuint8)ord;
+        }
+        else if (replacement) {
+            if (repl_length >= result_alloc || i >= result_alloc - repl_length) {
+                result_alloc += repl_length;
                 result = MVM_realloc(result, result_alloc + 1);
             }
-            if (0 <= ord && ord <= 127) {
-                result[i++] = (MVMuint8)ord;
-            }
-            else if (replacement) {
-                if (repl_length >= result_alloc || i >= result_alloc - repl_length) {
-                    result_alloc += repl_length;
-                    result = MVM_realloc(result, result_alloc + 1);
-                }
-                memcpy(result + i, repl_bytes, repl_length);
-                i += repl_length;
-            }
-            else {
-                MVM_free(result);
-                MVM_free(repl_bytes);
-                MVM_exception_throw_adhoc(tc,
-                    "Error encoding ASCII string: could not encode codepoint %d",
-                    ord);
-            }
+            memcpy(result + i, repl_bytes, repl_length);
+            i += repl_length;
+        }
+        else {
+            MVM_free(result);
+            MVM_free(repl_bytes);
+            MVM_exception_throw_adhoc(tc,
+                "Error encoding ASCII string: could not encode codepoint %d",
+                ord);
         }
-        result[i] = 0;
-        if (output_size)
-            *output_size = i;
     }
+    result[i] = 0;
+    if (output_size)
+        *output_size = i;
 
     if (repl_bytes) MVM_free(repl_bytes);
     return (char *)result;
@@ -0,0 +1,113 @@
+#include "moar.h"
+
+/* Programs often end up with many copies of the same short strings, such as
+ * hash keys and identifiers decoded from input, and every lookup compares
+ * their graphemes again. Interning a string gets the one object that stands
+ * for all strings equal to it, so they can be compared by pointer. The
+ * table is keyed by the strings' hash codes, and uses open addressing with
+ * linear probing. It holds the strings weakly: after each GC run, entries
+ * for strings that died are dropped, and those for strings that moved are
+ * updated. Strings in the table are flagged with MVM_CF_INTERNED_STRING,
+ * which MVM_string_equal uses to know that two different interned strings
+ * can't be equal. */
+
+/* Initial number of slots; always a power of two. */
+#define INITIAL_SLOTS 64
+
+/* Puts a string into the first free slot for its hash code. */
+static void insert(MVMString **slots, MVMuint32 num_slots, MVMString *s) {
+    MVMuint32 mask = num_slots - 1;
+    MVMuint32 i    = (MVMuint32)s->body.cached_hash_code & mask;
+    while (slots[i])
+        i = (i + 1) & mask;
+    slots[i] = s;
+}
+
+/* Moves the strings in the table into a new set of slots. Also used to get
+ * rid of the holes left after removing entries, which would otherwise cut
+ * probe sequences short. */
+static void rebuild(MVMInstance *instance, MVMuint32 num_slots) {
+    MVMString **old_slots     = instance->interned_strings;
+    MVMuint32   old_num_slots = instance->num_interned_slots;
+    MVMString **slots         = MVM_calloc(num_slots, sizeof(MVMString *));
+    MVMuint32   i;
+    for (i = 0; i < old_num_slots; i++)
+        if (old_slots[i])
+            insert(slots, num_slots, old_slots[i]);
+    MVM_free(old_slots);
+    instance->interned_strings   = slots;
+    instance->num_interned_slots = num_slots;
+}
+
+/* Gets the interned string equal to the one passed, interning that one if
+ * there is none yet. */
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s) {
+    MVMInstance *instance = tc->instance;
+    MVMString   *found;
+    MVMuint64    hash;
+    MVMuint32    mask, i;
+
+    MVM_string_check_arg(tc, s, "intern");
+    if (s->common.header.flags & MVM_CF_INTERNED_STRING)
+        return s;
+    MVM_string_compute_hash_code(tc, s);
+    hash = s->body.cached_hash_code;
+
+    /* Nothing in here allocates, so we can't end up in GC holding the lock. */
+    uv_mutex_lock(&instance->mutex_string_intern);
+    if ((instance->num_interned + 1) * 2 > instance->num_interned_slots)
+        rebuild(instance, instance->num_interned_slots
+            ? instance->num_interned_slots * 2
+            : INITIAL_SLOTS);
+    mask = instance->num_interned_slots - 1;
+    i    = (MVMuint32)hash & mask;
+    while ((found = instance->interned_strings[i])) {
+        if (found->body.cached_hash_code == hash && MVM_string_equal(tc, found, s)) {
+            uv_mutex_unlock(&instance->mutex_string_intern);
+            return found;
+        }
+        i = (i + 1) & mask;
+    }
+    instance->interned_strings[i] = s;
+    instance->num_interned++;
+    s->common.header.flags |= MVM_CF_INTERNED_STRING;
+    uv_mutex_unlock(&instance->mutex_string_intern);
+    return s;
+}
+
+/* Called by the GC co-ordinator once marking is done, but before anything
+ * is freed. Drops the strings that were not marked, and updates those that
+ * were moved, taking into account which generation was collected. */
+void MVM_string_intern_gc_sweep(MVMThreadContext *tc, MVMuint8 gen) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    removed  = 0;
+    MVMuint32    i;
+    for (i = 0; i < instance->num_interned_slots; i++) {
+        MVMString *s = instance->interned_strings[i];
+        if (s) {
+            MVMuint32 flags = s->common.header.flags;
+            if (gen == MVMGCGenerations_Both || !(flags & MVM_CF_SECOND_GEN)) {
+                if (flags & MVM_CF_FORWARDER_VALID) {
+                    instance->interned_strings[i] =
+                        (MVMString *)s->common.header.sc_forward_u.forwarder;
+                }
+                else if (!(flags & MVM_CF_GEN2_LIVE)) {
+                    instance->interned_strings[i] = NULL;
+                    removed++;
+                }
+            }
+        }
+    }
+    if (removed) {
+        instance->num_interned -= removed;
+        rebuild(instance, instance->num_interned_slots);
+    }
+}
+
+/* Frees the interning table. */
+void MVM_string_intern_destroy(MVMInstance *instance) {
+    MVM_free(instance->interned_strings);
+    instance->interned_strings   = NULL;
+    instance->num_interned_slots = 0;
+    instance->num_interned       = 0;
+}
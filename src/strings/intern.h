@@ -0,0 +1,4 @@
+/* Interning of strings, so equal strings can share one object. */
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s);
+void MVM_string_intern_gc_sweep(MVMThreadContext *tc, MVMuint8 gen);
+void MVM_string_intern_destroy(MVMInstance *instance);
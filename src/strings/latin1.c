@@ -11,37 +11,43 @@ MVMString * MVM_string_latin1_decode(MVMThreadContext *tc, const MVMObject *resu
 
     MVMuint8 writing_32bit = 0;
 
+    /* Every Latin-1 byte fits in 8-bit storage as it is; only a \r\n, which
+     * is a synthetic, makes us go over to 32-bit storage. */
     result->body.storage_type   = MVM_STRING_GRAPHEME_8;
-    result->body.storage.blob_8 = MVM_malloc(sizeof(MVMint8) * bytes);
+    result->body.storage.blob_8 = MVM_malloc(sizeof(MVMGrapheme8) * bytes);
+    if (!memchr(latin1, '\r', bytes)) {
+        memcpy(result->body.storage.blob_8, latin1, bytes);
+        result->body.num_graphs = bytes;
+        MVM_string_maybe_compute_hash_code(tc, result);
+        return result;
+    }
 
     result_graphs = 0;
     for (i = 0; i < bytes; i++) {
         if (latin1[i] == '\r' && i + 1 < bytes && latin1[i + 1] == '\n') {
-            if (writing_32bit)
-                result->body.storage.blob_32[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
-            else
-                result->body.storage.blob_8[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
-            i++;
-        }
-        else {
-            if (latin1[i] > 127 && !writing_32bit) {
+            if (!writing_32bit) {
                 MVMGrapheme8 *old_storage = result->body.storage.blob_8;
 
                 result->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32) * bytes);
                 result->body.storage_type = MVM_STRING_GRAPHEME_32;
                 writing_32bit = 1;
 
-                for (k = 0; k < i; k++)
+                for (k = 0; k < result_graphs; k++)
                     result->body.storage.blob_32[k] = old_storage[k];
                 MVM_free(old_storage);
             }
-            if (writing_32bit)
-                result->body.storage.blob_32[result_graphs++] = latin1[i];
-            else
-                result->body.storage.blob_8[result_graphs++] = latin1[i];
+            result->body.storage.blob_32[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
+            i++;
+        }
+        else if (writing_32bit) {
+            result->body.storage.blob_32[result_graphs++] = latin1[i];
+        }
+        else {
+            result->body.storage.blob_8[result_graphs++] = latin1[i];
         }
     }
     result->body.num_graphs = result_graphs;
+    MVM_string_maybe_compute_hash_code(tc, result);
 
     return result;
 }
@@ -146,6 +152,8 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
     size_t result_alloc;
     MVMuint8 *repl_bytes = NULL;
     MVMuint64 repl_length;
+    MVMuint32 i = 0;
+    MVMCodepointIter ci;
 
     /* must check start first since it's used in the length check */
     if (start < 0 || start > strgraphs)
@@ -153,53 +161,47 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
     if (length < -1 || start + lengthu > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
+    /* Text in 8-bit storage needs no encoding; copy it directly. */
+    if ((result = (MVMuint8 *)MVM_string_encode_8bit_copy(tc, str, (MVMStringIndex)start,
+            lengthu, 1, translate_newlines, output_size)))
+        return (char *)result;
+
     if (replacement)
         repl_bytes = (MVMuint8 *) MVM_string_latin1_encode_substr(tc,
             replacement, &repl_length, 0, -1, NULL, translate_newlines);
 
     result_alloc = lengthu;
     result = MVM_malloc(result_alloc + 1);
-    if (str->body.storage_type == MVM_STRING_GRAPHEME_ASCII) {
-        /* No encoding needed; directly copy. */
-        memcpy(result, str->body.storage.blob_ascii, lengthu);
-        result[lengthu] = 0;
-        if (output_size)
-            *output_size = lengthu;
-    }
-    else {
-        MVMuint32 i = 0;
-        MVMCodepointIter ci;
-        MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
-        while (MVM_string_ci_has_more(tc, &ci)) {
-            MVMCodepoint ord = MVM_string_ci_get_codepoint(tc, &ci);
-            if (i == result_alloc) {
-                result_alloc += 8;
+    MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+    while (MVM_string_ci_has_more(tc, &ci)) {
+        MVMCodepoint ord = MVM_string_ci_get_codepoint(tc, &ci);
+        if (i == result_alloc) {
+            result_alloc += 8;
+            result = MVM_realloc(result, result_alloc + 1);
+        }
+        if (ord >= 0 && ord <= 255) {
+            result[i] = (MVMuint8)ord;
+            i++;
+        }
+        else if (replacement) {
+            if (repl_length >= result_alloc || i >= result_alloc - repl_length) {
+                result_alloc += repl_length;
                 result = MVM_realloc(result, result_alloc + 1);
             }
-            if (ord >= 0 && ord <= 255) {
-                result[i] = (MVMuint8)ord;
-                i++;
-            }
-            else if (replacement) {
-                if (repl_length >= result_alloc || i >= result_alloc - repl_length) {
-                    result_alloc += repl_length;
-                    result = MVM_realloc(result, result_alloc + 1);
-                }
-                memcpy(result + i, repl_bytes, repl_length);
-                i += repl_length;
-            }
-            else {
-                MVM_free(result);
-                MVM_free(repl_bytes);
-                MVM_exception_throw_adhoc(tc,
-                    "Error encoding Latin-1 string: could not encode codepoint %d",
-                    ord);
-            }
+            memcpy(result + i, repl_bytes, repl_length);
+            i += repl_length;
+        }
+        else {
+            MVM_free(result);
+            MVM_free(repl_bytes);
+            MVM_exception_throw_adhoc(tc,
+                "Error encoding Latin-1 string: could not encode codepoint %d",
+                ord);
         }
-        result[i] = 0;
-        if (output_size)
-            *output_size = i;
     }
+    result[i] = 0;
+    if (output_size)
+        *output_size = i;
     MVM_free(repl_bytes);
     return (char *)result;
 }
@@ -103,6 +103,20 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
     result_pos = 0;
     while (input_pos < cp_count) {
         MVMGrapheme32 g;
+
+        /* When nothing is buffered, copy over a run of stable codepoints in
+         * one go, leaving only the last of them to the normalizer. */
+        if (MVM_unicode_normalizer_empty(tc, &norm) && norm.prepend_buffer == 0) {
+            MVMint64 run = MVM_unicode_normalizer_nfg_stable_run(tc,
+                cp_v + input_pos, cp_count - input_pos) - 1;
+            if (run > 0) {
+                maybe_grow_result(&result, &result_alloc, result_pos + run);
+                memcpy(result + result_pos, cp_v + input_pos, run * sizeof(MVMGrapheme32));
+                result_pos += run;
+                input_pos  += run;
+            }
+        }
+
         ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, cp_v[input_pos], &g);
         if (ready) {
             maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -520,6 +534,64 @@ static MVMint32 is_grapheme_prepend(MVMThreadContext *tc, MVMCodepoint cp) {
     return MVM_unicode_codepoint_get_property_int(tc, cp,
         MVM_UNICODE_PROPERTY_PREPENDED_CONCATENATION_MARK);
 }
+
+/* Whether each codepoint is stable under NFG: it passes the NFG quick check,
+ * has a CCC of 0, and is neither a prepend nor a control. Two such in a row
+ * can neither compose nor join into one grapheme, so the first of them can be
+ * handed on as it is. Working this out takes several property lookups, so we
+ * do it for a block of codepoints at a time, the first time one of them is
+ * seen, and keep the answers in a bitmap. Unicode data doesn't change while
+ * we run, so this is shared by all instances; threads racing to fill in the
+ * same block write the same bits. */
+#define NFG_STABLE_CODEPOINTS  0x110000
+#define NFG_STABLE_BLOCK_SHIFT 8
+#define NFG_STABLE_BLOCK_WORDS ((1 << NFG_STABLE_BLOCK_SHIFT) / 32)
+static MVMuint32 nfg_stable_bits[NFG_STABLE_CODEPOINTS / 32];
+static AO_t nfg_stable_ready[NFG_STABLE_CODEPOINTS >> NFG_STABLE_BLOCK_SHIFT];
+
+static void compute_nfg_stable_block(MVMThreadContext *tc, MVMCodepoint block) {
+    MVMuint32    words[NFG_STABLE_BLOCK_WORDS] = { 0 };
+    MVMCodepoint first = block << NFG_STABLE_BLOCK_SHIFT;
+    MVMint32     i;
+    for (i = 0; i < (1 << NFG_STABLE_BLOCK_SHIFT); i++) {
+        MVMCodepoint cp = first + i;
+        const char *qc;
+        if (cp < 0x20 || (0x7F <= cp && cp <= 0x9F) || cp == 0xAD)
+            continue;
+        if (is_grapheme_prepend(tc, cp))
+            continue;
+        if (cp > 0xFF && MVM_string_is_control_full(tc, cp))
+            continue;
+        qc = MVM_unicode_codepoint_get_property_cstr(tc, cp, MVM_UNICODE_PROPERTY_NFG_QC);
+        if (!qc || qc[0] != 'Y' || MVM_unicode_relative_ccc(tc, cp) != 0)
+            continue;
+        words[i / 32] |= (MVMuint32)1 << (i % 32);
+    }
+    memcpy(nfg_stable_bits + block * NFG_STABLE_BLOCK_WORDS, words, sizeof(words));
+    MVM_store(&nfg_stable_ready[block], 1);
+}
+
+MVM_STATIC_INLINE MVMint32 is_nfg_stable(MVMThreadContext *tc, MVMCodepoint cp) {
+    MVMCodepoint block;
+    if (cp < 0 || cp >= NFG_STABLE_CODEPOINTS)
+        return 0;
+    block = cp >> NFG_STABLE_BLOCK_SHIFT;
+    if (MVM_UNLIKELY(!MVM_load(&nfg_stable_ready[block])))
+        compute_nfg_stable_block(tc, block);
+    return (nfg_stable_bits[cp / 32] >> (cp % 32)) & 1;
+}
+
+/* Returns how many codepoints from the start of the buffer are stable under
+ * NFG, per the above. With nothing buffered in the normalizer, all but the
+ * last of these are already normalized and may be copied out directly; the
+ * last must still go through the normalizer, since it may combine with what
+ * follows. */
+MVMint64 MVM_unicode_normalizer_nfg_stable_run(MVMThreadContext *tc, const MVMCodepoint *in, MVMint64 num_codepoints) {
+    MVMint64 i = 0;
+    while (i < num_codepoints && is_nfg_stable(tc, in[i]))
+        i++;
+    return i;
+}
 /* Returns 0 if the two graphemes should be combined and returns 1 or 2 if
  * the graphemes should break. 2 is returned if more than the currenly seen
  * graphemes may be needed to determine the breaking (this is only needed if
@@ -648,7 +720,20 @@ static void grapheme_composition(MVMThreadContext *tc, MVMNormalizer *n, MVMint3
  * compute the normalization. */
 MVMint32 MVM_unicode_normalizer_process_codepoint_full(MVMThreadContext *tc, MVMNormalizer *norm, MVMCodepoint in, MVMCodepoint *out) {
     MVMint64 qc_in, ccc_in;
-    int is_prepend = is_grapheme_prepend(tc, in);
+    int is_prepend;
+
+    /* Most input is already in NFG, so first see if both what we got in and
+     * the one thing in the buffer are stable, per the table, in which case
+     * we can hand back the buffered one without further checks. */
+    if (MVM_NORMALIZE_GRAPHEME(norm->form) && norm->prepend_buffer == 0
+            && norm->buffer_end - norm->buffer_start == 1
+            && is_nfg_stable(tc, in) && is_nfg_stable(tc, norm->buffer[norm->buffer_start])) {
+        *out = norm->buffer[norm->buffer_start];
+        norm->buffer[norm->buffer_start] = in;
+        return 1;
+    }
+
+    is_prepend = is_grapheme_prepend(tc, in);
 
     if (MVM_UNLIKELY(0 < norm->prepend_buffer))
         norm->prepend_buffer--;
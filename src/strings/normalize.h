@@ -133,6 +133,10 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint_to_grapheme(
     return MVM_unicode_normalizer_process_codepoint(tc, n, in, (MVMGrapheme32 *)out);
 }
 
+/* Get the length of the run of codepoints at the start of a buffer that are
+ * stable under NFG, and so need no normalization work between them. */
+MVMint64 MVM_unicode_normalizer_nfg_stable_run(MVMThreadContext *tc, const MVMCodepoint *in, MVMint64 num_codepoints);
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints);
 
@@ -187,7 +187,7 @@ static void move_strands(MVMThreadContext *tc, const MVMString *from, MVMuint16
         num_strands * sizeof(MVMStringStrand));
 }
 
-#define can_fit_into_8bit(g) ((-128 <= (g) && (g) <= 127))
+#define can_fit_into_8bit(g) ((0 <= (g) && (g) <= 255))
 
 MVM_STATIC_INLINE int can_fit_into_ascii (MVMGrapheme32 g) {
     return 0 <= g && g <= 127;
@@ -413,6 +413,70 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     return result;
 }
 
+/* Number of graphemes a strand stands for, counting its repetitions. */
+MVM_STATIC_INLINE MVMuint64 strand_graphs(MVMStringStrand *strand) {
+    return (MVMuint64)(strand->end - strand->start) * ((MVMuint64)strand->repetitions + 1);
+}
+
+/* Collapses just the trailing strands of a strand string, for when a string
+ * built up by appending has run out of strands. Collapsing the whole string
+ * each time would copy it once every MVM_STRING_MAX_STRANDS appends, making
+ * building it quadratic. Instead, we treat the strands like the leaves of a
+ * rope that is kept balanced by size: we merge the strands from the end as
+ * long as the strand before them is no more than twice the size of what we
+ * have merged so far. Any strand that gets merged so ends up in one at least
+ * half again as big, so each grapheme is copied a logarithmic number of
+ * times, and the strands left in front decrease in size geometrically, so
+ * there are few of them. If that would leave too many strands, or merge
+ * just the last one, the string was not built by appending, and we collapse
+ * all of it. */
+static MVMString * collapse_trailing_strands(MVMThreadContext *tc, MVMString *orig) {
+    MVMString *result = NULL;
+    MVMString *tail   = NULL;
+    MVMuint16  num_strands, keep;
+    MVMuint64  merged;
+
+    if (orig->body.storage_type != MVM_STRING_STRAND)
+        return orig;
+    num_strands = orig->body.num_strands;
+    keep        = num_strands - 1;
+    merged      = strand_graphs(&(orig->body.storage.strands[keep]));
+    while (keep > 0 && strand_graphs(&(orig->body.storage.strands[keep - 1])) <= 2 * merged) {
+        keep--;
+        merged += strand_graphs(&(orig->body.storage.strands[keep]));
+    }
+    if (keep == 0 || keep == num_strands - 1 || keep > MVM_STRING_MAX_STRANDS / 2)
+        return collapse_strands(tc, orig);
+
+    MVMROOT2(tc, orig, tail, {
+        /* Make a string of the strands to merge, and collapse it. */
+        tail = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        tail->body.storage_type    = MVM_STRING_STRAND;
+        tail->body.num_strands     = num_strands - keep;
+        tail->body.num_graphs      = (MVMStringIndex)merged;
+        tail->body.storage.strands = allocate_strands(tc, num_strands - keep);
+        copy_strands(tc, orig, keep, tail, 0, num_strands - keep);
+        tail = collapse_strands(tc, tail);
+
+        /* Put it after the strands we keep. */
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        result->body.storage_type    = MVM_STRING_STRAND;
+        result->body.num_strands     = keep + 1;
+        result->body.num_graphs      = orig->body.num_graphs;
+        result->body.storage.strands = allocate_strands(tc, keep + 1);
+        copy_strands(tc, orig, 0, result, 0, keep);
+        result->body.storage.strands[keep].blob_string = tail;
+        result->body.storage.strands[keep].start       = 0;
+        result->body.storage.strands[keep].end         = tail->body.num_graphs;
+        result->body.storage.strands[keep].repetitions = 0;
+    });
+#if (MVM_DEBUG_STRANDS || MVM_DEBUG_NFG)
+    if (!MVM_string_equal(tc, result, orig))
+        MVM_exception_throw_adhoc(tc, "result and original were not eq in collapse_trailing_strands");
+#endif
+    return result;
+}
+
 /* Takes a string that is no longer in NFG form after some concatenation-style
  * operation, and returns a new string that is in NFG. Note that we could do a
  * much, much, smarter thing in the future that doesn't involve all of this
@@ -538,25 +602,99 @@ static MVMint64 MVM_string_memmem_grapheme32 (MVMThreadContext *tc, MVMGrapheme3
     MVMGrapheme32 * rtrn = memmem_uint32(H_blob32 + H_start, H_graphs - H_start, n_blob32, n_graphs);
     return rtrn == NULL ? -1 : rtrn - H_blob32;
 }
+/* Copies the graphemes of a string of any storage type into a buffer. */
+static void graphemes_to_buf32(MVMThreadContext *tc, MVMString *s, MVMGrapheme32 *buf, MVMStringIndex graphs) {
+    MVMStringIndex i;
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32:
+            memcpy(buf, s->body.storage.blob_32, graphs * sizeof(MVMGrapheme32));
+            break;
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            for (i = 0; i < graphs; i++)
+                buf[i] = s->body.storage.blob_8[i];
+            break;
+        default: {
+            MVMGraphemeIter gi;
+            MVM_string_gi_init(tc, &gi, s);
+            for (i = 0; i < graphs; i++)
+                buf[i] = MVM_string_gi_get_grapheme(tc, &gi);
+        }
+    }
+}
 static MVMint64 MVM_string_memmem_grapheme32str (MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 H_start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
     MVMGrapheme32 *needle_buf = NULL;
     MVMint64 rtrn;
     if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) {
-        MVMStringIndex i;
-        MVMGraphemeIter n_gi;
-        needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme32));
-        if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) MVM_string_gi_init(tc, &n_gi, needle);
-        for (i = 0; i < needle->body.num_graphs; i++) {
-            needle_buf[i] = needle->body.storage_type == MVM_STRING_GRAPHEME_8 ? needle->body.storage.blob_8[i] : MVM_string_gi_get_grapheme(tc, &n_gi);
-        }
+        needle_buf = MVM_malloc(n_graphs * sizeof(MVMGrapheme32));
+        graphemes_to_buf32(tc, needle, needle_buf, n_graphs);
     }
     rtrn = MVM_string_memmem_grapheme32(tc, Haystack->body.storage.blob_32, needle_buf ? needle_buf : needle->body.storage.blob_32, H_start, H_graphs, n_graphs);
     if (needle_buf) MVM_free(needle_buf);
     return rtrn;
 }
+/* Finds where in the current strand (or repetition of it) of a grapheme
+ * iterator the grapheme g next occurs, from the iterator's position on.
+ * Returns the end of the strand if it does not. */
+static MVMStringIndex gi_scan_grapheme(MVMThreadContext *tc, MVMGraphemeIter *gi, MVMGrapheme32 g) {
+    if (gi->blob_type == MVM_STRING_GRAPHEME_32)
+        return gi->pos + MVM_string_scan_grapheme32(gi->active_blob.blob_32 + gi->pos,
+            gi->end - gi->pos, g);
+    if (can_fit_into_8bit(g)) {
+        MVMGrapheme8 *found = memchr(gi->active_blob.blob_8 + gi->pos, g, gi->end - gi->pos);
+        if (found)
+            return found - gi->active_blob.blob_8;
+    }
+    return gi->end;
+}
+/* Searches for a needle, already copied into a buffer, in a strand Haystack
+ * without flattening it. We go through the Haystack a strand (or repetition
+ * of one) at a time, skipping to where the first grapheme of the needle
+ * occurs with a vectorized scan, and checking the rest of the needle from
+ * there, which may run on into the strands that follow. For needles such as
+ * "aaab", checking can be a lot more work than scanning; if it gets to be,
+ * we hand over to Knuth-Morris-Pratt, which takes linear time. */
+static MVMint64 string_index_by_strand(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMGrapheme32 *n_buf, MVMint64 start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
+    MVMGraphemeIter gi;
+    /* The Haystack index of gi.pos, and the last index a match can start at. */
+    MVMint64  index = start;
+    MVMint64  last  = (MVMint64)H_graphs - n_graphs;
+    MVMuint64 checked = 0;
+    MVM_string_gi_init(tc, &gi, Haystack);
+    if (start)
+        MVM_string_gi_move_to(tc, &gi, start);
+    while (index <= last) {
+        MVMStringIndex found = gi_scan_grapheme(tc, &gi, n_buf[0]);
+        index += found - gi.pos;
+        if (found < gi.end) {
+            MVMGraphemeIter check = gi;
+            MVMStringIndex  i;
+            if (last < index)
+                break;
+            check.pos = found + 1;
+            for (i = 1; i < n_graphs; i++)
+                if (MVM_string_gi_get_grapheme(tc, &check) != n_buf[i])
+                    break;
+            if (i == n_graphs)
+                return index;
+            checked += i;
+            if (checked > 2 * (MVMuint64)(index - start) + 256
+                    && n_graphs <= MVM_string_KMP_max_pattern_length)
+                return knuth_morris_pratt_string_index(tc, needle, Haystack, index + 1);
+            gi.pos = found + 1;
+            index++;
+        }
+        else if (MVM_string_gi_has_more_strands_rep(tc, &gi)) {
+            MVM_string_gi_next_strand_rep(tc, &gi);
+        }
+        else {
+            break;
+        }
+    }
+    return -1;
+}
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
-    size_t index           = (size_t)start;
     MVMStringIndex H_graphs, n_graphs;
     MVM_string_check_arg(tc, Haystack, "index search target");
     MVM_string_check_arg(tc,   needle, "index search term");
@@ -575,84 +713,64 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
     if (H_graphs < n_graphs || n_graphs < 1)
         return -1;
 
-    /* Fast paths when storage types are identical. Uses memmem function, which
-     * uses Knuth-Morris-Pratt algorithm on Linux and on others
-     * Crochemore+Perrin two-way string matching */
+    /* Flat Haystacks are searched with memmem, after bringing the needle to
+     * the same width if it isn't already. It uses Crochemore+Perrin two-way
+     * string matching (or Knuth-Morris-Pratt on some platforms). */
     switch (Haystack->body.storage_type) {
         case MVM_STRING_GRAPHEME_32:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_32 || needle->body.num_graphs < 100) {
-                return MVM_string_memmem_grapheme32str(tc, Haystack, needle, start, H_graphs, n_graphs);
-            }
-            break;
-        case MVM_STRING_GRAPHEME_8:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_8 || needle->body.num_graphs < 100) {
-                void         *mm_return_8 = NULL;
-                MVMGrapheme8 *needle_buf  = NULL;
-                if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) {
-                    MVMStringIndex i;
-                    MVMGraphemeIter n_gi;
-                    needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme8));
-                    if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) MVM_string_gi_init(tc, &n_gi, needle);
-                    for (i = 0; i < needle->body.num_graphs; i++) {
-                        MVMGrapheme32 g = needle->body.storage_type == MVM_STRING_GRAPHEME_32
-                            ? needle->body.storage.blob_32[i]
-                            : MVM_string_gi_get_grapheme(tc, &n_gi);
-                        /* Haystack is 8 bit, needle is 32 bit. if we encounter a non8bit grapheme
-                         * it's impossible to match */
-                        if (!can_fit_into_8bit(g)) {
-                            MVM_free(needle_buf);
-                            return -1;
-                        }
-                        needle_buf[i] = g;
+            return MVM_string_memmem_grapheme32str(tc, Haystack, needle, start, H_graphs, n_graphs);
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            void         *mm_return_8 = NULL;
+            MVMGrapheme8 *needle_buf  = NULL;
+            if (needle->body.storage_type != MVM_STRING_GRAPHEME_8
+                    && needle->body.storage_type != MVM_STRING_GRAPHEME_ASCII) {
+                MVMStringIndex i;
+                MVMGraphemeIter n_gi;
+                needle_buf = MVM_malloc(n_graphs * sizeof(MVMGrapheme8));
+                if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) MVM_string_gi_init(tc, &n_gi, needle);
+                for (i = 0; i < n_graphs; i++) {
+                    MVMGrapheme32 g = needle->body.storage_type == MVM_STRING_GRAPHEME_32
+                        ? needle->body.storage.blob_32[i]
+                        : MVM_string_gi_get_grapheme(tc, &n_gi);
+                    /* Haystack is 8 bit, needle is 32 bit. if we encounter a non8bit grapheme
+                     * it's impossible to match */
+                    if (!can_fit_into_8bit(g)) {
+                        MVM_free(needle_buf);
+                        return -1;
                     }
+                    needle_buf[i] = g;
                 }
-                mm_return_8 = MVM_memmem(
-                    Haystack->body.storage.blob_8 + start, /* start position */
-                    (H_graphs - start) * sizeof(MVMGrapheme8), /* length of Haystack from start position to end */
-                    needle_buf ? needle_buf : needle->body.storage.blob_8, /* needle start */
-                    n_graphs * sizeof(MVMGrapheme8) /* needle length */
-                );
-                if (needle_buf) MVM_free(needle_buf);
-                if (mm_return_8 == NULL)
-                    return -1;
-                else
-                    return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
             }
-            break;
-    }
-    /* Minimal code version for needles of size 1 */
-    if (n_graphs == 1) {
-        MVMGraphemeIter H_gi;
-        MVMGrapheme32 n_g = MVM_string_get_grapheme_at_nocheck(tc, needle, 0);
-        MVM_string_gi_init(tc, &H_gi, Haystack);
-        if (index) MVM_string_gi_move_to(tc, &H_gi, index);
-        while (index < H_graphs) {
-            if (n_g == MVM_string_gi_get_grapheme(tc, &H_gi))
-                return (MVMint64)index;
-            index++;
+            mm_return_8 = MVM_memmem(
+                Haystack->body.storage.blob_8 + start, /* start position */
+                (H_graphs - start) * sizeof(MVMGrapheme8), /* length of Haystack from start position to end */
+                needle_buf ? needle_buf : needle->body.storage.blob_8, /* needle start */
+                n_graphs * sizeof(MVMGrapheme8) /* needle length */
+            );
+            if (needle_buf) MVM_free(needle_buf);
+            if (mm_return_8 == NULL)
+                return -1;
+            else
+                return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
         }
-    }
-    else if (n_graphs <= MVM_string_KMP_max_pattern_length)
-        return knuth_morris_pratt_string_index(tc, needle, Haystack, start);
-    else {
-        int is_gic = Haystack->body.storage_type == MVM_STRING_STRAND ? 1 : 0;
-        void *Hs_or_gic = Haystack;
-        /* If Haystack is a strand allocate space for a MVMGraphemeIter_cached
-         * and initialize it */
-        if (is_gic) {
-            Hs_or_gic = alloca(sizeof(MVMGraphemeIter_cached));
-            MVM_string_gi_cached_init(tc, Hs_or_gic, Haystack, start);
-        }
-        /* For needles > MVM_string_KMP_max_pattern_length we must revert to brute force for now.
-         * Eventually we can implement brute force after it matches the whole needle OR
-         * allocate more space for the pattern on reaching the end of the pattern */
-        while (index <= H_graphs - n_graphs) {
-            if (string_equal_at_ignore_case_INTERNAL_loop(tc, Hs_or_gic, needle, index, H_graphs, n_graphs, 0, 0, is_gic) != -1)
-                return (MVMint64)index;
-            index++;
+        default: {
+            /* Strand Haystacks are searched strand by strand, with the needle
+             * in a buffer; up to 2K of that goes onto the stack. */
+            MVMGrapheme32 *n_buf;
+            MVMint64       result;
+            if (n_graphs <= 512) {
+                n_buf = alloca(n_graphs * sizeof(MVMGrapheme32));
+                graphemes_to_buf32(tc, needle, n_buf, n_graphs);
+                return string_index_by_strand(tc, Haystack, needle, n_buf, start, H_graphs, n_graphs);
+            }
+            n_buf = MVM_malloc(n_graphs * sizeof(MVMGrapheme32));
+            graphemes_to_buf32(tc, needle, n_buf, n_graphs);
+            result = string_index_by_strand(tc, Haystack, needle, n_buf, start, H_graphs, n_graphs);
+            MVM_free(n_buf);
+            return result;
         }
     }
-    return -1;
 }
 
 /* Returns the location of one string in another or -1  */
@@ -925,7 +1043,8 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
         /* Otherwise, construct a new strand string. */
         else {
             /* See if we have too many strands between the two. If so, we will
-             * collapse the biggest side. */
+             * collapse the end of a if it has the most strands (most likely
+             * we're appending to it), and all of b if need be. */
             MVMuint16 strands_a = a->body.storage_type == MVM_STRING_STRAND
                 ? a->body.num_strands
                 : 1;
@@ -935,12 +1054,14 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
             MVMString *effective_a = a;
             MVMString *effective_b = b;
             if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
-                MVMROOT(tc, result, {
+                MVMROOT3(tc, result, effective_a, effective_b, {
                     if (strands_b <= strands_a) {
-                        effective_a = collapse_strands(tc, effective_a);
-                        strands_a   = 1;
+                        effective_a = collapse_trailing_strands(tc, effective_a);
+                        strands_a   = effective_a->body.storage_type == MVM_STRING_STRAND
+                            ? effective_a->body.num_strands
+                            : 1;
                     }
-                    else {
+                    if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
                         effective_b = collapse_strands(tc, effective_b);
                         strands_b   = 1;
                     }
@@ -1321,6 +1442,65 @@ static MVMint64 knuth_morris_pratt_string_index (MVMThreadContext *tc, MVMString
     if (next_is_malloced) MVM_free(next);
     return -1;
 }
+/* Finds where in the current strand (or repetition of it) of a grapheme
+ * iterator the next grapheme is that might start with g once casefolded,
+ * from the iterator's position on. Returns the end of the strand if there is
+ * none. */
+static MVMStringIndex gi_scan_fold_candidate(MVMThreadContext *tc, MVMGraphemeIter *gi, MVMGrapheme32 g) {
+    MVMGrapheme32 upper = 'a' <= g && g <= 'z' ? g - ('a' - 'A') : g;
+    if (gi->blob_type == MVM_STRING_GRAPHEME_32)
+        return gi->pos + MVM_string_scan_fold_candidates32(gi->active_blob.blob_32 + gi->pos,
+            gi->end - gi->pos, g, upper);
+    /* Any byte that isn't ASCII is a candidate anyway, so stands in for a g
+     * that isn't. */
+    if (g < 0 || 0x80 <= g)
+        g = upper = 0x80;
+    return gi->pos + MVM_string_scan_fold_candidates8(gi->active_blob.blob_8 + gi->pos,
+        gi->end - gi->pos, (MVMuint8)g, (MVMuint8)upper);
+}
+/* Searches for a casefolded needle in a Haystack, ignoring case. A match can
+ * only start at a grapheme whose casefolding starts with the first grapheme
+ * of the needle. Of the ASCII graphemes, which casefold to ASCII, that rules
+ * out all but one or two, so we skip over them with a vectorized scan, a
+ * strand at a time, and only try to match where we stop. */
+static MVMint64 string_index_ignore_case_scan(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle_fc, MVMint64 start, MVMStringIndex H_graphs, MVMStringIndex n_fc_graphs) {
+    MVMGrapheme32   first = MVM_string_get_grapheme_at_nocheck(tc, needle_fc, 0);
+    MVMint64        index = start;
+    MVMint64        H_expansion;
+    MVMGraphemeIter gi;
+    MVM_string_gi_init(tc, &gi, Haystack);
+    if (start)
+        MVM_string_gi_move_to(tc, &gi, start);
+    while (1) {
+        MVMStringIndex found = gi_scan_fold_candidate(tc, &gi, first);
+        index += found - gi.pos;
+        if (found < gi.end) {
+            if (Haystack->body.storage_type == MVM_STRING_STRAND) {
+                /* Start the cached iterator off where we are. */
+                MVMGraphemeIter_cached H_gic;
+                H_gic.gi            = gi;
+                H_gic.gi.pos        = found;
+                H_gic.last_location = index;
+                H_gic.last_g        = MVM_string_gi_get_grapheme(tc, &(H_gic.gi));
+                H_gic.string        = Haystack;
+                H_expansion = string_equal_at_ignore_case_INTERNAL_loop(tc, &H_gic, needle_fc, index, H_graphs, n_fc_graphs, 0, 1, 1);
+            }
+            else {
+                H_expansion = string_equal_at_ignore_case_INTERNAL_loop(tc, Haystack, needle_fc, index, H_graphs, n_fc_graphs, 0, 1, 0);
+            }
+            if (0 <= H_expansion)
+                return n_fc_graphs <= H_graphs + H_expansion - index ? index : -1;
+            gi.pos = found + 1;
+            index++;
+        }
+        else if (MVM_string_gi_has_more_strands_rep(tc, &gi)) {
+            MVM_string_gi_next_strand_rep(tc, &gi);
+        }
+        else {
+            return -1;
+        }
+    }
+}
 static MVMint64 string_index_ignore_case(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start, int ignoremark, int ignorecase) {
     /* Foldcase version of needle */
     MVMString *needle_fc = NULL;
@@ -1356,6 +1536,8 @@ static MVMint64 string_index_ignore_case(MVMThreadContext *tc, MVMString *Haysta
         needle_fc = ignorecase ? MVM_string_fc(tc, needle) : needle;
     });
     n_fc_graphs = MVM_string_graphs(tc, needle_fc);
+    if (ignorecase && !ignoremark)
+        return string_index_ignore_case_scan(tc, Haystack, needle_fc, start, H_graphs, n_fc_graphs);
     /* brute force for now. horrible, yes. halp. */
     if (is_gic) {
         Hs_or_gic = alloca(sizeof(MVMGraphemeIter_cached));
@@ -1429,6 +1611,11 @@ MVMint64 MVM_string_equal(MVMThreadContext *tc, MVMString *a, MVMString *b) {
     if (a == b)
         return 1;
 
+    /* There is only one interned string with given contents, so two different
+     * ones can't be equal. */
+    if (a->common.header.flags & b->common.header.flags & MVM_CF_INTERNED_STRING)
+        return 0;
+
     agraphs = MVM_string_graphs_nocheck(tc, a);
     bgraphs = MVM_string_graphs_nocheck(tc, b);
 
@@ -1687,6 +1874,90 @@ MVMString * MVM_string_decode(MVMThreadContext *tc,
     return MVM_string_decode_config(tc, type_object, Cbuf, byte_length, encoding_flag, NULL, MVM_ENCODING_PERMISSIVE);
 }
 
+/* Checks that a run of 8-bit graphemes can be copied as they are: always so
+ * if we're encoding to Latin-1, otherwise only if they are all ASCII. */
+static MVMint32 blob_8_can_copy(MVMGrapheme8 *blob, MVMStringIndex length, MVMint32 latin1) {
+    return latin1 || MVM_string_scan_ascii(blob, length, 0) == length;
+}
+
+/* ASCII is encoded the same in ASCII, Latin-1 and UTF-8, and Latin-1 range
+ * codepoints the same in Latin-1, so when part of a string is stored 8 bits
+ * per grapheme (flat, or in strands over such strings) encoding it to those
+ * is often just a copy. This does that, returning a NUL-terminated buffer
+ * allocated at the exact size, or NULL if the string can't be copied. Pass
+ * latin1 as non-zero if encoding to Latin-1. The start and length must be
+ * in range. */
+char * MVM_string_encode_8bit_copy(MVMThreadContext *tc, MVMString *s, MVMStringIndex start,
+        MVMStringIndex length, MVMint32 latin1, MVMint32 translate_newlines,
+        MVMuint64 *output_size) {
+    MVMuint8 *result;
+#ifdef _WIN32
+    /* Would need to turn \n into \r\n. */
+    if (translate_newlines)
+        return NULL;
+#endif
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            MVMGrapheme8 *blob = s->body.storage.blob_8 + start;
+            if (s->body.storage_type == MVM_STRING_GRAPHEME_8 && !blob_8_can_copy(blob, length, latin1))
+                return NULL;
+            result = MVM_malloc(length + 1);
+            memcpy(result, blob, length);
+            break;
+        }
+        case MVM_STRING_STRAND: {
+            MVMStringStrand *strands = s->body.storage.strands;
+            MVMuint8        *pos;
+            MVMStringIndex   skip = start, togo = length;
+            MVMuint16        i;
+
+            /* Check all strands can be copied before allocating. */
+            for (i = 0; i < s->body.num_strands; i++) {
+                MVMString *blob_string = strands[i].blob_string;
+                if (blob_string->body.storage_type == MVM_STRING_GRAPHEME_8) {
+                    if (!blob_8_can_copy(blob_string->body.storage.blob_8 + strands[i].start,
+                            strands[i].end - strands[i].start, latin1))
+                        return NULL;
+                }
+                else if (blob_string->body.storage_type != MVM_STRING_GRAPHEME_ASCII) {
+                    return NULL;
+                }
+            }
+
+            result = pos = MVM_malloc(length + 1);
+            for (i = 0; i < s->body.num_strands && togo; i++) {
+                MVMStringIndex  piece = strands[i].end - strands[i].start;
+                MVMGrapheme8   *blob  = strands[i].blob_string->body.storage.blob_8
+                    + strands[i].start;
+                MVMuint64       reps  = (MVMuint64)strands[i].repetitions + 1;
+                if (skip >= piece * reps) {
+                    skip -= piece * reps;
+                    continue;
+                }
+                reps -= skip / piece;
+                skip %= piece;
+                while (reps-- && togo) {
+                    MVMStringIndex n = piece - skip;
+                    if (n > togo)
+                        n = togo;
+                    memcpy(pos, blob + skip, n);
+                    pos  += n;
+                    togo -= n;
+                    skip  = 0;
+                }
+            }
+            break;
+        }
+        default:
+            return NULL;
+    }
+    result[length] = 0;
+    if (output_size)
+        *output_size = length;
+    return (char *)result;
+}
+
 /* Strictly encodes an MVMString to a C buffer, dependent on the encoding type flag.
  * See comments for MVM_string_decode_config() above for more details. */
 char * MVM_string_encode_config(MVMThreadContext *tc, MVMString *s, MVMint64 start,
@@ -67,12 +67,15 @@ MVM_STATIC_INLINE int MVM_string_buf32_can_fit_into_8bit(MVMGrapheme32 *active_b
     MVM_VECTORIZE_LOOP
     for (i = 0; i  < blob_len; i++) {
         /* This could be written val |= ..., but GCC 7 doesn't recognize the
-         * operation as ossociative unless we use a temp variable (clang has no issue). */
-        MVMGrapheme32 val2 = ((active_blob[i] & 0xffffff80) + 0x80) & (0xffffff80-1);
+         * operation as ossociative unless we use a temp variable (clang has no issue).
+         * Synthetics are negative, so have high bits set too. */
+        MVMGrapheme32 val2 = active_blob[i] & 0xffffff00;
         val |= val2;
     }
     return val ? 0 : 1;
 }
+char * MVM_string_encode_8bit_copy(MVMThreadContext *tc, MVMString *s, MVMStringIndex start,
+    MVMStringIndex length, MVMint32 latin1, MVMint32 translate_newlines, MVMuint64 *output_size);
 MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString *a, MVMint64 index);
 MVMint64 MVM_string_equal(MVMThreadContext *tc, MVMString *a, MVMString *b);
 MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
@@ -132,6 +135,18 @@ MVMuint8 MVM_string_find_encoding(MVMThreadContext *tc, MVMString *name);
 MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp);
 MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
 void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s);
+
+/* Strings of up to this many graphemes get their hash code computed as soon
+ * as they are decoded. */
+#define MVM_STRING_EAGER_HASH_GRAPHS 64
+
+/* Computes the hash code of a freshly made string if it is short. Its
+ * graphemes are still in cache then, which makes it cheap, and short strings
+ * (notably names decoded from bytecode) are the likeliest to be hash keys. */
+MVM_STATIC_INLINE void MVM_string_maybe_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
+    if (s->body.num_graphs <= MVM_STRING_EAGER_HASH_GRAPHS && s->body.storage_type != MVM_STRING_STRAND)
+        MVM_string_compute_hash_code(tc, s);
+}
 MVMString * MVM_string_ascii_from_buf_nocheck(MVMThreadContext *tc, MVMGrapheme8 *buf, MVMStringIndex len);
 char * MVM_string_encoding_cname(MVMThreadContext *tc, MVMint64 encoding);
 /* If MVM_DEBUG_NFG is 1, calls to NFG_CHECK will re_nfg the given string
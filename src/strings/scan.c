@@ -0,0 +1,226 @@
+#include "moar.h"
+#include "platform/simd.h"
+
+/* Scans over buffers of bytes or graphemes, many at a time. We use them to
+ * find how long the run of ASCII at the start of a buffer is (text is very
+ * often mostly or even all ASCII, which decoders can take over without
+ * running it through their state machines), and to skip to the places a
+ * substring search has to look at more closely. On x86 with GCC or Clang we
+ * have SSE2 and AVX2 kernels, picked at runtime by what the CPU supports;
+ * the plain C loops are used elsewhere and for whatever the kernels leave
+ * over at the end. */
+
+/* Portable kernel, starting at index i. */
+static size_t scan_ascii_c(const MVMuint8 *bytes, size_t i, size_t n, MVMint32 stop_at_cr) {
+    if (stop_at_cr) {
+        while (i < n && bytes[i] < 0x80 && bytes[i] != '\r')
+            i++;
+    }
+    else {
+        while (i < n && bytes[i] < 0x80)
+            i++;
+    }
+    return i;
+}
+
+#if MVM_SIMD_X86
+/* A byte is not ASCII if its top bit is set, which is just what movemask
+ * picks out. */
+MVM_SIMD_TARGET("sse2")
+static size_t scan_ascii_sse2(const MVMuint8 *bytes, size_t n, MVMint32 stop_at_cr) {
+    const __m128i cr = _mm_set1_epi8('\r');
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i      v    = _mm_loadu_si128((const __m128i *)(bytes + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(v);
+        if (stop_at_cr)
+            mask |= (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, cr));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return scan_ascii_c(bytes, i, n, stop_at_cr);
+}
+
+MVM_SIMD_TARGET("avx2")
+static size_t scan_ascii_avx2(const MVMuint8 *bytes, size_t n, MVMint32 stop_at_cr) {
+    const __m256i cr = _mm256_set1_epi8('\r');
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i      v    = _mm256_loadu_si256((const __m256i *)(bytes + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(v);
+        if (stop_at_cr)
+            mask |= (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, cr));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return scan_ascii_c(bytes, i, n, stop_at_cr);
+}
+#endif
+
+/* Returns the number of bytes at the start of the buffer that are ASCII,
+ * and so the index of the first that is not, or the length if they all are.
+ * If stop_at_cr is set, a \r also ends the run, since in NFG it may join the
+ * next char into a single grapheme. */
+size_t MVM_string_scan_ascii(const MVMuint8 *bytes, size_t length, MVMint32 stop_at_cr) {
+#if MVM_SIMD_X86
+    switch (MVM_platform_simd_level()) {
+        case MVM_SIMD_AVX2: return scan_ascii_avx2(bytes, length, stop_at_cr);
+        case MVM_SIMD_SSE2: return scan_ascii_sse2(bytes, length, stop_at_cr);
+    }
+#endif
+    return scan_ascii_c(bytes, 0, length, stop_at_cr);
+}
+
+/* Portable kernels for the grapheme scans, starting at index i. A grapheme
+ * could be a fold candidate if it is one of the two we look for, or if it is
+ * not ASCII, since then its fold may be anything. */
+static size_t scan_grapheme32_c(const MVMGrapheme32 *graphs, size_t i, size_t n, MVMGrapheme32 g) {
+    while (i < n && graphs[i] != g)
+        i++;
+    return i;
+}
+static size_t scan_fold8_c(const MVMuint8 *bytes, size_t i, size_t n, MVMuint8 lower, MVMuint8 upper) {
+    while (i < n && bytes[i] != lower && bytes[i] != upper && bytes[i] < 0x80)
+        i++;
+    return i;
+}
+static size_t scan_fold32_c(const MVMGrapheme32 *graphs, size_t i, size_t n, MVMGrapheme32 lower, MVMGrapheme32 upper) {
+    while (i < n && graphs[i] != lower && graphs[i] != upper && (MVMuint32)graphs[i] < 0x80)
+        i++;
+    return i;
+}
+
+#if MVM_SIMD_X86
+/* Comparing 32-bit lanes sets all four bytes of each lane that matches, so
+ * the index of the lane is the index of the byte in movemask divided by 4. */
+MVM_SIMD_TARGET("sse2")
+static size_t scan_grapheme32_sse2(const MVMGrapheme32 *graphs, size_t n, MVMGrapheme32 g) {
+    const __m128i want = _mm_set1_epi32(g);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i      v    = _mm_loadu_si128((const __m128i *)(graphs + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(v, want));
+        if (mask)
+            return i + __builtin_ctz(mask) / 4;
+    }
+    return scan_grapheme32_c(graphs, i, n, g);
+}
+
+MVM_SIMD_TARGET("avx2")
+static size_t scan_grapheme32_avx2(const MVMGrapheme32 *graphs, size_t n, MVMGrapheme32 g) {
+    const __m256i want = _mm256_set1_epi32(g);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i      v    = _mm256_loadu_si256((const __m256i *)(graphs + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi32(v, want));
+        if (mask)
+            return i + __builtin_ctz(mask) / 4;
+    }
+    return scan_grapheme32_c(graphs, i, n, g);
+}
+
+MVM_SIMD_TARGET("sse2")
+static size_t scan_fold8_sse2(const MVMuint8 *bytes, size_t n, MVMuint8 lower, MVMuint8 upper) {
+    const __m128i lo = _mm_set1_epi8((char)lower);
+    const __m128i up = _mm_set1_epi8((char)upper);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i      v    = _mm_loadu_si128((const __m128i *)(bytes + i));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(v,
+            _mm_or_si128(_mm_cmpeq_epi8(v, lo), _mm_cmpeq_epi8(v, up))));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return scan_fold8_c(bytes, i, n, lower, upper);
+}
+
+MVM_SIMD_TARGET("avx2")
+static size_t scan_fold8_avx2(const MVMuint8 *bytes, size_t n, MVMuint8 lower, MVMuint8 upper) {
+    const __m256i lo = _mm256_set1_epi8((char)lower);
+    const __m256i up = _mm256_set1_epi8((char)upper);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i      v    = _mm256_loadu_si256((const __m256i *)(bytes + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(v,
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, lo), _mm256_cmpeq_epi8(v, up))));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return scan_fold8_c(bytes, i, n, lower, upper);
+}
+
+/* A lane is ASCII if it is zero once its low seven bits are masked off. */
+MVM_SIMD_TARGET("sse2")
+static size_t scan_fold32_sse2(const MVMGrapheme32 *graphs, size_t n, MVMGrapheme32 lower, MVMGrapheme32 upper) {
+    const __m128i lo   = _mm_set1_epi32(lower);
+    const __m128i up   = _mm_set1_epi32(upper);
+    const __m128i high = _mm_set1_epi32(~0x7F);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i      v     = _mm_loadu_si128((const __m128i *)(graphs + i));
+        __m128i      ascii = _mm_cmpeq_epi32(_mm_and_si128(v, high), zero);
+        __m128i      hit   = _mm_or_si128(_mm_cmpeq_epi32(v, lo), _mm_cmpeq_epi32(v, up));
+        unsigned int mask  = (unsigned int)_mm_movemask_epi8(_mm_or_si128(hit,
+            _mm_andnot_si128(ascii, _mm_set1_epi32(-1))));
+        if (mask)
+            return i + __builtin_ctz(mask) / 4;
+    }
+    return scan_fold32_c(graphs, i, n, lower, upper);
+}
+
+MVM_SIMD_TARGET("avx2")
+static size_t scan_fold32_avx2(const MVMGrapheme32 *graphs, size_t n, MVMGrapheme32 lower, MVMGrapheme32 upper) {
+    const __m256i lo   = _mm256_set1_epi32(lower);
+    const __m256i up   = _mm256_set1_epi32(upper);
+    const __m256i high = _mm256_set1_epi32(~0x7F);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i      v     = _mm256_loadu_si256((const __m256i *)(graphs + i));
+        __m256i      ascii = _mm256_cmpeq_epi32(_mm256_and_si256(v, high), zero);
+        __m256i      hit   = _mm256_or_si256(_mm256_cmpeq_epi32(v, lo), _mm256_cmpeq_epi32(v, up));
+        unsigned int mask  = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(hit,
+            _mm256_andnot_si256(ascii, _mm256_set1_epi32(-1))));
+        if (mask)
+            return i + __builtin_ctz(mask) / 4;
+    }
+    return scan_fold32_c(graphs, i, n, lower, upper);
+}
+#endif
+
+/* Returns the index of the first grapheme in the buffer that is g, or the
+ * length if there is none. */
+size_t MVM_string_scan_grapheme32(const MVMGrapheme32 *graphs, size_t length, MVMGrapheme32 g) {
+#if MVM_SIMD_X86
+    switch (MVM_platform_simd_level()) {
+        case MVM_SIMD_AVX2: return scan_grapheme32_avx2(graphs, length, g);
+        case MVM_SIMD_SSE2: return scan_grapheme32_sse2(graphs, length, g);
+    }
+#endif
+    return scan_grapheme32_c(graphs, 0, length, g);
+}
+
+/* Returns the index of the first byte or grapheme in the buffer that might
+ * start with lower once casefolded, or the length if there is none. The
+ * caller passes the uppercase version of lower as upper if it is an ASCII
+ * letter, and lower again otherwise. Anything that is not ASCII counts as a
+ * candidate, so for a lower that is not ASCII only those are found. */
+size_t MVM_string_scan_fold_candidates8(const MVMuint8 *bytes, size_t length, MVMuint8 lower, MVMuint8 upper) {
+#if MVM_SIMD_X86
+    switch (MVM_platform_simd_level()) {
+        case MVM_SIMD_AVX2: return scan_fold8_avx2(bytes, length, lower, upper);
+        case MVM_SIMD_SSE2: return scan_fold8_sse2(bytes, length, lower, upper);
+    }
+#endif
+    return scan_fold8_c(bytes, 0, length, lower, upper);
+}
+size_t MVM_string_scan_fold_candidates32(const MVMGrapheme32 *graphs, size_t length, MVMGrapheme32 lower, MVMGrapheme32 upper) {
+#if MVM_SIMD_X86
+    switch (MVM_platform_simd_level()) {
+        case MVM_SIMD_AVX2: return scan_fold32_avx2(graphs, length, lower, upper);
+        case MVM_SIMD_SSE2: return scan_fold32_sse2(graphs, length, lower, upper);
+    }
+#endif
+    return scan_fold32_c(graphs, 0, length, lower, upper);
+}
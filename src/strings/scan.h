@@ -0,0 +1,6 @@
+/* Scanning of byte and grapheme buffers, used by the fast paths of decoders,
+ * encoders and substring search. */
+size_t MVM_string_scan_ascii(const MVMuint8 *bytes, size_t length, MVMint32 stop_at_cr);
+size_t MVM_string_scan_grapheme32(const MVMGrapheme32 *graphs, size_t length, MVMGrapheme32 g);
+size_t MVM_string_scan_fold_candidates8(const MVMuint8 *bytes, size_t length, MVMuint8 lower, MVMuint8 upper);
+size_t MVM_string_scan_fold_candidates32(const MVMGrapheme32 *graphs, size_t length, MVMGrapheme32 lower, MVMGrapheme32 upper);
@@ -104,6 +104,23 @@ typedef struct siphash siphash;
     HALF_ROUND(v0,v1,v2,v3,13,16); \
     HALF_ROUND(v2,v1,v0,v3,17,21);
 
+#define SINGLE_ROUND(v0,v1,v2,v3)  \
+    HALF_ROUND(v0,v1,v2,v3,13,16); \
+    HALF_ROUND(v2,v1,v0,v3,17,21);
+
+/* By default we use SipHash-2-4: two rounds per 64 bits of input and four to
+ * finish. Building with MVM_SIPHASH_1_3 defined (Configure.pl --siphash13)
+ * uses SipHash-1-3 instead, which is keyed and meant to resist hash flooding
+ * in the same way, but is quicker on long keys. The functions keep their
+ * names either way. */
+#if defined(MVM_SIPHASH_1_3)
+#define COMPRESS_ROUNDS(v0,v1,v2,v3) SINGLE_ROUND(v0,v1,v2,v3);
+#define FINALIZE_ROUNDS(v0,v1,v2,v3) SINGLE_ROUND(v0,v1,v2,v3); DOUBLE_ROUND(v0,v1,v2,v3);
+#else
+#define COMPRESS_ROUNDS(v0,v1,v2,v3) DOUBLE_ROUND(v0,v1,v2,v3);
+#define FINALIZE_ROUNDS(v0,v1,v2,v3) DOUBLE_ROUND(v0,v1,v2,v3); DOUBLE_ROUND(v0,v1,v2,v3);
+#endif
+
 MVM_STATIC_INLINE void siphashinit (siphash *sh, size_t src_sz, const uint64_t key[2]) {
     const uint64_t k0 = MVM_MAYBE_TO_LITTLE_ENDIAN_64(key[0]);
     const uint64_t k1 = MVM_MAYBE_TO_LITTLE_ENDIAN_64(key[1]);
@@ -116,17 +133,16 @@ MVM_STATIC_INLINE void siphashinit (siphash *sh, size_t src_sz, const uint64_t k
 MVM_STATIC_INLINE void siphashadd64bits (siphash *sh, const uint64_t in) {
     const uint64_t mi = MVM_MAYBE_TO_LITTLE_ENDIAN_64(in);
     sh->v3 ^= mi;
-    DOUBLE_ROUND(sh->v0,sh->v1,sh->v2,sh->v3);
+    COMPRESS_ROUNDS(sh->v0,sh->v1,sh->v2,sh->v3);
     sh->v0 ^= mi;
 }
 MVM_STATIC_INLINE uint64_t siphashfinish_last_part (siphash *sh, uint64_t t) {
     sh->b |= MVM_MAYBE_TO_LITTLE_ENDIAN_64(t);
     sh->v3 ^= sh->b;
-    DOUBLE_ROUND(sh->v0,sh->v1,sh->v2,sh->v3);
+    COMPRESS_ROUNDS(sh->v0,sh->v1,sh->v2,sh->v3);
     sh->v0 ^= sh->b;
     sh->v2 ^= 0xff;
-    DOUBLE_ROUND(sh->v0,sh->v1,sh->v2,sh->v3);
-    DOUBLE_ROUND(sh->v0,sh->v1,sh->v2,sh->v3);
+    FINALIZE_ROUNDS(sh->v0,sh->v1,sh->v2,sh->v3);
     return (sh->v0 ^ sh->v1) ^ (sh->v2 ^ sh->v3);
 }
 /* This union helps us avoid doing weird things with pointers that can cause old
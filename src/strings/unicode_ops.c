@@ -679,6 +679,96 @@ MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMStrin
     return collation_return_by_quaternary(tc, &level_eval_settings, alen, blen, compare_by_cp_rtrn);
 }
 
+/* Bytes used for each collation value in a sort key, by level. Primary
+ * values go up to 0x10000 once the implicit weights have 1 added; DUCET
+ * secondary values fit in 9 bits and tertiary ones in 5. Quaternary values
+ * are codepoints plus 1. */
+static const MVMint32 sort_key_widths[4] = { 3, 2, 1, 3 };
+struct sort_key_buf {
+    MVMuint8 *bytes;
+    MVMint64  pos;
+    MVMint64  alloc;
+};
+typedef struct sort_key_buf sort_key_buf;
+static void sort_key_push(sort_key_buf *buf, MVMuint32 value, MVMint32 level, MVMint32 reversed) {
+    MVMint32 width = sort_key_widths[level];
+    MVMint32 i;
+    if (reversed)
+        value = ~value;
+    if (buf->alloc < buf->pos + width) {
+        buf->alloc = buf->alloc * 2 + width;
+        buf->bytes = MVM_realloc(buf->bytes, buf->alloc);
+    }
+    for (i = width - 1; 0 <= i; i--)
+        buf->bytes[buf->pos++] = (MVMuint8)(value >> (8 * i));
+}
+/* Computes a sort key for a string under the given collation_mode (see the
+ * table at the top of this file). Comparing the keys of two strings byte by
+ * byte, as memcmp does, orders them as MVM_unicode_string_compare does the
+ * strings themselves, so when sorting many strings each key can be worked
+ * out once and cached rather than collating the strings again on every
+ * comparison. Like that, each enabled level contributes the non-ignorable
+ * values of that level followed by a level separator, with the bytes
+ * inverted if the level is reversed, and the quaternary level breaks ties by
+ * codepoint. The key is written into buf, which must be an empty native
+ * uint8 array, and returned. (It can't be an 8-bit string: its bytes are
+ * arbitrary, and a \r followed by a \n would have to be a single grapheme.) */
+MVMObject * MVM_unicode_string_sort_key(MVMThreadContext *tc, MVMString *s,
+         MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode, MVMObject *result) {
+    MVMCodepointIter ci;
+    collation_stack  stack;
+    sort_key_buf     buf;
+    MVMint32         level;
+
+    MVM_string_check_arg(tc, s, "sort key");
+    if (!IS_CONCRETE(result) || REPR(result)->ID != MVM_REPR_ID_VMArray
+            || ((MVMArrayREPRData *)STABLE(result)->REPR_data)->slot_type != MVM_ARRAY_U8)
+        MVM_exception_throw_adhoc(tc, "sort key requires a native uint8 array to write into");
+    MVM_VMArray_unshare(tc, result);
+    if (((MVMArray *)result)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "sort key requires an empty array");
+    init_stack(tc, &stack);
+    buf.alloc = 3 * MVM_string_graphs_nocheck(tc, s) + 16;
+    buf.bytes = MVM_malloc(buf.alloc);
+    buf.pos   = 0;
+
+    /* Push the collation elements of the whole string. */
+    MVM_string_ci_init(tc, &ci, s, 0, 0);
+    while (grab_from_stack(tc, &ci, &stack, "s"))
+        ;
+
+    for (level = 0; level < 4; level++) {
+        MVMint64 positive = collation_mode & (MVMint64)1 << (2 * level);
+        MVMint64 negative = collation_mode & (MVMint64)2 << (2 * level);
+        MVMint32 reversed = negative != 0;
+        MVMint64 i;
+        /* A level asked for both ways round compares as equal, same as one
+         * not asked for at all. */
+        if (!positive == !negative)
+            continue;
+        if (level < 3) {
+            for (i = 0; i <= stack.stack_top; i++)
+                if (stack.keys[i].a[level] != collation_zero)
+                    sort_key_push(&buf, stack.keys[i].a[level], level, reversed);
+        }
+        else {
+            MVM_string_ci_init(tc, &ci, s, 0, 0);
+            while (MVM_string_ci_has_more(tc, &ci))
+                sort_key_push(&buf, MVM_string_ci_get_codepoint(tc, &ci) + 1, level, reversed);
+        }
+        /* The level separator; it sorts the shorter string first. */
+        sort_key_push(&buf, 0, level, reversed);
+    }
+    cleanup_stack(tc, &stack);
+
+    /* Stash the key in the VMArray. */
+    ((MVMArray *)result)->body.slots.u8 = buf.bytes;
+    ((MVMArray *)result)->body.start    = 0;
+    ((MVMArray *)result)->body.ssize    = buf.pos;
+    ((MVMArray *)result)->body.elems    = buf.pos;
+    return result;
+}
+
 /* Looks up a codepoint by name. Lazily constructs a hash. */
 MVMGrapheme32 MVM_unicode_lookup_by_name(MVMThreadContext *tc, MVMString *name) {
     MVMuint64 size;
@@ -177,21 +177,55 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     MVMint32 line_ending = 0;
     MVMint32 state = 0;
     MVMint32 bufsize = bytes;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMGrapheme32 *buffer;
     size_t orig_bytes;
     const char *orig_utf8;
     MVMint32 line;
     MVMint32 col;
     MVMint32 ready;
+    MVMNormalizer norm;
+
+    /* ASCII is valid UTF-8 that decodes to itself, and is already in NFG
+     * unless it contains a \r (which may join with a \n), so if that's all
+     * we have, it can just be copied. */
+    if (MVM_string_scan_ascii((const MVMuint8 *)utf8, bytes, 1) == bytes) {
+        MVMGraphemeASCII *blob = MVM_malloc(bytes);
+        memcpy(blob, utf8, bytes);
+        result->body.storage.blob_ascii = blob;
+        result->body.storage_type       = MVM_STRING_GRAPHEME_ASCII;
+        result->body.num_graphs         = bytes;
+        MVM_string_maybe_compute_hash_code(tc, result);
+        return result;
+    }
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
 
     /* Need to normalize to NFG as we decode. */
-    MVMNormalizer norm;
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
     orig_bytes = bytes;
     orig_utf8 = utf8;
 
     for (; bytes; ++utf8, --bytes) {
+        /* Between codepoints, and with nothing pending in the normalizer, a
+         * run of ASCII can be copied over a run at a time. All but its last
+         * char, that is, since the char after the run may combine with it. */
+        if (state == UTF8_ACCEPT && (MVMuint8)*utf8 < 0x80 && bytes > 1
+                && MVM_unicode_normalizer_empty(tc, &norm) && !norm.prepend_buffer) {
+            size_t run = MVM_string_scan_ascii((const MVMuint8 *)utf8, bytes, 1);
+            if (run > 1) {
+                size_t i;
+                run--;
+                while (count + run > bufsize) {
+                    buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
+                        bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
+                    ));
+                }
+                for (i = 0; i < run; i++)
+                    buffer[count++] = (MVMuint8)utf8[i];
+                utf8  += run;
+                bytes -= run;
+            }
+        }
         switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8), UTF8_ACCEPT)) {
         case UTF8_ACCEPT: { /* got a codepoint */
             MVMGrapheme32 g;
@@ -285,6 +319,7 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
         result->body.storage_type    = MVM_STRING_GRAPHEME_32;
     }
     result->body.num_graphs      = count;
+    MVM_string_maybe_compute_hash_code(tc, result);
 
     return result;
 }
@@ -391,6 +426,34 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                /* Between codepoints, a run of ASCII (save for \r) needs no
+                 * decoding and never needs the normalizer, so we can go
+                 * through it without the state machine. */
+                if (state == UTF8_ACCEPT && (MVMuint8)bytes[pos] < 0x80) {
+                    size_t run = MVM_string_scan_ascii((MVMuint8 *)bytes + pos,
+                        cur_bytes->length - pos, 1);
+                    while (run--) {
+                        if (count == bufsize) {
+                            MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                            buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                            count = 0;
+                        }
+                        buffer[count++] = lag_codepoint;
+                        total++;
+                        if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                (stopper_chars && *stopper_chars == total)) {
+                            reached_stopper = 1;
+                            last_accept_bytes = lag_last_accept_bytes;
+                            last_accept_pos = lag_last_accept_pos;
+                            goto done;
+                        }
+                        lag_codepoint = (MVMuint8)bytes[pos++];
+                        lag_last_accept_bytes = cur_bytes;
+                        lag_last_accept_pos = pos;
+                    }
+                    if (pos == cur_bytes->length)
+                        break;
+                }
                 switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, bytes[pos++]), UTF8_ACCEPT)) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -528,6 +591,11 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
+    /* ASCII in 8-bit storage needs no encoding. */
+    if ((result = (MVMuint8 *)MVM_string_encode_8bit_copy(tc, str, start, length,
+            0, translate_newlines, output_size)))
+        return (char *)result;
+
     if (replacement)
         repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
             replacement, &repl_length, 0, -1, NULL, translate_newlines);
@@ -6,6 +6,7 @@ typedef struct MVMArgProcContext MVMArgProcContext;
 typedef struct MVMArray MVMArray;
 typedef struct MVMArrayBody MVMArrayBody;
 typedef struct MVMArrayREPRData MVMArrayREPRData;
+typedef struct MVMArrayShared MVMArrayShared;
 typedef struct MVMAsyncTask MVMAsyncTask;
 typedef struct MVMAsyncTaskBody MVMAsyncTaskBody;
 typedef struct MVMAsyncTaskOps MVMAsyncTaskOps;
@@ -62,8 +63,14 @@ typedef struct MVMHashAttrStore MVMHashAttrStore;
 typedef struct MVMHashAttrStoreBody MVMHashAttrStoreBody;
 typedef struct MVMHashBody MVMHashBody;
 typedef struct MVMHashEntry MVMHashEntry;
+typedef struct MVMHashIndexSlot MVMHashIndexSlot;
+typedef struct MVMHashKV MVMHashKV;
 typedef struct MVMHLLConfig MVMHLLConfig;
 typedef struct MVMIntConstCache MVMIntConstCache;
+typedef struct MVMIntHash MVMIntHash;
+typedef struct MVMIntHashBody MVMIntHashBody;
+typedef struct MVMIntHashREPRData MVMIntHashREPRData;
+typedef struct MVMIntHashSlot MVMIntHashSlot;
 typedef struct MVMInstance MVMInstance;
 typedef struct MVMInvocationSpec MVMInvocationSpec;
 typedef struct MVMIter MVMIter;
@@ -110,7 +117,10 @@ typedef struct MVMCUnionNameMap MVMCUnionNameMap;
 typedef struct MVMCUnionREPRData MVMCUnionREPRData;
 typedef struct MVMMultiCache MVMMultiCache;
 typedef struct MVMMultiCacheBody MVMMultiCacheBody;
+typedef struct MVMMultiCacheMegaEntry MVMMultiCacheMegaEntry;
+typedef struct MVMMultiCacheMegaTable MVMMultiCacheMegaTable;
 typedef struct MVMMultiCacheNode MVMMultiCacheNode;
+typedef struct MVMMultiCacheTrees MVMMultiCacheTrees;
 typedef struct MVMMultiDimArray MVMMultiDimArray;
 typedef struct MVMMultiDimArrayBody MVMMultiDimArrayBody;
 typedef struct MVMMultiDimArrayREPRData MVMMultiDimArrayREPRData;
@@ -125,6 +135,10 @@ typedef struct MVMSemaphoreBody MVMSemaphoreBody;
 typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
 typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
+typedef struct MVMConcHash MVMConcHash;
+typedef struct MVMConcHashBody MVMConcHashBody;
+typedef struct MVMConcHashSlot MVMConcHashSlot;
+typedef struct MVMConcHashTable MVMConcHashTable;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -219,15 +233,23 @@ typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
 typedef struct MVMStringConsts MVMStringConsts;
 typedef struct MVMStringStrand MVMStringStrand;
+typedef struct MVMStringMatcher MVMStringMatcher;
+typedef struct MVMStringMatcherAutomaton MVMStringMatcherAutomaton;
+typedef struct MVMStringMatcherBody MVMStringMatcherBody;
+typedef struct MVMStringMatcherEdge MVMStringMatcherEdge;
+typedef struct MVMStringMatcherState MVMStringMatcherState;
 typedef struct MVMGraphemeIter MVMGraphemeIter;
 typedef struct MVMCodepointIter MVMCodepointIter;
 typedef struct MVMThread MVMThread;
 typedef struct MVMThreadBody MVMThreadBody;
 typedef struct MVMThreadContext MVMThreadContext;
+typedef struct MVMTypeCheckCache MVMTypeCheckCache;
 typedef struct MVMUnicodeNamedValue MVMUnicodeNamedValue;
 typedef struct MVMUnicodeNameRegistry MVMUnicodeNameRegistry;
 typedef struct MVMUnicodeGraphemeNameRegistry MVMUnicodeGraphemeNameRegistry;
 typedef struct MVMUninstantiable MVMUninstantiable;
+typedef struct MVMValidationCache MVMValidationCache;
+typedef struct MVMSpeshHotHints MVMSpeshHotHints;
 typedef struct MVMWorkThread MVMWorkThread;
 typedef struct MVMIOOps MVMIOOps;
 typedef struct MVMIOClosable MVMIOClosable;
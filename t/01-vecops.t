@@ -0,0 +1,116 @@
+# Tests for the bulk ops on native int and num arrays. Lengths up to 39
+# cover the SSE2 and AVX2 kernels as well as the plain C loop that handles
+# the elements they leave over at the end of an array.
+
+plan(40 * 20 + 3);
+
+my int $n := 0;
+while $n < 40 {
+    # Inputs, which are small integers so that the num results are exact
+    # whatever order the kernels add things up in.
+    my @a  := nqp::list_i();
+    my @b  := nqp::list_i();
+    my @c  := nqp::list_i();
+    my @an := nqp::list_n();
+    my @bn := nqp::list_n();
+    my @cn := nqp::list_n();
+
+    # Expected results.
+    my @add := nqp::list_i();
+    my @mul := nqp::list_i();
+    my @fma := nqp::list_i();
+    my @eq  := nqp::list_i();
+    my @lt  := nqp::list_i();
+    my @le  := nqp::list_i();
+    my @addn := nqp::list_n();
+    my @muln := nqp::list_n();
+    my @fman := nqp::list_n();
+    my int $sum := 0;
+    my int $dot := 0;
+    my int $min := 0;
+    my int $max := 0;
+
+    my int $i := 0;
+    while $i < $n {
+        my int $a := $i * 3 - 7;
+        my int $b := $i % 3 == 0 ?? $a !! 11 - $i * 2;
+        my int $c := $i % 5;
+        nqp::push_i(@a, $a);
+        nqp::push_i(@b, $b);
+        nqp::push_i(@c, $c);
+        nqp::push_n(@an, nqp::coerce_in($a));
+        nqp::push_n(@bn, nqp::coerce_in($b));
+        nqp::push_n(@cn, nqp::coerce_in($c));
+        nqp::push_i(@add, $a + $b);
+        nqp::push_i(@mul, $a * $b);
+        nqp::push_i(@fma, $a * $b + $c);
+        nqp::push_i(@eq, $a == $b ?? 1 !! 0);
+        nqp::push_i(@lt, $a < $b ?? 1 !! 0);
+        nqp::push_i(@le, $a <= $b ?? 1 !! 0);
+        nqp::push_n(@addn, nqp::coerce_in($a + $b));
+        nqp::push_n(@muln, nqp::coerce_in($a * $b));
+        nqp::push_n(@fman, nqp::coerce_in($a * $b + $c));
+        $sum := $sum + $a;
+        $dot := $dot + $a * $b;
+        $min := $a if $i == 0 || $a < $min;
+        $max := $a if $i == 0 || $a > $max;
+        $i++;
+    }
+
+    my @d := nqp::list_i();
+    nqp::vecadd(@d, @a, @b);
+    ok(same_i(@d, @add), "vecadd on int arrays of length $n");
+    nqp::vecmul(@d, @a, @b);
+    ok(same_i(@d, @mul), "vecmul on int arrays of length $n");
+    nqp::vecfma(@d, @a, @b, @c);
+    ok(same_i(@d, @fma), "vecfma on int arrays of length $n");
+    nqp::veceq(@d, @a, @b);
+    ok(same_i(@d, @eq), "veceq on int arrays of length $n");
+    nqp::veclt(@d, @a, @b);
+    ok(same_i(@d, @lt), "veclt on int arrays of length $n");
+    nqp::vecle(@d, @a, @b);
+    ok(same_i(@d, @le), "vecle on int arrays of length $n");
+    ok(nqp::vecsum_i(@a) == $sum, "vecsum_i of length $n");
+    ok(nqp::vecdot_i(@a, @b) == $dot, "vecdot_i of length $n");
+    if $n {
+        ok(nqp::vecmin_i(@a) == $min, "vecmin_i of length $n");
+        ok(nqp::vecmax_i(@a) == $max, "vecmax_i of length $n");
+    }
+    else {
+        ok(throws({ nqp::vecmin_i(@a) }), 'vecmin_i of an empty array throws');
+        ok(throws({ nqp::vecmax_i(@a) }), 'vecmax_i of an empty array throws');
+    }
+
+    my @dn := nqp::list_n();
+    nqp::vecadd(@dn, @an, @bn);
+    ok(same_n(@dn, @addn), "vecadd on num arrays of length $n");
+    nqp::vecmul(@dn, @an, @bn);
+    ok(same_n(@dn, @muln), "vecmul on num arrays of length $n");
+    nqp::vecfma(@dn, @an, @bn, @cn);
+    ok(same_n(@dn, @fman), "vecfma on num arrays of length $n");
+    nqp::veceq(@d, @an, @bn);
+    ok(same_i(@d, @eq), "veceq on num arrays of length $n");
+    nqp::veclt(@d, @an, @bn);
+    ok(same_i(@d, @lt), "veclt on num arrays of length $n");
+    nqp::vecle(@d, @an, @bn);
+    ok(same_i(@d, @le), "vecle on num arrays of length $n");
+    ok(nqp::vecsum_n(@an) == nqp::coerce_in($sum), "vecsum_n of length $n");
+    ok(nqp::vecdot_n(@an, @bn) == nqp::coerce_in($dot), "vecdot_n of length $n");
+    if $n {
+        ok(nqp::vecmin_n(@an) == nqp::coerce_in($min), "vecmin_n of length $n");
+        ok(nqp::vecmax_n(@an) == nqp::coerce_in($max), "vecmax_n of length $n");
+    }
+    else {
+        ok(throws({ nqp::vecmin_n(@an) }), 'vecmin_n of an empty array throws');
+        ok(throws({ nqp::vecmax_n(@an) }), 'vecmax_n of an empty array throws');
+    }
+
+    $n++;
+}
+
+ok(throws({ nqp::vecadd(nqp::list_i(), nqp::list_i(1, 2), nqp::list_i(1)) }),
+    'arrays of different lengths are refused');
+ok(throws({ nqp::vecadd(nqp::list_i(), nqp::list_i(1), nqp::list_n(1.0)) }),
+    'arrays of different types are refused');
+ok(throws({ nqp::vecadd(nqp::list_n(), nqp::list_i(1), nqp::list_i(1)) }),
+    'a destination of the wrong type is refused');
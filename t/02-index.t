@@ -0,0 +1,68 @@
+# Tests for index and indexic on strand strings, whose matches may start
+# in one strand (or repetition) and end in another, compared against a
+# search done a substr at a time. The haystacks mix 8-bit and 32-bit
+# graphemes and are long enough for the vectorized first grapheme scans.
+
+my @haystacks := [
+    nqp::concat(nqp::concat('abcab', 'cabd'), nqp::concat('xaaa', 'aab')),
+    nqp::concat(nqp::x('ab', 20), 'abc'),
+    nqp::concat(nqp::concat("a\x[20AC]b", "\x[20AC]\x[20AC]a"), nqp::x("b\x[20AC]", 9)),
+    nqp::concat(nqp::concat(nqp::x('a', 70), 'b'), nqp::concat('aaa', nqp::x('a', 33))),
+    nqp::concat(nqp::concat('Hello WOR', 'LD hel'), nqp::concat("lo \x[C9]t\x[C9] ", "\x[E9]t\x[E9]!")),
+];
+
+my @needles := [
+    '', 'a', 'ab', 'abc', 'bca', 'aaab', "\x[20AC]a", "b\x[20AC]", "\x[E9]T\x[E9]",
+    'lo wOrLd', nqp::x('a', 72), 'zz',
+];
+
+plan(nqp::elems(@haystacks) * nqp::elems(@needles) * 2 + 6);
+
+sub ref_index($h, $n, int $start, int $ic) {
+    my int $hl := nqp::chars($h);
+    my int $nl := nqp::chars($n);
+    my int $i  := $start;
+    while $i + $nl <= $hl {
+        my str $s := nqp::substr($h, $i, $nl);
+        return $i if $ic ?? nqp::fc($s) eq nqp::fc($n) !! $s eq $n;
+        $i++;
+    }
+    -1
+}
+
+# Checks the search from every start position, and one past the end.
+sub same_everywhere($h, $n, int $ic) {
+    my int $start := 0;
+    while $start <= nqp::chars($h) + 1 {
+        my int $got := $ic ?? nqp::indexic($h, $n, $start) !! nqp::index($h, $n, $start);
+        my int $exp := ref_index($h, $n, $start, $ic);
+        unless $got == $exp {
+            say("# searching from $start: got $got, expected $exp");
+            return 0;
+        }
+        $start++;
+    }
+    1
+}
+
+my int $hi := 0;
+for @haystacks -> $h {
+    for @needles -> $n {
+        ok(same_everywhere($h, $n, 0), "index of '$n' in haystack $hi");
+        ok(same_everywhere($h, $n, 1), "indexic of '$n' in haystack $hi");
+    }
+    $hi++;
+}
+
+ok(nqp::index(nqp::concat('xxab', 'cdxx'), 'abcd', 0) == 2,
+    'a match spanning two strands is found');
+ok(nqp::index(nqp::concat(nqp::x('ab', 5), 'c'), 'abc', 0) == 8,
+    'a match spanning a repetition and a strand is found');
+ok(nqp::index(nqp::concat(nqp::x('ab', 5), 'c'), 'abc', 9) == -1,
+    'no match is found after the last one');
+ok(nqp::indexic(nqp::concat('xx', "\x[212A]ELVIN"), 'kelvin', 0) == 2,
+    'indexic finds a match starting with a non-ASCII grapheme that folds to ASCII');
+ok(nqp::indexic(nqp::concat('mis', "\x[17F]i\x[17F]sippi"), 'SiSS', 0) == 3,
+    'indexic finds a match starting with a long s');
+ok(nqp::indexic(nqp::concat('abc', 'ABC'), 'Bca', 0) == 1,
+    'indexic finds a match spanning two strands');
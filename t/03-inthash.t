@@ -0,0 +1,118 @@
+# Tests for VMIntHash: deleted slots must not hide keys that probed past
+# them, must be reused or dropped as the table is rebuilt, and must not
+# disturb iteration.
+
+plan(16);
+
+my $IntHash := repr_type('VMIntHash');
+my $IntHashI := nqp::newtype(nqp::knowhow(), 'VMIntHash');
+nqp::composetype($IntHashI, nqp::hash('hash', nqp::hash('type', int)));
+
+# Iterates a hash, returning the number of keys seen and the sum of the
+# keys. Dies if a key is seen twice.
+sub iterate($h) {
+    my %seen;
+    my int $count := 0;
+    my int $sum   := 0;
+    my $it := nqp::iter($h);
+    while $it {
+        nqp::shift($it);
+        my int $key := nqp::iterkey_i($it);
+        nqp::die("key $key seen twice") if nqp::existskey(%seen, ~$key);
+        %seen{~$key} := 1;
+        $count++;
+        $sum := $sum + $key;
+    }
+    nqp::list_i($count, $sum)
+}
+
+my $h := nqp::create($IntHash);
+my int $i := 0;
+while $i < 1000 {
+    nqp::bindikey_o($h, $i * 7919 - 3000000, nqp::box_i($i, Int));
+    $i++;
+}
+ok(nqp::elems($h) == 1000, 'all keys bound');
+
+$i := 0;
+while $i < 1000 {
+    nqp::deleteikey($h, $i * 7919 - 3000000) if $i % 2;
+    $i++;
+}
+ok(nqp::elems($h) == 500, 'deleting every other key halves elems');
+
+my int $found := 0;
+my int $gone  := 0;
+$i := 0;
+while $i < 1000 {
+    my int $key := $i * 7919 - 3000000;
+    if $i % 2 {
+        $gone++ unless nqp::existsikey($h, $key);
+    }
+    else {
+        $found++ if nqp::existsikey($h, $key)
+            && nqp::unbox_i(nqp::atikey_o($h, $key)) == $i;
+    }
+    $i++;
+}
+ok($found == 500, 'keys that probed past deleted slots are still found');
+ok($gone == 500, 'deleted keys are gone');
+ok(nqp::isnull(nqp::atikey_o($h, 7919 - 3000000)), 'looking up a deleted key gives null');
+
+my @seen := iterate($h);
+ok(nqp::atpos_i(@seen, 0) == 500, 'iteration skips deleted slots');
+my int $sum := 0;
+$i := 0;
+while $i < 1000 {
+    $sum := $sum + $i * 7919 - 3000000 unless $i % 2;
+    $i++;
+}
+ok(nqp::atpos_i(@seen, 1) == $sum, 'iteration sees each remaining key once');
+
+# Deleting the current key while iterating leaves the rest of the
+# iteration undisturbed.
+my int $visited := 0;
+my $it := nqp::iter($h);
+while $it {
+    nqp::shift($it);
+    nqp::deleteikey($h, nqp::iterkey_i($it));
+    $visited++;
+}
+ok($visited == 500, 'deleting while iterating visits every key');
+ok(nqp::elems($h) == 0, 'and deletes them all');
+
+# Churn through many more keys than the table holds at once, so that it is
+# rebuilt with the deleted slots dropped many times over.
+my $churn := nqp::create($IntHashI);
+$i := 0;
+while $i < 20000 {
+    nqp::bindikey_i($churn, $i, $i * 2);
+    nqp::deleteikey($churn, $i - 8) if $i >= 8;
+    $i++;
+}
+ok(nqp::elems($churn) == 8, 'churning keeps only the live keys');
+my int $ok := 1;
+$i := 19992;
+while $i < 20000 {
+    $ok := 0 unless nqp::existsikey($churn, $i) && nqp::atikey_i($churn, $i) == $i * 2;
+    $i++;
+}
+ok($ok, 'the live keys survive the rebuilds');
+ok(!nqp::existsikey($churn, 19991), 'a key deleted before the rebuilds stays gone');
+@seen := iterate($churn);
+ok(nqp::atpos_i(@seen, 0) == 8 && nqp::atpos_i(@seen, 1) == 8 * 19992 + 28,
+    'iteration after rebuilds sees only the live keys');
+
+# A deleted key can be bound again.
+nqp::bindikey_i($churn, 5, 55);
+ok(nqp::existsikey($churn, 5) && nqp::atikey_i($churn, 5) == 55, 'a deleted key can be rebound');
+ok(nqp::elems($churn) == 9, 'rebinding a deleted key counts it again');
+
+# Keys at the ends of the int64 range.
+my $ends := nqp::create($IntHash);
+nqp::bindikey_o($ends, -9223372036854775807 - 1, nqp::box_s('min', Str));
+nqp::bindikey_o($ends, 9223372036854775807, nqp::box_s('max', Str));
+nqp::bindikey_o($ends, 0, nqp::box_s('zero', Str));
+ok(nqp::unbox_s(nqp::atikey_o($ends, -9223372036854775807 - 1)) eq 'min'
+    && nqp::unbox_s(nqp::atikey_o($ends, 9223372036854775807)) eq 'max'
+    && nqp::unbox_s(nqp::atikey_o($ends, 0)) eq 'zero', 'keys at the ends of the range');
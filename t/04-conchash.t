@@ -0,0 +1,115 @@
+# Tests for ConcHash used from several threads at once: inserts and deletes
+# that make the table be copied while other threads read it must neither
+# lose nor resurrect keys.
+
+plan(8);
+
+my $ConcHash := repr_type('ConcHash');
+
+my int $threads := 8;
+my int $per     := 3000;
+
+# Each thread inserts keys of its own, deleting every third one again as
+# it goes, while checking that the keys it inserted so far are visible.
+my $h := nqp::create($ConcHash);
+my @missing := nqp::list_i();
+my int $t := 0;
+while $t < $threads {
+    nqp::push_i(@missing, 0);
+    $t++;
+}
+run_threads($threads, -> int $id {
+    my int $k := 0;
+    while $k < $per {
+        nqp::bindkey($h, "t{$id}k{$k}", nqp::box_i($k, Int));
+        nqp::deletekey($h, "t{$id}k{$k - 1}") if $k % 3 == 1;
+        nqp::bindpos_i(@missing, $id, nqp::atpos_i(@missing, $id) + 1)
+            unless nqp::existskey($h, "t{$id}k{$k}")
+                && nqp::unbox_i(nqp::atkey($h, "t{$id}k{$k}")) == $k;
+        $k++;
+    }
+});
+
+my int $missed := 0;
+$missed := $missed + $_ for @missing;
+ok($missed == 0, 'each thread always sees the keys it just inserted');
+
+my int $expected := $threads * ($per - nqp::div_i($per + 2, 3));
+ok(nqp::elems($h) == $expected, 'elems counts concurrent inserts and deletes');
+
+my int $lost := 0;
+my int $back := 0;
+$t := 0;
+while $t < $threads {
+    my int $k := 0;
+    while $k < $per {
+        if $k % 3 == 0 && $k + 1 < $per {
+            $back++ if nqp::existskey($h, "t{$t}k{$k}");
+        }
+        else {
+            $lost++ unless nqp::existskey($h, "t{$t}k{$k}")
+                && nqp::unbox_i(nqp::atkey($h, "t{$t}k{$k}")) == $k;
+        }
+        $k++;
+    }
+    $t++;
+}
+ok($lost == 0, 'no inserted key is lost when the table is copied');
+ok($back == 0, 'no deleted key comes back when the table is copied');
+
+my int $iterated := 0;
+for $h {
+    $iterated++;
+}
+ok($iterated == $expected, 'iteration sees every live key');
+
+# All threads bind and delete the same keys; whichever got there last
+# wins, and the count must agree with what is actually there.
+my $shared := nqp::create($ConcHash);
+run_threads($threads, -> int $id {
+    my int $k := 0;
+    while $k < $per {
+        my str $key := 'k' ~ $k % 100;
+        if ($k + $id) % 2 {
+            nqp::deletekey($shared, $key);
+        }
+        else {
+            nqp::bindkey($shared, $key, nqp::box_i($id, Int));
+        }
+        $k++;
+    }
+});
+my int $present := 0;
+my int $bad     := 0;
+my int $k := 0;
+while $k < 100 {
+    if nqp::existskey($shared, "k$k") {
+        $present++;
+        my int $v := nqp::unbox_i(nqp::atkey($shared, "k$k"));
+        $bad++ unless $v >= 0 && $v < $threads;
+    }
+    $k++;
+}
+ok(nqp::elems($shared) == $present, 'elems agrees with the keys present after contended updates');
+ok($bad == 0, 'every value present was bound by one of the threads');
+
+# Readers run while a writer keeps the table growing.
+my $grow := nqp::create($ConcHash);
+nqp::bindkey($grow, 'anchor', nqp::box_i(42, Int));
+my @wrong := nqp::list_i(0);
+my $writer := nqp::newthread({
+    my int $k := 0;
+    while $k < 20000 {
+        nqp::bindkey($grow, "g$k", nqp::box_i($k, Int));
+        $k++;
+    }
+}, 0);
+nqp::threadrun($writer);
+my int $reads := 0;
+while $reads < 50000 {
+    nqp::bindpos_i(@wrong, 0, nqp::atpos_i(@wrong, 0) + 1)
+        unless nqp::unbox_i(nqp::atkey($grow, 'anchor')) == 42;
+    $reads++;
+}
+nqp::threadjoin($writer);
+ok(nqp::atpos_i(@wrong, 0) == 0, 'lock-free reads see an existing key while the table grows');
@@ -0,0 +1,33 @@
+# Tests that strings hashed while being decoded hash the same as equal
+# strings hashed later, whichever way they were made. Lengths run past the
+# 64 graphemes up to which the decoders hash eagerly.
+
+plan(71 * 4);
+
+my str $pattern := "ab\x[E9]c\x[F6]de";
+my int $len := 0;
+while $len <= 70 {
+    # Built a grapheme at a time, so a strand string hashed lazily.
+    my str $built := '';
+    my int $i := 0;
+    while $i < $len {
+        $built := nqp::concat($built, nqp::substr($pattern, $i % nqp::chars($pattern), 1));
+        $i++;
+    }
+    my str $utf8   := nqp::decode(encode($built, 'utf8'), 'utf8');
+    my str $latin1 := nqp::decode(encode($built, 'iso-8859-1'), 'iso-8859-1');
+
+    my %h;
+    %h{$built} := 'built';
+    ok(nqp::existskey(%h, $utf8), "a key of length $len decoded from UTF-8 finds a built one");
+    ok(nqp::existskey(%h, $latin1), "a key of length $len decoded from Latin-1 finds a built one");
+
+    my %d;
+    %d{$utf8} := 'utf8';
+    ok(nqp::existskey(%d, $built), "a built key of length $len finds one decoded from UTF-8");
+    %d{$latin1} := 'latin1';
+    ok(nqp::elems(%d) == 1 && %d{$built} eq 'latin1',
+        "keys of length $len decoded from UTF-8 and Latin-1 are the same key");
+
+    $len++;
+}
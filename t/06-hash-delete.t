@@ -0,0 +1,62 @@
+# Tests for deleting from a VMHash, which backward-shifts the keys after the
+# deleted one in its index, including while the hash is being iterated.
+
+plan(8);
+
+my int $n := 2000;
+my %h;
+my int $i := 0;
+while $i < $n {
+    %h{"k$i"} := $i;
+    $i++;
+}
+
+# Delete every third key, checking after each delete that the keys still
+# there can all be found, however the index got shifted around them.
+my int $lost := 0;
+$i := 0;
+while $i < $n {
+    nqp::deletekey(%h, "k$i");
+    my int $j := $i + 1;
+    while $j < $i + 40 && $j < $n {
+        $lost++ unless nqp::existskey(%h, "k$j") && %h{"k$j"} == $j;
+        $j++;
+    }
+    $i := $i + 3;
+}
+ok($lost == 0, 'keys after a deleted one in the index are still found');
+ok(nqp::elems(%h) == $n - nqp::div_i($n + 2, 3), 'elems counts the deletes');
+
+# Iterate, deleting the current key and the next one in key order as we
+# go. The iteration must visit each key that was still there when it got
+# to it exactly once.
+my %seen;
+my int $twice := 0;
+my int $ghost := 0;
+my $it := nqp::iter(%h);
+while $it {
+    nqp::shift($it);
+    my str $key := nqp::iterkey_s($it);
+    $twice++ if nqp::existskey(%seen, $key);
+    $ghost++ unless nqp::existskey(%h, $key);
+    %seen{$key} := 1;
+    nqp::deletekey(%h, $key);
+    my int $k := nqp::substr($key, 1) + 1;
+    nqp::deletekey(%h, "k$k");
+}
+ok($twice == 0, 'no key is visited twice while deleting during iteration');
+ok($ghost == 0, 'no key deleted earlier in the iteration is visited');
+ok(nqp::elems(%h) == 0, 'the iteration deleted everything');
+ok(nqp::elems(%seen) > 0 && nqp::elems(%seen) < $n - nqp::div_i($n + 2, 3),
+    'keys deleted ahead of the iterator were skipped');
+
+# Deleting the key the iterator is at is reported if it is then asked for.
+my %small;
+%small<a> := 1;
+%small<b> := 2;
+$it := nqp::iter(%small);
+nqp::shift($it);
+nqp::deletekey(%small, nqp::iterkey_s($it));
+ok(throws({ nqp::iterkey_s($it) }), 'asking for a deleted current key throws');
+nqp::shift($it);
+ok(nqp::existskey(%small, nqp::iterkey_s($it)), 'iteration goes on to the next key');
@@ -0,0 +1,67 @@
+# Tests for decoding UTF-8 that is mostly ASCII, which is copied over a run
+# at a time. What follows a run may still combine with its last char, so
+# runs are tried ending in each position up to past the 64 bytes a vector
+# scan looks at in one go, both for whole buffers and for a decode stream.
+
+plan(71 * 4 + 3);
+
+my $Decoder := repr_type('Decoder');
+
+# Decodes a buffer of UTF-8 in a stream, adding it a few bytes at a time.
+sub decode_stream($buf, int $chunk) {
+    my $dec := nqp::create($Decoder);
+    nqp::decoderconfigure($dec, 'utf8', nqp::hash());
+    my $type := nqp::what($buf);
+    my int $i := 0;
+    while $i < nqp::elems($buf) {
+        my $part := nqp::create($type);
+        my int $j := $i;
+        while $j < $i + $chunk && $j < nqp::elems($buf) {
+            nqp::push_i($part, nqp::atpos_i($buf, $j));
+            $j++;
+        }
+        nqp::decoderaddbytes($dec, $part);
+        $i := $j;
+    }
+    nqp::decodertakeallchars($dec)
+}
+
+my int $len := 0;
+while $len <= 70 {
+    my str $ascii := nqp::substr(nqp::x('The quick brown fox. ', 4), 0, $len);
+
+    # A combining char after the run joins its last char.
+    my str $combined := $ascii ~ "\x[301]x";
+    my str $got := nqp::decode(encode($combined, 'utf8'), 'utf8');
+    ok($got eq $combined && nqp::chars($got) == nqp::chars($combined),
+        "a combining char after $len ASCII chars joins the last of them");
+
+    # \r\n is a single grapheme, even with a run before it.
+    my str $crlf := $ascii ~ "\r\n" ~ $ascii;
+    $got := nqp::decode(encode($crlf, 'utf8'), 'utf8');
+    ok($got eq $crlf && nqp::chars($got) == 2 * $len + 1,
+        "\\r\\n after $len ASCII chars is one grapheme");
+
+    # Multi-byte chars between runs.
+    my str $mixed := $ascii ~ "\x[E9]\x[4E2D]" ~ $ascii ~ "\x[1F600]";
+    $got := nqp::decode(encode($mixed, 'utf8'), 'utf8');
+    ok($got eq $mixed, "multi-byte chars between runs of $len ASCII chars");
+
+    $got := decode_stream(encode($combined ~ $crlf ~ $mixed, 'utf8'), 7);
+    ok($got eq $combined ~ $crlf ~ $mixed,
+        "a decode stream gets the same from runs of $len ASCII chars");
+
+    $len++;
+}
+
+# Invalid UTF-8 is still found after a long run of ASCII.
+my $buf := encode(nqp::x('a', 100), 'utf8');
+nqp::push_i($buf, 0xFF);
+ok(throws({ nqp::decode($buf, 'utf8') }), 'an invalid byte after a run of ASCII throws');
+$buf := encode(nqp::x('a', 100), 'utf8');
+nqp::push_i($buf, 0xC3);
+ok(throws({ nqp::decode($buf, 'utf8') }), 'a truncated sequence after a run of ASCII throws');
+
+# All ASCII, of a length that leaves a few bytes over after the vectors.
+my str $long := nqp::x('abcdefg', 37);
+ok(nqp::decode(encode($long, 'utf8'), 'utf8') eq $long, 'a long all-ASCII buffer decodes');
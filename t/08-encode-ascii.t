@@ -0,0 +1,72 @@
+# Tests for encoding strings stored 8 bits per grapheme, which are copied
+# straight into the buffer when they are all ASCII. Substrings, strands and
+# repetitions must give the same bytes as encoding a grapheme at a time,
+# and strings with Latin-1 or synthetic graphemes must not be copied.
+
+my @encodings := ['utf8', 'iso-8859-1', 'ascii'];
+
+my str $flat := 'The quick brown fox jumps over the lazy dog. 0123456789';
+my @strings := [
+    '',
+    $flat,
+    nqp::substr($flat, 5, 30),
+    nqp::concat(nqp::substr($flat, 3, 7), nqp::substr($flat, 20)),
+    nqp::x('abc', 25),
+    nqp::substr(nqp::x('abcd', 20), 3, 50),
+    nqp::concat(nqp::x('ab', 3), nqp::concat($flat, nqp::x('xyz', 4))),
+];
+my @latin1 := [
+    "caf\x[E9] au lait",
+    nqp::concat($flat, "\x[FF]"),
+    nqp::concat(nqp::x("\x[E9]", 10), 'abc'),
+];
+my @synthetic := [
+    "e\x[301]",
+    nqp::concat($flat, "a\x[308]"),
+    "\r\n",
+];
+
+plan(nqp::elems(@encodings) * nqp::elems(@strings) * 2
+    + 2 * nqp::elems(@latin1) + nqp::elems(@synthetic) + 1);
+
+# Encodes a string a grapheme at a time.
+sub encode_each(str $s, str $encoding) {
+    my $result := encode('', $encoding);
+    my int $i := 0;
+    while $i < nqp::chars($s) {
+        my $g := encode(nqp::substr($s, $i, 1), $encoding);
+        my int $j := 0;
+        while $j < nqp::elems($g) {
+            nqp::push_i($result, nqp::atpos_i($g, $j));
+            $j++;
+        }
+        $i++;
+    }
+    $result
+}
+
+for @encodings -> $encoding {
+    my int $n := 0;
+    for @strings -> $s {
+        my $buf := encode($s, $encoding);
+        ok(same_i($buf, encode_each($s, $encoding)), "$encoding encoding of ASCII string $n");
+        ok(nqp::decode($buf, $encoding) eq $s, "$encoding encoding of ASCII string $n round-trips");
+        $n++;
+    }
+}
+
+my int $n := 0;
+for @latin1 -> $s {
+    ok(same_i(encode($s, 'utf8'), encode_each($s, 'utf8')), "UTF-8 encoding of Latin-1 string $n");
+    ok(same_i(encode($s, 'iso-8859-1'), encode_each($s, 'iso-8859-1')),
+        "Latin-1 encoding of Latin-1 string $n");
+    $n++;
+}
+
+$n := 0;
+for @synthetic -> $s {
+    ok(nqp::decode(encode($s, 'utf8'), 'utf8') eq $s, "UTF-8 encoding of string $n with a synthetic");
+    $n++;
+}
+
+ok(throws({ encode("caf\x[E9]", 'ascii') }), 'ASCII encoding of a Latin-1 string throws');
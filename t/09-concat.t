@@ -0,0 +1,75 @@
+# Tests for building strings by appending many pieces, which keeps the
+# strands of the result balanced by size by merging trailing ones. Whatever
+# gets merged, the string must read the same as one joined in one go.
+
+plan(4 * 4 + 3);
+
+# Pieces of varying kinds: flat, substrings, repetitions and ones with
+# graphemes outside of 8 bits.
+my @pieces := [
+    'a', 'bc', nqp::x('de', 3), nqp::substr('fghijklmnop', 2, 5), "\x[4E2D]\x[6587]",
+    nqp::x('q', 40), 'r', nqp::substr(nqp::x('stu', 10), 1, 20), "v\x[E9]w",
+];
+
+# Checks a string against a flat one with the same graphemes, looking at
+# graphemes and substrings all through it.
+sub same_string(str $s, str $flat) {
+    return 0 unless nqp::chars($s) == nqp::chars($flat) && $s eq $flat;
+    my int $i := 0;
+    while $i < nqp::chars($flat) {
+        return 0 unless nqp::ord($s, $i) == nqp::ord($flat, $i)
+            && nqp::substr($s, $i, 13) eq nqp::substr($flat, $i, 13);
+        $i := $i + 7;
+    }
+    1
+}
+
+for 10, 100, 1000, 5000 -> $count {
+    # Append, and collect the pieces to join in one go to compare with.
+    my str $appended := '';
+    my @parts := nqp::list_s();
+    my int $i := 0;
+    while $i < $count {
+        my str $piece := @pieces[$i % nqp::elems(@pieces)];
+        $appended := nqp::concat($appended, $piece);
+        nqp::push_s(@parts, $piece);
+        $i++;
+    }
+    my str $joined := nqp::join('', @parts);
+    ok(same_string($appended, $joined), "appending $count pieces");
+
+    # Prepending doesn't merge the strands at the end.
+    my str $prepended := '';
+    $i := $count - 1;
+    while $i >= 0 {
+        $prepended := nqp::concat(@pieces[$i % nqp::elems(@pieces)], $prepended);
+        $i--;
+    }
+    ok(same_string($prepended, $joined), "prepending $count pieces");
+
+    # Appending two strings that were each built by appending.
+    ok(same_string(nqp::concat($appended, $prepended), nqp::concat($joined, $joined)),
+        "concatenating two strings of $count appended pieces");
+
+    # Searching spans the merged and unmerged strands alike.
+    ok(nqp::index($appended, "w\x[4E2D]") == nqp::index($joined, "w\x[4E2D]"),
+        "searching a string of $count appended pieces");
+}
+
+# A combining char appended to a string with many strands joins its last
+# grapheme.
+my str $s := '';
+my int $i := 0;
+while $i < 200 {
+    $s := nqp::concat($s, 'ab');
+    $i++;
+}
+$s := nqp::concat($s, 'e');
+$s := nqp::concat($s, "\x[301]");
+ok(nqp::chars($s) == 401, 'a combining char appended to many strands joins the last grapheme');
+ok(nqp::substr($s, 400) eq "e\x[301]", 'which is the last one');
+
+# A \n appended after a \r makes a single grapheme.
+$s := nqp::concat($s, "\r");
+$s := nqp::concat($s, "\n");
+ok(nqp::chars($s) == 402, 'a \n appended after a \r makes a single grapheme');
@@ -0,0 +1,63 @@
+# Tests for text in the Latin-1 range, which is stored 8 bits per grapheme.
+# Such strings must read, compare and hash the same as equal strings made
+# in ways that store them 32 bits per grapheme.
+
+plan(14);
+
+# Every codepoint up to 0xFF, decoded from Latin-1 and made a char at a time.
+my $bytes := encode('', 'iso-8859-1');
+my str $built := '';
+my int $i := 1;
+while $i < 256 {
+    nqp::push_i($bytes, $i);
+    $built := nqp::concat($built, nqp::chr($i));
+    $i++;
+}
+my str $decoded := nqp::decode($bytes, 'iso-8859-1');
+ok($decoded eq $built && nqp::chars($decoded) == 255, 'decoding all of Latin-1');
+
+my int $wrong := 0;
+$i := 0;
+while $i < 255 {
+    $wrong++ unless nqp::ord($decoded, $i) == $i + 1;
+    $i++;
+}
+ok($wrong == 0, 'graphemes above 0x7F read back as codepoints, not negative');
+
+# The same text from UTF-8, and with a char outside of 8 bits added and
+# taken off again.
+my str $from_utf8 := nqp::decode(encode($built, 'utf8'), 'utf8');
+my str $via_wide  := nqp::substr(nqp::concat($built, "\x[4E2D]"), 0, 255);
+ok($from_utf8 eq $decoded && $via_wide eq $decoded, 'the same text made in other ways is eq');
+
+my %h;
+%h{$decoded} := 1;
+ok(nqp::existskey(%h, $from_utf8) && nqp::existskey(%h, $via_wide), 'and hashes the same');
+
+# Ordering is by codepoint, so chars above 0x7F sort after ASCII.
+ok(nqp::cmp_s("\x[E9]", 'z') == 1, 'a Latin-1 char sorts after ASCII');
+ok(nqp::cmp_s("caf\x[E9]", "caf\x[FF]") == -1, 'Latin-1 chars sort by codepoint');
+ok(nqp::cmp_s(nqp::substr($decoded, 200, 10), nqp::substr($via_wide, 200, 10)) == 0,
+    'equal 8-bit and 32-bit substrings compare equal');
+
+# Searching.
+ok(nqp::index($decoded, "\x[E9]\x[EA]") == 0xE8, 'index finds Latin-1 chars');
+ok(nqp::index($via_wide, nqp::substr($decoded, 0xE8, 2)) == 0xE8,
+    'index finds 8-bit text in a string that was 32-bit');
+
+# Case changes that leave the Latin-1 range.
+ok(nqp::uc("\x[FF]") eq "\x[178]", 'uppercasing y with diaeresis leaves Latin-1');
+ok(nqp::uc("stra\x[DF]e") eq 'STRASSE', 'uppercasing sharp s gives two graphemes');
+
+# A \r\n decoded from Latin-1 is still a single grapheme.
+my $crlf := encode("ab\x[E9]", 'iso-8859-1');
+nqp::push_i($crlf, 13);
+nqp::push_i($crlf, 10);
+nqp::push_i($crlf, 0xE9);
+my str $with_crlf := nqp::decode($crlf, 'iso-8859-1');
+ok(nqp::chars($with_crlf) == 5, 'a \r\n decoded from Latin-1 is one grapheme');
+ok(nqp::substr($with_crlf, 4) eq "\x[E9]", 'with the text after it intact');
+
+# Joining Latin-1 text and combining chars.
+ok(nqp::chars(nqp::concat("caf\x[E9]", "\x[301]")) == 4,
+    'a combining char appended to a Latin-1 char joins it');
@@ -0,0 +1,74 @@
+# Tests for internstr. Two different interned strings are taken to be
+# unequal without comparing them, so equal strings, however they were
+# made, must always intern to the same one, including after the GC has
+# moved or dropped interned strings.
+
+plan(9);
+
+my str $flat   := 'interned string';
+my str $strand := nqp::concat('interned', ' string');
+my str $wide   := nqp::substr(nqp::concat('interned string', "\x[4E2D]"), 0, 15);
+
+my str $a := nqp::internstr($flat);
+ok($a eq $flat, 'an interned string is equal to the original');
+ok(nqp::internstr($strand) eq $a, 'a strand string interns to the same string');
+ok(nqp::internstr($wide) eq $a, 'a string stored 32 bits per grapheme interns to the same string');
+ok(nqp::internstr('interned strinG') ne $a, 'a different string interns to a different one');
+
+# Many strings, so the table grows, with the GC moving those in the
+# nursery and dropping those no longer referenced.
+my @kept := nqp::list_s();
+my int $i := 0;
+while $i < 5000 {
+    my str $s := nqp::internstr("key$i");
+    nqp::push_s(@kept, $s) if $i % 10 == 0;
+    $i++;
+}
+nqp::force_gc();
+nqp::force_gc();
+my int $bad := 0;
+$i := 0;
+while $i < 500 {
+    my str $again := nqp::internstr(nqp::concat('key', ~($i * 10)));
+    $bad++ unless $again eq nqp::atpos_s(@kept, $i);
+    $bad++ if $again eq nqp::atpos_s(@kept, ($i + 1) % 500);
+    $i++;
+}
+ok($bad == 0, 'strings interned before GC are found again after it');
+
+$bad := 0;
+$i := 0;
+while $i < 5000 {
+    $bad++ unless nqp::internstr("key$i") eq "key$i";
+    $i++;
+}
+ok($bad == 0, 'strings whose interned copy died are interned afresh');
+
+my %h;
+%h{nqp::internstr('k1')} := 1;
+%h{'k' ~ 1} := 2;
+ok(nqp::elems(%h) == 1 && %h<k1> == 2, 'interned and other strings are the same hash key');
+
+# Threads interning the same strings at once all get the same ones, so
+# those from different threads compare equal.
+my @per_thread;
+nqp::push(@per_thread, nqp::list_s()) for 1, 2, 3, 4;
+run_threads(4, -> int $id {
+    my @mine := @per_thread[$id];
+    my int $k := 0;
+    while $k < 2000 {
+        nqp::push_s(@mine, nqp::internstr(nqp::concat('shared', ~($k % 100))));
+        $k++;
+    }
+});
+$bad := 0;
+$i := 0;
+while $i < 2000 {
+    my str $s := nqp::atpos_s(@per_thread[0], $i);
+    $bad++ unless nqp::atpos_s(@per_thread[1], $i) eq $s
+        && nqp::atpos_s(@per_thread[2], $i) eq $s
+        && nqp::atpos_s(@per_thread[3], $i) eq $s;
+    $i++;
+}
+ok($bad == 0, 'threads interning the same strings get the same ones');
+ok(nqp::internstr('shared7') eq nqp::atpos_s(@per_thread[2], 7), 'and they are in the table');
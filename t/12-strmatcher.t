@@ -0,0 +1,106 @@
+# Tests for StringMatcher, which finds occurrences of any of a set of
+# needles in one pass over a haystack, compared against looking for each
+# needle at each position with substr.
+
+my $StringMatcher := repr_type('StringMatcher');
+
+my @needles := nqp::list_s('he', 'she', 'his', 'hers', 'e', 'ssh', "\x[E9]t\x[E9]", 'aaa', '');
+my @haystacks := [
+    'ushers',
+    'she sells seashells; his hers',
+    nqp::concat(nqp::x('a', 10), 'hers'),
+    nqp::concat("l'\x[E9]t", "\x[E9] \x[E9]t\x[E9]!"),
+    'nothing to see',
+    '',
+];
+
+plan(nqp::elems(@haystacks) * 3 + 6);
+
+# Finds all occurrences the slow way, keyed as start,end,needle.
+sub ref_all(str $h, int $start, int $ic) {
+    my %found;
+    my int $s := $start;
+    while $s < nqp::chars($h) {
+        my int $n := 0;
+        while $n < nqp::elems(@needles) {
+            my str $needle := nqp::atpos_s(@needles, $n);
+            my int $len    := nqp::chars($needle);
+            if $len && $s + $len <= nqp::chars($h) {
+                my str $here := nqp::substr($h, $s, $len);
+                %found{"$s," ~ ($s + $len) ~ ",$n"} := 1
+                    if $ic ?? nqp::fc($here) eq nqp::fc($needle) !! $here eq $needle;
+            }
+            $n++;
+        }
+        $s++;
+    }
+    %found
+}
+
+# Checks the results of strmatcherall against the slow way.
+sub same_all($matcher, str $h, int $start, int $ic) {
+    my @results := nqp::list_i();
+    my int $count := nqp::strmatcherall($matcher, $h, $start, @results);
+    my %expected := ref_all($h, $start, $ic);
+    return 0 unless $count == nqp::elems(%expected) && nqp::elems(@results) == 3 * $count;
+    my int $i := 0;
+    while $i < $count {
+        my str $key := nqp::atpos_i(@results, 3 * $i) ~ ','
+            ~ nqp::atpos_i(@results, 3 * $i + 1) ~ ','
+            ~ nqp::atpos_i(@results, 3 * $i + 2);
+        return 0 unless nqp::existskey(%expected, $key);
+        $i++;
+    }
+    1
+}
+
+# Checks strmatcherfirst picks the occurrence that starts first, and the
+# longest of those.
+sub same_first($matcher, str $h, int $ic) {
+    my @results := nqp::list_i();
+    my int $got := nqp::strmatcherfirst($matcher, $h, 0, @results);
+    my int $best_start := -1;
+    my int $best_end   := -1;
+    for ref_all($h, 0, $ic) {
+        my @parts := nqp::split(',', $_.key);
+        my int $s := +@parts[0];
+        my int $e := +@parts[1];
+        if $best_start < 0 || $s < $best_start || $s == $best_start && $e > $best_end {
+            $best_start := $s;
+            $best_end   := $e;
+        }
+    }
+    return $got == -1 && nqp::elems(@results) == 0 if $best_start < 0;
+    $got == $best_start && nqp::atpos_i(@results, 0) == $best_start
+        && nqp::atpos_i(@results, 1) == $best_end
+}
+
+my $matcher := nqp::create($StringMatcher);
+nqp::strmatcherconfigure($matcher, @needles, 0);
+my $matcher_ic := nqp::create($StringMatcher);
+nqp::strmatcherconfigure($matcher_ic, @needles, 1);
+
+my int $hi := 0;
+for @haystacks -> $h {
+    ok(same_all($matcher, $h, 0, 0), "all matches in haystack $hi");
+    ok(same_first($matcher, $h, 0), "first match in haystack $hi");
+    ok(same_all($matcher_ic, nqp::uc($h), 0, 1), "all matches ignoring case in haystack $hi");
+    $hi++;
+}
+
+ok(same_all($matcher, 'she sells seashells; his hers', 12, 0), 'matching from a start position');
+ok(same_all($matcher, nqp::concat(nqp::x('sh', 5), nqp::x('ers', 3)), 0, 0),
+    'matching over strands and repetitions');
+
+# A grapheme that casefolds to more than one only matches whole.
+my $fold := nqp::create($StringMatcher);
+nqp::strmatcherconfigure($fold, nqp::list_s('ss', 'strasse'), 1);
+my @results := nqp::list_i();
+ok(nqp::strmatcherall($fold, "STRA\x[DF]E", 0, @results) == 2,
+    'a grapheme casefolding to two matches needles spanning both');
+
+ok(throws({ nqp::strmatcherconfigure($matcher, @needles, 0) }), 'configuring twice throws');
+ok(throws({ nqp::strmatcherfirst(nqp::create($StringMatcher), 'x', 0, nqp::list_i()) }),
+    'using an unconfigured matcher throws');
+ok(throws({ nqp::strmatcherall($matcher, 'she', 0, nqp::list()) }),
+    'results that are not a native int array throw');
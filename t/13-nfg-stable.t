@@ -0,0 +1,67 @@
+# Tests for making NFG strings from codepoints, which copies runs of
+# codepoints that are stable in NFG without normalizing them. Codepoints
+# that combine, reorder, compose, decompose, prepend or are controls must
+# still be normalized, wherever they come in a run.
+
+plan(13);
+
+sub codes(*@cps) {
+    my @list := nqp::list_i();
+    nqp::push_i(@list, $_) for @cps;
+    @list
+}
+
+sub from_codes(@cps) {
+    nqp::strfromcodes(@cps)
+}
+
+# A long stable run, crossing from one block of 256 codepoints to the next.
+my @cjk := nqp::list_i();
+my int $cp := 0x4E00 + 200;
+while $cp < 0x4E00 + 500 {
+    nqp::push_i(@cjk, $cp);
+    $cp++;
+}
+my str $s := from_codes(@cjk);
+my int $bad := 0;
+my int $i := 0;
+while $i < 300 {
+    $bad++ unless nqp::ord($s, $i) == 0x4E00 + 200 + $i;
+    $i++;
+}
+ok(nqp::chars($s) == 300 && $bad == 0, 'a long stable run is copied as it is');
+
+# A combining mark after a long run joins the last codepoint of it.
+my @run := nqp::list_i();
+$i := 0;
+while $i < 100 {
+    nqp::push_i(@run, nqp::ord('abcde', $i % 5));
+    $i++;
+}
+nqp::push_i(@run, 0x301);
+$s := from_codes(@run);
+ok(nqp::chars($s) == 100 && nqp::substr($s, 99) eq "\x[E9]", 'a combining mark composes with the end of a run');
+
+ok(from_codes(codes(0x61, 0x65, 0x323, 0x301, 0x62)) eq from_codes(codes(0x61, 0x65, 0x301, 0x323, 0x62)),
+    'combining marks are put in canonical order');
+ok(nqp::chars(from_codes(codes(0x61, 0x65, 0x323, 0x301, 0x62))) == 3,
+    'and joined with their base');
+
+ok(from_codes(codes(0x61, 0x212B, 0x62)) eq "a\x[C5]b", 'a singleton decomposition in a run is applied');
+ok(from_codes(codes(0x2126)) eq "\x[3A9]", 'and on its own');
+
+ok(from_codes(codes(0x61, 0x1100, 0x1161, 0x11A8, 0x62)) eq "a\x[AC01]b", 'Hangul jamo compose');
+ok(nqp::chars(from_codes(codes(0x61, 0x600, 0x31, 0x32))) == 3, 'a prepend joins the codepoint after it');
+ok(nqp::chars(from_codes(codes(0x61, 0x0D, 0x0A, 0x62))) == 3, '\r\n is a single grapheme');
+ok(nqp::chars(from_codes(codes(0x61, 0x0D, 0x62))) == 3, 'a lone \r is not');
+
+# Stable codepoints on either side of the combining marks block.
+ok(nqp::chars(from_codes(codes(0x2FF, 0x300, 0x370, 0x36F))) == 2,
+    'codepoints next to the combining marks block are classified right');
+
+# The same from decoding UTF-8 and from codepoints.
+my str $mixed := "abc\x[E9]d\x[65]\x[301]\x[4E2D]\r\n\x[1100]\x[1161]z";
+ok(nqp::decode(encode($mixed, 'utf8'), 'utf8') eq $mixed, 'decoding gives NFG');
+my @codes := nqp::list_i();
+nqp::strtocodes($mixed, nqp::const::NORMALIZE_NFD, @codes);
+ok(from_codes(@codes) eq $mixed, 'NFD codepoints give back the NFG string');
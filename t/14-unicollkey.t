@@ -0,0 +1,57 @@
+# Tests for unicollkey. Comparing the sort keys of two strings a byte at a
+# time must order them as unicmp_s does the strings, whichever collation
+# levels are enabled and whichever way round.
+
+my @strings := [
+    '', 'a', 'A', 'b', 'ab', 'aB', 'Ab', 'a b', 'a-b', "\x[E9]", 'e', 'E',
+    "e\x[301]\x[323]", 'cote', "cot\x[E9]", "c\x[F4]te", "c\x[F4]t\x[E9]",
+    '10', '9', "\x[4E2D]", "\x[FB01]", 'fi', "\x[1F600]", "stra\x[DF]e", 'strasse',
+];
+my @modes := [85, 1, 5, 21, 2, 6, 22, 85 + 64, 1 + 128, 3, 0];
+
+plan(nqp::elems(@modes) + 3);
+
+my $buf8 := native_array_type(8, 1);
+
+sub key(str $s, int $mode) {
+    nqp::unicollkey($s, $mode, 0, 0, nqp::create($buf8))
+}
+
+# Compares two byte arrays as memcmp would, giving -1, 0 or 1.
+sub cmp_bytes($a, $b) {
+    my int $i := 0;
+    while $i < nqp::elems($a) && $i < nqp::elems($b) {
+        my int $x := nqp::atpos_i($a, $i);
+        my int $y := nqp::atpos_i($b, $i);
+        return $x < $y ?? -1 !! 1 unless $x == $y;
+        $i++;
+    }
+    nqp::cmp_i(nqp::elems($a), nqp::elems($b))
+}
+
+for @modes -> $mode {
+    my @keys;
+    nqp::push(@keys, key($_, $mode)) for @strings;
+    my int $wrong := 0;
+    my int $i := 0;
+    while $i < nqp::elems(@strings) {
+        my int $j := 0;
+        while $j < nqp::elems(@strings) {
+            my int $expected := nqp::unicmp_s(@strings[$i], @strings[$j], $mode, 0, 0);
+            my int $got      := cmp_bytes(@keys[$i], @keys[$j]);
+            unless $got == $expected {
+                say("# mode $mode: '" ~ @strings[$i] ~ "' vs '" ~ @strings[$j] ~ "': got $got, expected $expected");
+                $wrong++;
+            }
+            $j++;
+        }
+        $i++;
+    }
+    ok($wrong == 0, "keys order strings as unicmp_s does in collation mode $mode");
+}
+
+ok(same_i(key(nqp::x("c\x[F4]t\x[E9] ", 50), 85), key(nqp::x("c\x[F4]t\x[E9] ", 50), 85)),
+    'keys of a long string are the same each time');
+ok(throws({ nqp::unicollkey('a', 85, 0, 0, nqp::list_i()) }), 'a result that is not a uint8 array throws');
+my $full := key('a', 85);
+ok(throws({ nqp::unicollkey('a', 85, 0, 0, $full) }), 'a result that is not empty throws');
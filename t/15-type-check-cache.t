@@ -0,0 +1,87 @@
+# Tests for type checks against type check caches, which are indexed by
+# type cache ID once they are long. Checks must be right for caches either
+# side of that length, and while other threads replace the cache.
+
+plan(9);
+
+sub new_types(int $count) {
+    my @types;
+    my int $i := 0;
+    while $i < $count {
+        nqp::push(@types, repr_type('Uninstantiable'));
+        $i++;
+    }
+    @types
+}
+
+# Checks that a type has exactly the wanted ones of a set of types.
+sub checks_as(int $count) {
+    my @types := new_types($count * 2);
+    my $type  := repr_type('Uninstantiable');
+    my @cache := [$type];
+    my int $i := 0;
+    while $i < $count {
+        nqp::push(@cache, @types[$i * 2]);
+        $i++;
+    }
+    nqp::settypecache($type, @cache);
+    my int $wrong := 0;
+    $i := 0;
+    while $i < $count * 2 {
+        $wrong++ unless nqp::istype($type, @types[$i]) == ($i % 2 == 0);
+        $i++;
+    }
+    $wrong++ unless nqp::istype($type, $type);
+    $wrong == 0
+}
+
+for 1, 7, 8, 9, 100, 1000 -> $count {
+    ok(checks_as($count), "a type check cache of $count types");
+}
+
+# Replacing a cache with a shorter or longer one.
+my @types := new_types(20);
+my $type  := repr_type('Uninstantiable');
+nqp::settypecache($type, @types);
+nqp::settypecache($type, [@types[0], @types[1]]);
+ok(nqp::istype($type, @types[1]) && !nqp::istype($type, @types[5]),
+    'a long cache replaced by a short one');
+nqp::settypecache($type, @types);
+ok(nqp::istype($type, @types[19]), 'a short cache replaced by a long one');
+
+# Threads check types while another keeps replacing the cache with ones
+# that always hold the first four types, and never any of the others.
+my @wrong := nqp::list_i(0, 0, 0, 0);
+my $writer := nqp::newthread({
+    my int $k := 0;
+    while $k < 2000 {
+        # Between 4 and 13 types, so the cache switches between having an
+        # index and not.
+        my @cache;
+        my int $i := 0;
+        while $i < 4 {
+            nqp::push(@cache, @types[$i]);
+            $i++;
+        }
+        $i := 0;
+        while $i < $k % 10 {
+            nqp::push(@cache, repr_type('Uninstantiable'));
+            $i++;
+        }
+        nqp::settypecache($type, @cache);
+        $k++;
+    }
+}, 0);
+nqp::threadrun($writer);
+run_threads(4, -> int $id {
+    my int $k := 0;
+    while $k < 20000 {
+        my int $i := $k % 20;
+        nqp::bindpos_i(@wrong, $id, nqp::atpos_i(@wrong, $id) + 1)
+            unless nqp::istype($type, @types[$i]) == ($i < 4);
+        $k++;
+    }
+});
+nqp::threadjoin($writer);
+ok(nqp::atpos_i(@wrong, 0) + nqp::atpos_i(@wrong, 1) + nqp::atpos_i(@wrong, 2)
+    + nqp::atpos_i(@wrong, 3) == 0, 'type checks are right while the cache is replaced');
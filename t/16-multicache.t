@@ -0,0 +1,95 @@
+# Tests for multi-dispatch caches, which keep a tree per callsite until
+# they have many entries, then become megamorphic and move them to a hash
+# shared by all such caches. Lookups must find the same either way, and
+# caches that die must not disturb the entries of the others.
+
+plan(10);
+
+my @types;
+my int $i := 0;
+while $i < 200 {
+    nqp::push(@types, repr_type('VMHash'));
+    $i++;
+}
+
+sub capture($a, $b) { nqp::savecapture() }
+sub capture_named($a, :$named) { nqp::savecapture() }
+
+# Adds entries for pairs of a type object and an instance of a type to a
+# cache, then checks they can all be found, and that other pairs aren't.
+sub fill(int $entries, int $offset) {
+    my $cache := nqp::null();
+    my int $i := 0;
+    while $i < $entries {
+        $cache := nqp::multicacheadd($cache,
+            capture(@types[($i + $offset) % 200], nqp::create(@types[$i % 7])), nqp::box_i($i, Int));
+        $i++;
+    }
+    $cache
+}
+sub all_found($cache, int $entries, int $offset) {
+    my int $i := 0;
+    while $i < $entries {
+        my $found := nqp::multicachefind($cache,
+            capture(@types[($i + $offset) % 200], nqp::create(@types[$i % 7])));
+        return 0 if nqp::isnull($found) || nqp::unbox_i($found) != $i;
+        return 0 unless nqp::isnull(nqp::multicachefind($cache,
+            capture(nqp::create(@types[($i + $offset) % 200]), nqp::create(@types[$i % 7]))));
+        return 0 unless nqp::isnull(nqp::multicachefind($cache,
+            capture(@types[($i + $offset) % 200], @types[$i % 7])));
+        $i++;
+    }
+    1
+}
+
+my $small := fill(20, 0);
+my %stats := nqp::multicachestats($small);
+ok(all_found($small, 20, 0), 'entries of a small cache are found');
+ok(%stats<entries> == 20 && %stats<megamorphic> == 0 && %stats<callsites> == 1,
+    'a small cache is not megamorphic');
+ok(nqp::existskey(%stats, 'hits') && nqp::existskey(%stats, 'misses'),
+    'the stats have the hits and misses, whether or not they are counted');
+
+my $big := fill(150, 0);
+%stats := nqp::multicachestats($big);
+ok(all_found($big, 150, 0), 'entries of a megamorphic cache are found');
+ok(%stats<entries> == 150 && %stats<megamorphic> == 1, 'a big cache is megamorphic');
+
+# Another callsite in the same cache.
+$big := nqp::multicacheadd($big, capture_named(@types[3], :named(@types[4])), nqp::box_i(-1, Int));
+my $found := nqp::multicachefind($big, capture_named(@types[3], :named(@types[4])));
+ok(!nqp::isnull($found) && nqp::unbox_i($found) == -1, 'a named argument callsite in a megamorphic cache');
+ok(nqp::isnull(nqp::multicachefind($big, capture_named(@types[3], :named(@types[5])))),
+    'which tells named arguments apart');
+
+# Megamorphic caches that die, while others keep being added to, so their
+# entries get dropped from the shared hash as it grows.
+my @caches;
+$i := 0;
+while $i < 6 {
+    nqp::push(@caches, fill(100, $i * 30));
+    $i++;
+}
+@caches[1] := nqp::null();
+@caches[4] := nqp::null();
+nqp::force_gc();
+nqp::force_gc();
+my $grown := fill(190, 7);
+ok(all_found($grown, 190, 7), 'a new megamorphic cache after others died');
+my int $ok := 1;
+for 0, 2, 3, 5 -> $c {
+    $ok := 0 unless all_found(@caches[$c], 100, $c * 30);
+}
+ok($ok, 'megamorphic caches that live on keep their entries');
+
+# The same entries in two megamorphic caches give each its own results.
+my $other := nqp::null();
+$i := 0;
+while $i < 150 {
+    $other := nqp::multicacheadd($other, capture(@types[$i], nqp::create(@types[$i % 7])),
+        nqp::box_i($i + 1000, Int));
+    $i++;
+}
+ok(nqp::unbox_i(nqp::multicachefind($other, capture(@types[5], nqp::create(@types[5]))))
+    == 1005 && nqp::unbox_i(nqp::multicachefind($big, capture(@types[5], nqp::create(@types[5]))))
+    == 5, 'megamorphic caches with the same keys are kept apart');
@@ -0,0 +1,124 @@
+# Tests for arrays that share their elements with slices or clones of them
+# until one is written to. Whichever of them is changed, and however, the
+# others must not see it.
+
+plan(13);
+
+# Makes a native int array of multiples of 3, without slicing.
+sub ints_from(int $from, int $n) {
+    my @a := nqp::list_i();
+    my int $i := $from;
+    while $i < $from + $n {
+        nqp::push_i(@a, $i * 3);
+        $i++;
+    }
+    @a
+}
+sub ints(int $n) { ints_from(0, $n) }
+
+# Each way of changing an array, applied to one of a group sharing elements.
+my @changes := [
+    -> @a { nqp::bindpos_i(@a, 2, -1) },
+    -> @a { nqp::push_i(@a, -1) },
+    -> @a { nqp::pop_i(@a) },
+    -> @a { nqp::shift_i(@a) },
+    -> @a { nqp::unshift_i(@a, -1) },
+    -> @a { nqp::splice(@a, nqp::list_i(-1, -2), 1, 3) },
+    -> @a { nqp::setelems(@a, 2) },
+    -> @a { nqp::setelems(@a, 100) },
+];
+
+# Makes a group of an array, a clone of it and a slice of it, which all
+# share their elements.
+sub group() {
+    my @orig := ints(50);
+    [@orig, nqp::clone(@orig), nqp::slice(@orig, 10, 29)]
+}
+
+# Changes each member of a group in turn, checking that the others still
+# have the elements they started with, and that the one changed has the
+# elements it would have had if it had not been sharing them.
+my int $n := 0;
+for ['original', 'clone', 'slice'] -> $changed {
+    my int $wrong := 0;
+    for @changes -> &change {
+        my @group    := group();
+        my @pristine := group();
+        my @expected := $n == 2 ?? ints_from(10, 20) !! ints(50);
+        change(@expected);
+        change(@group[$n]);
+        my int $m := 0;
+        while $m < 3 {
+            $wrong++ unless same_i(@group[$m], $m == $n ?? @expected !! @pristine[$m]);
+            $m++;
+        }
+    }
+    ok($wrong == 0, "changing the $changed leaves the others alone");
+    $n++;
+}
+
+my @orig  := ints(50);
+my @slice := nqp::slice(@orig, 10, 29);
+ok(nqp::elems(@slice) == 20 && nqp::atpos_i(@slice, 0) == 30 && nqp::atpos_i(@slice, 19) == 87,
+    'a slice sees the right elements');
+my @slice2 := nqp::slice(@slice, 5, 9);
+ok(nqp::elems(@slice2) == 5 && nqp::atpos_i(@slice2, 0) == 45, 'a slice of a slice');
+nqp::bindpos_i(@slice, 5, 1);
+ok(nqp::atpos_i(@slice2, 0) == 45 && nqp::atpos_i(@orig, 15) == 45,
+    'writing to the middle one of three leaves the others alone');
+@orig := nqp::null();
+@slice := nqp::null();
+nqp::force_gc();
+ok(same_i(@slice2, nqp::list_i(45, 48, 51, 54, 57)), 'a slice outlives what it was sliced from');
+nqp::push_i(@slice2, 60);
+ok(nqp::elems(@slice2) == 6 && nqp::atpos_i(@slice2, 5) == 60, 'and can then be grown');
+
+# Objects in shared slots are kept alive and moved by the GC.
+my @objs := nqp::list();
+my int $i := 0;
+while $i < 100 {
+    nqp::push(@objs, nqp::box_i($i, Int));
+    $i++;
+}
+my @objs_slice := nqp::slice(@objs, 50, 99);
+@objs := nqp::null();
+nqp::force_gc();
+nqp::force_gc();
+my int $bad := 0;
+$i := 0;
+while $i < 50 {
+    $bad++ unless nqp::unbox_i(nqp::atpos(@objs_slice, $i)) == $i + 50;
+    $i++;
+}
+ok($bad == 0, 'objects in a slice survive GC');
+
+# Strings too.
+my @strs := nqp::list_s('a', 'b', 'c', 'd');
+my @strs_clone := nqp::clone(@strs);
+nqp::bindpos_s(@strs_clone, 0, 'z');
+ok(nqp::atpos_s(@strs, 0) eq 'a' && nqp::atpos_s(@strs_clone, 0) eq 'z', 'a clone of a str array');
+
+# Many threads slicing the same array at once.
+my @shared := ints(1000);
+my @sums := nqp::list_i(0, 0, 0, 0);
+run_threads(4, -> int $id {
+    my int $k := 0;
+    my int $sum := 0;
+    while $k < 500 {
+        my @s := nqp::slice(@shared, $k, $k + 9);
+        nqp::bindpos_i(@s, 0, -1);
+        $sum := $sum + nqp::atpos_i(@s, 9);
+        $k++;
+    }
+    nqp::bindpos_i(@sums, $id, $sum);
+});
+my int $expected := 0;
+$i := 0;
+while $i < 500 {
+    $expected := $expected + ($i + 9) * 3;
+    $i++;
+}
+ok(nqp::atpos_i(@sums, 0) == $expected && nqp::atpos_i(@sums, 3) == $expected,
+    'threads slicing the same array each see the right elements');
+ok(same_i(@shared, ints(1000)), 'and leave it alone');
+ok(nqp::elems(nqp::slice(@shared, 0, -1)) == 1000, 'slicing to the end');
@@ -0,0 +1,68 @@
+# Tests for mapfile, which uses a file mapped into memory as the elements
+# of a native array. Mapped read-only, writing to the array throws, though
+# clones and slices of it may be written to; mapped privately, the first
+# write copies the elements. Either way, the file is never changed.
+
+plan(17);
+
+my int $READONLY := 0;
+my int $PRIVATE  := 1;
+
+my $buf8  := native_array_type(8, 1);
+my $buf32 := native_array_type(32, 0);
+
+my str $dir     := nqp::ifnull(nqp::atkey(nqp::getenvhash(), 'TMPDIR'), '/tmp');
+my str $file    := "$dir/moar-mapfile-test-" ~ nqp::getpid();
+my str $empty   := "$file-empty";
+my str $content := 'Hello, mapped world!!';
+spurt($file, $content);
+spurt($empty, '');
+
+my $ro := nqp::create($buf8);
+nqp::mapfile($ro, $file, $READONLY);
+ok(nqp::elems($ro) == nqp::chars($content), 'a mapped array has an element per byte');
+ok(nqp::decode($ro, 'utf8') eq $content, 'and the bytes of the file');
+ok(throws({ nqp::bindpos_i($ro, 0, 74) }), 'writing to a read-only mapped array throws');
+ok(throws({ nqp::push_i($ro, 74) }), 'so does growing it');
+
+my $clone := nqp::clone($ro);
+nqp::bindpos_i($clone, 0, 74);
+ok(nqp::atpos_i($clone, 0) == 74 && nqp::atpos_i($ro, 0) == 72,
+    'a clone of a read-only mapped array can be written to');
+my $slice := nqp::slice($ro, 7, 12);
+nqp::bindpos_i($slice, 0, 77);
+ok(nqp::decode($slice, 'utf8') eq 'Mapped' && nqp::atpos_i($ro, 7) == 109,
+    'so can a slice of one');
+
+my $private := nqp::create($buf8);
+nqp::mapfile($private, $file, $PRIVATE);
+my $private_slice := nqp::slice($private, 0, 4);
+nqp::bindpos_i($private, 0, 74);
+ok(nqp::decode($private, 'utf8') eq 'Jello, mapped world!!', 'a privately mapped array can be written to');
+ok(nqp::decode($private_slice, 'utf8') eq 'Hello', 'without a slice of it seeing that');
+nqp::push_i($private, 33);
+ok(nqp::elems($private) == nqp::chars($content) + 1, 'and grown');
+ok(slurp($file) eq $content, 'the file is not changed');
+
+my $ints := nqp::create($buf32);
+nqp::mapfile($ints, $file, $READONLY);
+ok(nqp::elems($ints) == 5, 'bytes left over past the last whole element are not mapped');
+
+my $none := nqp::create($buf8);
+nqp::mapfile($none, $empty, $READONLY);
+ok(nqp::elems($none) == 0, 'an empty file maps to an empty array');
+
+my $full := nqp::create($buf8);
+nqp::push_i($full, 1);
+ok(throws({ nqp::mapfile($full, $file, $READONLY) }), 'mapping into an array that is not empty throws');
+ok(throws({ nqp::mapfile(nqp::list(), $file, $READONLY) }), 'mapping into an object array throws');
+ok(throws({ nqp::mapfile(nqp::create($buf8), $file, 2) }), 'an unknown mode throws');
+ok(throws({ nqp::mapfile(nqp::create($buf8), "$file-missing", $READONLY) }), 'a missing file throws');
+
+# The mapping stays until the last array using it is gone.
+$ro := nqp::null();
+nqp::force_gc();
+ok(nqp::decode(nqp::slice($private_slice, 0, 1), 'utf8') eq 'He', 'arrays live on after others are freed');
+
+nqp::unlink($file);
+nqp::unlink($empty);
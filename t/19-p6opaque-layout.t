@@ -0,0 +1,94 @@
+# Tests for the layout of P6opaque objects, which puts small attributes in
+# the padding left by aligning earlier ones. Attributes packed together
+# must not overlap, and a subclass, whose attributes may go in holes left
+# by its parent, must keep the parent's attributes where they were, so
+# reblessing an object keeps their values.
+
+plan(6);
+
+my $int8   := native_int_type(8, 0);
+my $uint8  := native_int_type(8, 1);
+my $int16  := native_int_type(16, 0);
+my $int32  := native_int_type(32, 0);
+my $int64  := native_int_type(64, 0);
+my $num32  := nqp::newtype(nqp::knowhow(), 'P6num');
+nqp::composetype($num32, nqp::hash('float', nqp::hash('bits', 32)));
+my $str    := repr_type('P6str');
+
+sub attr(str $name, $type) {
+    nqp::isnull($type) ?? nqp::hash('name', $name) !! nqp::hash('name', $name, 'type', $type)
+}
+
+my $Parent := nqp::newtype(nqp::knowhow(), 'P6opaque');
+my @parent_attrs := [
+    attr('$!a', $int8), attr('$!o', nqp::null()), attr('$!b', $uint8), attr('$!c', $int16),
+    attr('$!d', $int32), attr('$!e', $int8), attr('$!f', $int64), attr('$!s', $str),
+    attr('$!g', $num32), attr('$!h', $int8),
+];
+nqp::composetype($Parent, nqp::hash('attribute', [[$Parent, @parent_attrs, []]]));
+
+my $Child := nqp::newtype(nqp::knowhow(), 'P6opaque');
+my @child_attrs := [attr('$!x', $int8), attr('$!y', $int16), attr('$!z', $int8), attr('$!p', nqp::null())];
+nqp::composetype($Child, nqp::hash('attribute', [
+    [$Child, @child_attrs, [$Parent]],
+    [$Parent, @parent_attrs, []],
+]));
+
+# Sets all the parent's attributes, to values using all their bits.
+sub fill_parent($obj) {
+    nqp::bindattr_i($obj, $Parent, '$!a', -128);
+    nqp::bindattr($obj, $Parent, '$!o', $Parent);
+    nqp::bindattr_i($obj, $Parent, '$!b', 255);
+    nqp::bindattr_i($obj, $Parent, '$!c', -32768);
+    nqp::bindattr_i($obj, $Parent, '$!d', -2147483648);
+    nqp::bindattr_i($obj, $Parent, '$!e', 127);
+    nqp::bindattr_i($obj, $Parent, '$!f', -9223372036854775807);
+    nqp::bindattr_s($obj, $Parent, '$!s', 'string');
+    nqp::bindattr_n($obj, $Parent, '$!g', 1.5e0);
+    nqp::bindattr_i($obj, $Parent, '$!h', -1);
+}
+sub parent_intact($obj) {
+    nqp::getattr_i($obj, $Parent, '$!a') == -128
+        && nqp::eqaddr(nqp::getattr($obj, $Parent, '$!o'), $Parent)
+        && nqp::getattr_i($obj, $Parent, '$!b') == 255
+        && nqp::getattr_i($obj, $Parent, '$!c') == -32768
+        && nqp::getattr_i($obj, $Parent, '$!d') == -2147483648
+        && nqp::getattr_i($obj, $Parent, '$!e') == 127
+        && nqp::getattr_i($obj, $Parent, '$!f') == -9223372036854775807
+        && nqp::getattr_s($obj, $Parent, '$!s') eq 'string'
+        && nqp::getattr_n($obj, $Parent, '$!g') == 1.5e0
+        && nqp::getattr_i($obj, $Parent, '$!h') == -1
+}
+
+my $obj := nqp::create($Parent);
+fill_parent($obj);
+ok(parent_intact($obj), 'packed attributes hold their values without overlapping');
+
+# Writing each attribute in turn leaves the others alone.
+nqp::bindattr_i($obj, $Parent, '$!a', 0);
+nqp::bindattr_i($obj, $Parent, '$!e', 0);
+nqp::bindattr_i($obj, $Parent, '$!h', 0);
+ok(nqp::getattr_i($obj, $Parent, '$!b') == 255 && nqp::getattr_i($obj, $Parent, '$!c') == -32768
+    && nqp::getattr_i($obj, $Parent, '$!d') == -2147483648,
+    'writing small attributes leaves those next to them alone');
+
+my $child := nqp::create($Child);
+fill_parent($child);
+nqp::bindattr_i($child, $Child, '$!x', -2);
+nqp::bindattr_i($child, $Child, '$!y', 1000);
+nqp::bindattr_i($child, $Child, '$!z', 99);
+nqp::bindattr($child, $Child, '$!p', $Child);
+ok(parent_intact($child), "a subclass's attributes don't overlap its parent's");
+ok(nqp::getattr_i($child, $Child, '$!x') == -2 && nqp::getattr_i($child, $Child, '$!y') == 1000
+    && nqp::getattr_i($child, $Child, '$!z') == 99 && nqp::eqaddr(nqp::getattr($child, $Child, '$!p'), $Child),
+    'and hold their own values');
+
+# Reblessing copies the parent's body into the subclass layout.
+my $reblessed := nqp::create($Parent);
+fill_parent($reblessed);
+nqp::rebless($reblessed, $Child);
+ok(parent_intact($reblessed), "reblessing into a subclass keeps the parent's attributes");
+nqp::bindattr_i($reblessed, $Child, '$!z', 5);
+nqp::force_gc();
+ok(parent_intact($reblessed) && nqp::getattr_i($reblessed, $Child, '$!z') == 5,
+    'including after setting the new ones and a GC run');
@@ -0,0 +1,43 @@
+# Tests for the cache of boxed small integers. Boxing an integer in its
+# range gives the same box each time, including once spesh has turned the
+# boxing into a read from the cache; integers outside it get a new box.
+
+plan(8);
+
+my $BOOTInt := nqp::bootint();
+
+ok(nqp::eqaddr(nqp::box_i(-128, $BOOTInt), nqp::box_i(-128, $BOOTInt)), 'the lowest cached integer');
+ok(nqp::eqaddr(nqp::box_i(1023, $BOOTInt), nqp::box_i(1023, $BOOTInt)), 'the highest cached integer');
+ok(!nqp::eqaddr(nqp::box_i(-129, $BOOTInt), nqp::box_i(-129, $BOOTInt)), 'below the range is not cached');
+ok(!nqp::eqaddr(nqp::box_i(1024, $BOOTInt), nqp::box_i(1024, $BOOTInt)), 'above the range is not cached');
+
+my int $wrong := 0;
+my int $i := -200;
+while $i < 1100 {
+    $wrong++ unless nqp::unbox_i(nqp::box_i($i, $BOOTInt)) == $i;
+    $i++;
+}
+ok($wrong == 0, 'every box holds its own value');
+
+# Boxing constants and variables in a hot loop, so spesh gets to it.
+sub box_constant() { nqp::box_i(1000, $BOOTInt) }
+sub box_variable(int $v) { nqp::box_i($v, $BOOTInt) }
+my $first := box_constant();
+my int $same := 0;
+my int $values := 0;
+$i := 0;
+while $i < 200000 {
+    $same++ if nqp::eqaddr(box_constant(), $first);
+    my int $v := $i % 1200 - 100;
+    $values++ if nqp::unbox_i(box_variable($v)) == $v;
+    $i++;
+}
+ok($same == 200000, 'boxing a constant in range gives the cached box once specialized');
+ok($values == 200000, 'boxing variables in and out of range gives the right values once specialized');
+
+# The boxes survive GC runs, being marked with the instance's roots.
+my $before := nqp::box_i(500, $BOOTInt);
+nqp::force_gc();
+nqp::force_gc();
+ok(nqp::eqaddr(nqp::box_i(500, $BOOTInt), $before) && nqp::unbox_i($before) == 500,
+    'cached boxes survive GC');